@@ -111,6 +111,22 @@ namespace embree
     /// Loads and Stores
     ////////////////////////////////////////////////////////////////////////////////
 
+    static __forceinline vfloat16 load(const char* ptr) {
+      return _mm512_cvtepi32_ps(_mm512_cvtepi8_epi32(_mm_loadu_si128((__m128i*)ptr)));
+    }
+
+    static __forceinline vfloat16 load(const unsigned char* ptr) {
+      return _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(_mm_loadu_si128((__m128i*)ptr)));
+    }
+
+    static __forceinline vfloat16 load(const short* ptr) {
+      return _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(_mm256_loadu_si256((__m256i*)ptr)));
+    }
+
+    static __forceinline vfloat16 load(const unsigned short* ptr) {
+      return _mm512_cvtepi32_ps(_mm512_cvtepu16_epi32(_mm256_loadu_si256((__m256i*)ptr)));
+    }
+
     static __forceinline vfloat16 load (const void* ptr) { return _mm512_load_ps((float*)ptr);  }
     static __forceinline vfloat16 loadu(const void* ptr) { return _mm512_loadu_ps((float*)ptr); }
 
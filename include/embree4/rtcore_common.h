@@ -307,6 +307,7 @@ enum RTCRayQueryFlags
   /* embree specific flags */
   RTC_RAY_QUERY_FLAG_INCOHERENT = (0 << 16), // optimize for incoherent rays
   RTC_RAY_QUERY_FLAG_COHERENT   = (1 << 16), // optimize for coherent rays
+  RTC_RAY_QUERY_FLAG_OCCLUDER_CACHE = (1 << 17), // test recently found occluders first in rtcOccluded1
 };
 
 /* Arguments for RTCFilterFunctionN */
@@ -126,6 +126,27 @@ struct RTCDisplacementFunctionNArguments
 /* Displacement mapping callback function */
 typedef void (*RTCDisplacementFunctionN)(const struct RTCDisplacementFunctionNArguments* args);
 
+/* Opacity states of the micro triangles of an opacity micromap */
+enum RTCOpacityMicromapState
+{
+  RTC_OPACITY_MICROMAP_STATE_TRANSPARENT = 0, // hits are ignored
+  RTC_OPACITY_MICROMAP_STATE_OPAQUE      = 1, // hits are accepted without invoking filter functions
+  RTC_OPACITY_MICROMAP_STATE_UNKNOWN     = 2  // hits are passed to filter functions
+};
+
+/* Arguments for RTCOpacityFunction */
+struct RTCOpacityFunctionArguments
+{
+  void* geometryUserPtr;
+  unsigned int primID;
+  unsigned int microTriangleID;
+  float u[3];
+  float v[3];
+};
+
+/* Opacity micromap callback function */
+typedef enum RTCOpacityMicromapState (*RTCOpacityFunction)(const struct RTCOpacityFunctionArguments* args);
+
 /* Creates a new geometry of specified type. */
 RTC_API RTCGeometry rtcNewGeometry(RTCDevice device, enum RTCGeometryType type);
 
@@ -190,6 +211,9 @@ RTC_API void rtcSetGeometryOccludedFilterFunction(RTCGeometry geometry, RTCFilte
 /* Enables argument version of intersection or occlusion filter function. */
 RTC_API void rtcSetGeometryEnableFilterFunctionFromArguments(RTCGeometry geometry, bool enable);
 
+/* Enables or disables backface culling for the triangles or quads of the geometry. */
+RTC_API void rtcSetGeometryEnableBackfaceCulling(RTCGeometry geometry, bool enable);
+
 /* Sets the user-defined data pointer of the geometry. */
 RTC_API void rtcSetGeometryUserData(RTCGeometry geometry, void* ptr);
 
@@ -223,6 +247,9 @@ RTC_API void rtcSetGeometryInstancedScene(RTCGeometry geometry, RTCScene scene);
 /* Sets the instanced scenes of an instance array geometry. */
 RTC_API void rtcSetGeometryInstancedScenes(RTCGeometry geometry, RTCScene* scenes, size_t numScenes);
 
+/* Sets the level of detail distances of an instance array geometry. */
+RTC_API void rtcSetGeometryInstanceLOD(RTCGeometry geometry, const float* distances, unsigned int numDistances, float transitionWidth);
+
 /* Sets the transformation of an instance for the specified time step. */
 RTC_API void rtcSetGeometryTransform(RTCGeometry geometry, unsigned int timeStep, enum RTCFormat format, const void* xfm);
 
@@ -242,6 +269,12 @@ RTC_API void rtcGetGeometryTransformEx(RTCGeometry geometry, unsigned int instPr
 /* Sets the uniform tessellation rate of the geometry. */
 RTC_API void rtcSetGeometryTessellationRate(RTCGeometry geometry, float tessellationRate);
 
+/* Sets the tolerance for tessellating round curves into round linear segments. */
+RTC_API void rtcSetGeometryTessellationTolerance(RTCGeometry geometry, float tolerance);
+
+/* Sets reference points and target edge length for view dependent tessellation of the geometry. */
+RTC_API void rtcSetGeometryViewDependentTessellation(RTCGeometry geometry, const float* points, unsigned int numPoints, float edgeLength);
+
 /* Sets the number of topologies of a subdivision surface. */
 RTC_API void rtcSetGeometryTopologyCount(RTCGeometry geometry, unsigned int topologyCount);
 
@@ -254,6 +287,12 @@ RTC_API void rtcSetGeometryVertexAttributeTopology(RTCGeometry geometry, unsigne
 /* Sets the displacement callback function of a subdivision surface. */
 RTC_API void rtcSetGeometryDisplacementFunction(RTCGeometry geometry, RTCDisplacementFunctionN displacement);
 
+/* Sets a tiled height texture to displace a subdivision surface along its normal. */
+RTC_API void rtcSetGeometryDisplacementTexture(RTCGeometry geometry, const float* texels, unsigned int width, unsigned int height, float scale);
+
+/* Sets the opacity micromap subdivision level and callback function of a triangle mesh. */
+RTC_API void rtcSetGeometryOpacityMicromap(RTCGeometry geometry, unsigned int subdivisionLevel, RTCOpacityFunction opacity);
+
 /* Returns the first half edge of a face. */
 RTC_API unsigned int rtcGetGeometryFirstHalfEdge(RTCGeometry geometry, unsigned int faceID);
 
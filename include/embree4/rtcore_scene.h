@@ -155,10 +155,112 @@ RTC_API bool rtcPointQuery8(const int* valid, RTCScene scene, struct RTCPointQue
 /* Perform a closest point query with a packet of 4 points with the scene. */
 RTC_API bool rtcPointQuery16(const int* valid, RTCScene scene, struct RTCPointQuery16* query, struct RTCPointQueryContext* context, RTCPointQueryFunction queryFunc, void** userPtr);
 
+/* Result of a built-in closest point query */
+struct RTC_ALIGN(16) RTCClosestPointResult
+{
+  float p_x;          // x coordinate of closest point (world space)
+  float p_y;          // y coordinate of closest point (world space)
+  float p_z;          // z coordinate of closest point (world space)
+  float u;            // barycentric u coordinate of closest point
+  float v;            // barycentric v coordinate of closest point
+  unsigned int primID; // primitive ID
+  unsigned int geomID; // geometry ID
+  unsigned int instID[RTC_MAX_INSTANCE_LEVEL_COUNT]; // instance ID
+#if defined(RTC_GEOMETRY_INSTANCE_ARRAY)
+  unsigned int instPrimID[RTC_MAX_INSTANCE_LEVEL_COUNT]; // instance primitive ID
+#endif
+};
+
+/* Finds the closest point on the triangle, quad, and grid geometries of the scene. */
+RTC_API bool rtcClosestPoint(RTCScene scene, struct RTCPointQuery* query, struct RTCClosestPointResult* result);
+
+/* Finds the closest points for a packet of 4 points. */
+RTC_API bool rtcClosestPoint4(const int* valid, RTCScene scene, struct RTCPointQuery4* query, struct RTCClosestPointResult* results);
+
+/* Finds the closest points for a packet of 8 points. */
+RTC_API bool rtcClosestPoint8(const int* valid, RTCScene scene, struct RTCPointQuery8* query, struct RTCClosestPointResult* results);
+
+/* Finds the closest points for a packet of 16 points. */
+RTC_API bool rtcClosestPoint16(const int* valid, RTCScene scene, struct RTCPointQuery16* query, struct RTCClosestPointResult* results);
+
+/* Axis-aligned query box of a box query */
+struct RTC_ALIGN(16) RTCBoxQuery
+{
+  float lower_x;  // x coordinate of lower corner
+  float lower_y;  // y coordinate of lower corner
+  float lower_z;  // z coordinate of lower corner
+  float time;     // time for motion blur
+  float upper_x;  // x coordinate of upper corner
+  float upper_y;  // y coordinate of upper corner
+  float upper_z;  // z coordinate of upper corner
+  float align0;
+};
+
+/* Primitive found by a box query */
+struct RTCBoxQueryPrimitive
+{
+  unsigned int geomID; // geometry ID
+  unsigned int primID; // primitive ID
+};
+
+/* Box query callback invoked with a full output buffer, returning false terminates the query */
+typedef bool (*RTCBoxQueryFunction)(void* userPtr, struct RTCBoxQueryPrimitive* primitives, unsigned int numPrimitives);
+
+/* Gathers the primitives whose bounds overlap the query box into an output buffer. */
+RTC_API unsigned int rtcBoxQuery(RTCScene scene, const struct RTCBoxQuery* query, struct RTCBoxQueryPrimitive* primitives, unsigned int capacity, RTCBoxQueryFunction func, void* userPtr);
+
+/* Frustum query flags */
+enum RTCFrustumQueryFlags
+{
+  RTC_FRUSTUM_QUERY_FLAG_NONE      = 0,
+  RTC_FRUSTUM_QUERY_FLAG_INSTANCES = (1 << 0) // reports instances instead of the primitives of the instanced scenes
+};
+
+/* Frustum given by six planes (nx,ny,nz,d), a point p is inside when nx*p.x+ny*p.y+nz*p.z+d >= 0 holds for all planes */
+struct RTC_ALIGN(16) RTCFrustumQuery
+{
+  float planes[6][4];               // frustum planes
+  float time;                       // time for motion blur
+  enum RTCFrustumQueryFlags flags;  // frustum query flags
+};
+
+/* Primitive found by a frustum query */
+struct RTCFrustumQueryPrimitive
+{
+  unsigned int geomID;                              // geometry ID
+  unsigned int primID;                              // primitive ID
+  unsigned int instID[RTC_MAX_INSTANCE_LEVEL_COUNT]; // instance ID
+#if defined(RTC_GEOMETRY_INSTANCE_ARRAY)
+  unsigned int instPrimID[RTC_MAX_INSTANCE_LEVEL_COUNT]; // instance primitive ID
+#endif
+  unsigned int inside;                              // 1 if the primitive is completely inside the frustum
+};
+
+/* Frustum query callback invoked with batches of found primitives */
+typedef void (*RTCFrustumQueryFunction)(void* userPtr, struct RTCFrustumQueryPrimitive* primitives, unsigned int numPrimitives);
+
+/* Reports the primitives whose BVH leaf bounds are not outside the frustum. */
+RTC_API void rtcFrustumQuery(RTCScene scene, const struct RTCFrustumQuery* query, RTCFrustumQueryFunction func, void* userPtr);
+
 
 /* Intersects a single ray with the scene. */
 RTC_SYCL_API void rtcIntersect1(RTCScene scene, struct RTCRayHit* rayhit, struct RTCIntersectArguments* args RTC_OPTIONAL_ARGUMENT);
 
+/* Intersects an array of independent single rays with the scene. */
+RTC_API void rtcIntersect1M(RTCScene scene, struct RTCRayHit* rayhits, unsigned int M, struct RTCIntersectArguments* args RTC_OPTIONAL_ARGUMENT);
+
+/* List of the closest hits along a ray, sorted by hit distance */
+struct RTCHitList
+{
+  unsigned int maxHitCount; // capacity of the tfar and hits arrays
+  unsigned int hitCount;    // number of hits found
+  float* tfar;              // hit distances
+  struct RTCHit* hits;      // hit data
+};
+
+/* Finds the closest maxHitCount hits of a single ray with the scene. */
+RTC_API void rtcIntersectMultiHit1(RTCScene scene, const struct RTCRay* ray, struct RTCHitList* hits, struct RTCIntersectArguments* args RTC_OPTIONAL_ARGUMENT);
+
 /* Intersects a packet of 4 rays with the scene. */
 RTC_API void rtcIntersect4(const int* valid, RTCScene scene, struct RTCRayHit4* rayhit, struct RTCIntersectArguments* args RTC_OPTIONAL_ARGUMENT);
 
@@ -238,6 +340,23 @@ typedef void (*RTCCollideFunc) (void* userPtr, struct RTCCollision* collisions,
 
 /*! Performs collision detection of two scenes */
 RTC_API void rtcCollide (RTCScene scene0, RTCScene scene1, RTCCollideFunc callback, void* userPtr);
+
+/*! Collision flags */
+enum RTCCollideFlags
+{
+  RTC_COLLIDE_FLAG_NONE                 = 0,
+  RTC_COLLIDE_FLAG_SKIP_SHARED_VERTICES = (1 << 0) // skips primitive pairs of the same geometry that share a vertex
+};
+
+/*! Performs self collision detection of a scene, reporting each pair of primitives once */
+RTC_API void rtcCollideSelf (RTCScene scene, enum RTCCollideFlags flags, RTCCollideFunc callback, void* userPtr);
+
+/*! continuous collision callback, time0 and time1 bound the earliest interval of possible contact */
+struct RTCContinuousCollision { unsigned int geomID0; unsigned int primID0; unsigned int geomID1; unsigned int primID1; float time0; float time1; };
+typedef void (*RTCCollideContinuousFunc) (void* userPtr, struct RTCContinuousCollision* collisions, unsigned int num_collisions);
+
+/*! Performs continuous collision detection of two scenes over the time interval [time0,time1] */
+RTC_API void rtcCollideContinuous (RTCScene scene0, RTCScene scene1, float time0, float time1, RTCCollideContinuousFunc callback, void* userPtr);
  
 #if defined(__cplusplus)
 
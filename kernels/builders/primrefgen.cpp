@@ -153,6 +153,67 @@ namespace embree
       return pinfo;
     }
 
+    PrimInfo presplitCurves(Scene* scene, mvector<PrimRef>& prims, const PrimInfo& pinfo)
+    {
+      auto hasPresplits = [&] (const Geometry* geom) -> bool {
+        return (geom->getTypeMask() & Geometry::MTY_CURVE4) && ((const CurveGeometry*)geom)->hasPresplits();
+      };
+
+      /* fast path if no curve geometry gets pre-split */
+      bool presplits = false;
+      for (size_t geomID=0; geomID<scene->size(); geomID++) {
+        const Geometry* geom = scene->get(geomID);
+        presplits |= geom && geom->isEnabled() && hasPresplits(geom);
+      }
+      if (!presplits) return pinfo;
+
+      /* determine into how many sub-segments each curve segment gets split */
+      const size_t numPrimRefs = pinfo.size();
+      avector<unsigned char> levels(numPrimRefs);
+      ParallelPrefixSumState<size_t> pstate;
+      auto countSubSegments = [&](const range<size_t>& r, const size_t& base) -> size_t {
+        size_t num = 0;
+        for (size_t i=r.begin(); i<r.end(); i++) {
+          const Geometry* geom = scene->get(prims[i].geomID());
+          levels[i] = hasPresplits(geom) ? (unsigned char) geom->computePresplitLevel(prims[i].primID()) : 0;
+          num += size_t(1) << levels[i];
+        }
+        return num;
+      };
+      const size_t numSplitPrimRefs = parallel_prefix_sum(pstate, size_t(0), numPrimRefs, size_t(1024), size_t(0), countSubSegments, std::plus<size_t>());
+      if (numSplitPrimRefs == numPrimRefs) return pinfo;
+
+      /* replace each split curve segment by the primrefs of its sub-segments */
+      mvector<PrimRef> sprims(scene->device,numSplitPrimRefs);
+      parallel_prefix_sum(pstate, size_t(0), numPrimRefs, size_t(1024), size_t(0), [&](const range<size_t>& r, const size_t& base) -> size_t {
+        size_t k = base;
+        for (size_t i=r.begin(); i<r.end(); i++)
+        {
+          const unsigned int level = levels[i];
+          if (level == 0) {
+            sprims[k++] = prims[i];
+            continue;
+          }
+          const unsigned int geomID = prims[i].geomID();
+          const unsigned int primID = prims[i].primID();
+          const Geometry* geom = scene->get(geomID);
+          for (unsigned int j=0; j<(1u << level); j++) {
+            const unsigned int subPrimID = CurveGeometry::encodePresplit(primID,level,j);
+            sprims[k++] = PrimRef(geom->vbounds(subPrimID),geomID,subPrimID);
+          }
+        }
+        return k-base;
+      }, std::plus<size_t>());
+      prims = std::move(sprims);
+
+      return parallel_reduce(size_t(0), numSplitPrimRefs, size_t(1024), PrimInfo(empty), [&](const range<size_t>& r) -> PrimInfo {
+        PrimInfo pinfo(empty);
+        for (size_t i=r.begin(); i<r.end(); i++)
+          pinfo.add_center2(prims[i]);
+        return pinfo;
+      }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
+    }
+
     template<typename Mesh>
     size_t createMortonCodeArray(Mesh* mesh, mvector<BVHBuilderMorton::BuildPrim>& morton, BuildProgressMonitor& progressMonitor)
     {
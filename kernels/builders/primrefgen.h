@@ -24,6 +24,9 @@ namespace embree
 
     PrimInfoMB createPrimRefArrayMSMBlur(Scene* scene, Geometry::GTypeMask types, size_t numPrimitives, mvector<PrimRefMB>& prims, mvector<SubGridBuildData>& sgrids, BuildProgressMonitor& progressMonitor, BBox1f t0t1 = BBox1f(0.0f,1.0f));
 
+    /*! splits the curve segments of geometries with pre-splits enabled into sub-segments with tighter bounds */
+    PrimInfo presplitCurves(Scene* scene, mvector<PrimRef>& prims, const PrimInfo& pinfo);
+
     template<typename Mesh>
       size_t createMortonCodeArray(Mesh* mesh, mvector<BVHBuilderMorton::BuildPrim>& morton, BuildProgressMonitor& progressMonitor);
 
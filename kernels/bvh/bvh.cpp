@@ -6,11 +6,14 @@
 
 namespace embree
 {
+  /* build IDs are unique across all BVHs, such that references into a BVH can get validated */
+  static std::atomic<size_t> nextBuildID(1);
+
   template<int N>
   BVHN<N>::BVHN (const PrimitiveType& primTy, Scene* scene)
     : AccelData((N==4) ? AccelData::TY_BVH4 : (N==8) ? AccelData::TY_BVH8 : AccelData::TY_UNKNOWN),
       primTy(&primTy), device(scene->device), scene(scene),
-      root(emptyNode), alloc(scene->device,scene->isStaticAccel()), numPrimitives(0), numVertices(0)
+      root(emptyNode), buildID(nextBuildID++), alloc(scene->device,scene->isStaticAccel()), numPrimitives(0), numVertices(0)
   {
   }
 
@@ -32,6 +35,7 @@ namespace embree
   void BVHN<N>::set (NodeRef root, const LBBox3fa& bounds, size_t numPrimitives)
   {
     this->root = root;
+    this->buildID = nextBuildID++;
     this->bounds = bounds;
     this->numPrimitives = numPrimitives;
   }	
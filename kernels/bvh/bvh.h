@@ -217,6 +217,7 @@ namespace embree
     Device* device;                    //!< device pointer
     Scene* scene;                      //!< scene pointer
     NodeRef root;                      //!< root node
+    size_t buildID;                    //!< unique ID of the current build, changes whenever the nodes get reallocated
     FastAllocator alloc;               //!< allocator used to allocate nodes
     
     /*! statistics data */
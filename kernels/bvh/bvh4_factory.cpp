@@ -24,6 +24,9 @@
 namespace embree
 {
   DECLARE_SYMBOL2(Accel::Collider,BVH4ColliderUserGeom);
+  DECLARE_SYMBOL2(Accel::Collider,BVH4ColliderMesh);
+  DECLARE_SYMBOL2(Accel::Collider,BVH4ColliderContinuous);
+  DECLARE_SYMBOL2(Accel::FrustumQueryFunc,BVH4FrustumQuery);
 
   DECLARE_ISA_FUNCTION(VirtualCurveIntersector*,VirtualCurveIntersector4i,void);
   DECLARE_ISA_FUNCTION(VirtualCurveIntersector*,VirtualCurveIntersector8i,void);
@@ -38,6 +41,7 @@ namespace embree
   DECLARE_SYMBOL2(Accel::Intersector1,BVH4OBBVirtualCurveIntersectorRobust1MB);
 
   DECLARE_SYMBOL2(Accel::Intersector1,BVH4Triangle4Intersector1Moeller);
+  DECLARE_SYMBOL2(Accel::Intersector1,BVH4Triangle4Intersector1MoellerNoFilter);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH4Triangle4iIntersector1Moeller);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH4Triangle4vIntersector1Pluecker);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH4Triangle4iIntersector1Pluecker);
@@ -48,6 +52,7 @@ namespace embree
   DECLARE_SYMBOL2(Accel::Intersector1,BVH4Triangle4iMBIntersector1Pluecker);
 
   DECLARE_SYMBOL2(Accel::Intersector1,BVH4Quad4vIntersector1Moeller);
+  DECLARE_SYMBOL2(Accel::Intersector1,BVH4Quad4vIntersector1MoellerNoFilter);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH4Quad4iIntersector1Moeller);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH4Quad4vIntersector1Pluecker);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH4Quad4iIntersector1Pluecker);
@@ -253,6 +258,9 @@ namespace embree
   BVH4Factory::BVH4Factory(int bfeatures, int ifeatures)
   {
     SELECT_SYMBOL_DEFAULT_AVX_AVX2(ifeatures,BVH4ColliderUserGeom);
+    SELECT_SYMBOL_DEFAULT_AVX_AVX2(ifeatures,BVH4ColliderMesh);
+    SELECT_SYMBOL_DEFAULT_AVX_AVX2(ifeatures,BVH4ColliderContinuous);
+    SELECT_SYMBOL_DEFAULT_AVX_AVX2(ifeatures,BVH4FrustumQuery);
 
     selectBuilders(bfeatures);
     selectIntersectors(ifeatures);
@@ -324,6 +332,7 @@ namespace embree
     IF_ENABLED_CURVES_OR_POINTS(SELECT_SYMBOL_DEFAULT_AVX_AVX2_AVX512(features,BVH4OBBVirtualCurveIntersectorRobust1MB));
     
     IF_ENABLED_TRIS(SELECT_SYMBOL_DEFAULT_AVX_AVX2_AVX512(features,BVH4Triangle4Intersector1Moeller));
+    IF_ENABLED_TRIS(SELECT_SYMBOL_DEFAULT_AVX_AVX2_AVX512(features,BVH4Triangle4Intersector1MoellerNoFilter));
     IF_ENABLED_TRIS(SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX512(features,BVH4Triangle4iIntersector1Moeller));
     IF_ENABLED_TRIS(SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX512(features,BVH4Triangle4vIntersector1Pluecker));
     IF_ENABLED_TRIS(SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX512(features,BVH4Triangle4iIntersector1Pluecker));
@@ -334,6 +343,7 @@ namespace embree
     IF_ENABLED_TRIS(SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX2_AVX512(features,BVH4Triangle4iMBIntersector1Pluecker));
 
     IF_ENABLED_QUADS(SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX2_AVX512(features,BVH4Quad4vIntersector1Moeller));
+    IF_ENABLED_QUADS(SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX2_AVX512(features,BVH4Quad4vIntersector1MoellerNoFilter));
     IF_ENABLED_QUADS(SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX2_AVX512(features,BVH4Quad4iIntersector1Moeller));
     IF_ENABLED_QUADS(SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX2_AVX512(features,BVH4Quad4vIntersector1Pluecker));
     IF_ENABLED_QUADS(SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX2_AVX512(features,BVH4Quad4iIntersector1Pluecker));
@@ -567,6 +577,8 @@ namespace embree
     Accel::Intersectors intersectors;
     intersectors.ptr = bvh;
     intersectors.intersector1           = BVH4Triangle4Intersector1Moeller();
+    intersectors.intersector1_filter    = BVH4Triangle4Intersector1Moeller();
+    intersectors.intersector1_nofilter  = BVH4Triangle4Intersector1MoellerNoFilter();
 #if defined (EMBREE_RAY_PACKETS)
     intersectors.intersector4_filter    = BVH4Triangle4Intersector4HybridMoeller();
     intersectors.intersector4_nofilter  = BVH4Triangle4Intersector4HybridMoellerNoFilter();
@@ -575,6 +587,7 @@ namespace embree
     intersectors.intersector16_filter   = BVH4Triangle4Intersector16HybridMoeller();
     intersectors.intersector16_nofilter = BVH4Triangle4Intersector16HybridMoellerNoFilter();
 #endif
+    intersectors.collider = BVH4ColliderMesh();
     return intersectors;
   }
 
@@ -589,6 +602,7 @@ namespace embree
     intersectors.intersector8  = BVH4Triangle4vIntersector8HybridPluecker();
     intersectors.intersector16 = BVH4Triangle4vIntersector16HybridPluecker();
 #endif
+    intersectors.collider = BVH4ColliderMesh();
     return intersectors;
   }
 
@@ -605,6 +619,7 @@ namespace embree
       intersectors.intersector8  = BVH4Triangle4iIntersector8HybridMoeller();
       intersectors.intersector16 = BVH4Triangle4iIntersector16HybridMoeller();
 #endif
+      intersectors.collider = BVH4ColliderMesh();
       return intersectors;
     }
     case IntersectVariant::ROBUST:
@@ -617,6 +632,7 @@ namespace embree
       intersectors.intersector8  = BVH4Triangle4iIntersector8HybridPluecker();
       intersectors.intersector16 = BVH4Triangle4iIntersector16HybridPluecker();
 #endif
+      intersectors.collider = BVH4ColliderMesh();
       return intersectors;
     }
     }
@@ -636,6 +652,7 @@ namespace embree
       intersectors.intersector8  = BVH4Triangle4vMBIntersector8HybridMoeller();
       intersectors.intersector16 = BVH4Triangle4vMBIntersector16HybridMoeller();
 #endif
+      intersectors.collider = BVH4ColliderContinuous();
       return intersectors;
     }
     case IntersectVariant::ROBUST:
@@ -648,6 +665,7 @@ namespace embree
       intersectors.intersector8  = BVH4Triangle4vMBIntersector8HybridPluecker();
       intersectors.intersector16 = BVH4Triangle4vMBIntersector16HybridPluecker();
 #endif
+      intersectors.collider = BVH4ColliderContinuous();
       return intersectors;
     }
     }
@@ -667,6 +685,7 @@ namespace embree
       intersectors.intersector8  = BVH4Triangle4iMBIntersector8HybridMoeller();
       intersectors.intersector16 = BVH4Triangle4iMBIntersector16HybridMoeller();
 #endif
+      intersectors.collider = BVH4ColliderContinuous();
       return intersectors;
     }
     case IntersectVariant::ROBUST:
@@ -679,6 +698,7 @@ namespace embree
       intersectors.intersector8  = BVH4Triangle4iMBIntersector8HybridPluecker();
       intersectors.intersector16 = BVH4Triangle4iMBIntersector16HybridPluecker();
 #endif
+      intersectors.collider = BVH4ColliderContinuous();
       return intersectors;
     }
     }
@@ -693,6 +713,8 @@ namespace embree
       Accel::Intersectors intersectors;
       intersectors.ptr = bvh;
       intersectors.intersector1           = BVH4Quad4vIntersector1Moeller();
+      intersectors.intersector1_filter    = BVH4Quad4vIntersector1Moeller();
+      intersectors.intersector1_nofilter  = BVH4Quad4vIntersector1MoellerNoFilter();
 #if defined (EMBREE_RAY_PACKETS)
       intersectors.intersector4_filter    = BVH4Quad4vIntersector4HybridMoeller();
       intersectors.intersector4_nofilter  = BVH4Quad4vIntersector4HybridMoellerNoFilter();
@@ -701,6 +723,7 @@ namespace embree
       intersectors.intersector16_filter   = BVH4Quad4vIntersector16HybridMoeller();
       intersectors.intersector16_nofilter = BVH4Quad4vIntersector16HybridMoellerNoFilter();
 #endif
+      intersectors.collider = BVH4ColliderMesh();
       return intersectors;
     }
     case IntersectVariant::ROBUST:
@@ -713,6 +736,7 @@ namespace embree
       intersectors.intersector8  = BVH4Quad4vIntersector8HybridPluecker();
       intersectors.intersector16 = BVH4Quad4vIntersector16HybridPluecker();
 #endif
+      intersectors.collider = BVH4ColliderMesh();
       return intersectors;
     }
     }
@@ -732,6 +756,7 @@ namespace embree
       intersectors.intersector8 = BVH4Quad4iIntersector8HybridMoeller();
       intersectors.intersector16= BVH4Quad4iIntersector16HybridMoeller();
 #endif
+      intersectors.collider = BVH4ColliderMesh();
       return intersectors;
     }
     case IntersectVariant::ROBUST:
@@ -744,6 +769,7 @@ namespace embree
       intersectors.intersector8 = BVH4Quad4iIntersector8HybridPluecker();
       intersectors.intersector16= BVH4Quad4iIntersector16HybridPluecker();
 #endif
+      intersectors.collider = BVH4ColliderMesh();
       return intersectors;
     }
     }
@@ -763,6 +789,7 @@ namespace embree
       intersectors.intersector8 = BVH4Quad4iMBIntersector8HybridMoeller();
       intersectors.intersector16= BVH4Quad4iMBIntersector16HybridMoeller();
 #endif
+      intersectors.collider = BVH4ColliderContinuous();
       return intersectors;
     }
     case IntersectVariant::ROBUST:
@@ -775,6 +802,7 @@ namespace embree
       intersectors.intersector8 = BVH4Quad4iMBIntersector8HybridPluecker();
       intersectors.intersector16= BVH4Quad4iMBIntersector16HybridPluecker();
 #endif
+      intersectors.collider = BVH4ColliderContinuous();
       return intersectors;
     }
     }
@@ -821,6 +849,7 @@ namespace embree
     intersectors.intersector8  = BVH4VirtualMBIntersector8Chunk();
     intersectors.intersector16 = BVH4VirtualMBIntersector16Chunk();
 #endif
+    intersectors.collider = BVH4ColliderContinuous();
     return intersectors;
   }
 
@@ -28,9 +28,13 @@
 namespace embree
 {
   DECLARE_SYMBOL2(Accel::Collider,BVH8ColliderUserGeom);
+  DECLARE_SYMBOL2(Accel::Collider,BVH8ColliderMesh);
+  DECLARE_SYMBOL2(Accel::Collider,BVH8ColliderContinuous);
+  DECLARE_SYMBOL2(Accel::FrustumQueryFunc,BVH8FrustumQuery);
   
   DECLARE_ISA_FUNCTION(VirtualCurveIntersector*,VirtualCurveIntersector8v,void);
   DECLARE_ISA_FUNCTION(VirtualCurveIntersector*,VirtualCurveIntersector8iMB,void);
+  DECLARE_ISA_FUNCTION(VirtualCurveIntersector*,VirtualCurveIntersector16i,void);
   
   DECLARE_SYMBOL2(Accel::Intersector1,BVH8OBBVirtualCurveIntersector1);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH8OBBVirtualCurveIntersector1MB);
@@ -38,6 +42,7 @@ namespace embree
   DECLARE_SYMBOL2(Accel::Intersector1,BVH8OBBVirtualCurveIntersectorRobust1MB);
 
   DECLARE_SYMBOL2(Accel::Intersector1,BVH8Triangle4Intersector1Moeller);
+  DECLARE_SYMBOL2(Accel::Intersector1,BVH8Triangle4Intersector1MoellerNoFilter);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH8Triangle4iIntersector1Moeller);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH8Triangle4vIntersector1Pluecker);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH8Triangle4iIntersector1Pluecker);
@@ -50,6 +55,7 @@ namespace embree
   DECLARE_SYMBOL2(Accel::Intersector1,BVH8Triangle4iMBIntersector1Pluecker);
 
   DECLARE_SYMBOL2(Accel::Intersector1,BVH8Quad4vIntersector1Moeller);
+  DECLARE_SYMBOL2(Accel::Intersector1,BVH8Quad4vIntersector1MoellerNoFilter);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH8Quad4iIntersector1Moeller);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH8Quad4vIntersector1Pluecker);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH8Quad4iIntersector1Pluecker);
@@ -187,6 +193,7 @@ namespace embree
 
   DECLARE_ISA_FUNCTION(Builder*,BVH8Curve8vBuilder_OBB_New,void* COMMA Scene* COMMA size_t);
   DECLARE_ISA_FUNCTION(Builder*,BVH8OBBCurve8iMBBuilder_OBB,void* COMMA Scene* COMMA size_t);
+  DECLARE_ISA_FUNCTION(Builder*,BVH8Curve16iBuilder_OBB_New,void* COMMA Scene* COMMA size_t);
 
   DECLARE_ISA_FUNCTION(Builder*,BVH8Triangle4SceneBuilderSAH,void* COMMA Scene* COMMA size_t);
   DECLARE_ISA_FUNCTION(Builder*,BVH8Triangle4vSceneBuilderSAH,void* COMMA Scene* COMMA size_t);
@@ -227,6 +234,9 @@ namespace embree
   BVH8Factory::BVH8Factory(int bfeatures, int ifeatures)
   {
     SELECT_SYMBOL_INIT_AVX(ifeatures,BVH8ColliderUserGeom);
+    SELECT_SYMBOL_INIT_AVX(ifeatures,BVH8ColliderMesh);
+    SELECT_SYMBOL_INIT_AVX(ifeatures,BVH8ColliderContinuous);
+    SELECT_SYMBOL_INIT_AVX(ifeatures,BVH8FrustumQuery);
     
     selectBuilders(bfeatures);
     selectIntersectors(ifeatures);
@@ -236,6 +246,7 @@ namespace embree
   {
     IF_ENABLED_CURVES_OR_POINTS(SELECT_SYMBOL_INIT_AVX(features,BVH8Curve8vBuilder_OBB_New));
     IF_ENABLED_CURVES_OR_POINTS(SELECT_SYMBOL_INIT_AVX(features,BVH8OBBCurve8iMBBuilder_OBB));
+    IF_ENABLED_CURVES_OR_POINTS(SELECT_SYMBOL_INIT_AVX512(features,BVH8Curve16iBuilder_OBB_New));
 
     IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX(features,BVH8Triangle4SceneBuilderSAH));
     IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX(features,BVH8Triangle4vSceneBuilderSAH));
@@ -279,6 +290,7 @@ namespace embree
   {
     IF_ENABLED_CURVES_OR_POINTS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512(features,VirtualCurveIntersector8v));
     IF_ENABLED_CURVES_OR_POINTS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512(features,VirtualCurveIntersector8iMB));
+    IF_ENABLED_CURVES_OR_POINTS(SELECT_SYMBOL_INIT_AVX512(features,VirtualCurveIntersector16i));
     
     /* select intersectors1 */
     IF_ENABLED_CURVES_OR_POINTS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512(features,BVH8OBBVirtualCurveIntersector1));
@@ -287,6 +299,7 @@ namespace embree
     IF_ENABLED_CURVES_OR_POINTS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512(features,BVH8OBBVirtualCurveIntersectorRobust1MB));
 
     IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512(features,BVH8Triangle4Intersector1Moeller));
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512(features,BVH8Triangle4Intersector1MoellerNoFilter));
     IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512(features,BVH8Triangle4iIntersector1Moeller));
     IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512(features,BVH8Triangle4vIntersector1Pluecker));
     IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512(features,BVH8Triangle4iIntersector1Pluecker));
@@ -299,6 +312,7 @@ namespace embree
     IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512(features,BVH8Triangle4iMBIntersector1Pluecker));
 
     IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512(features,BVH8Quad4vIntersector1Moeller));
+    IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512(features,BVH8Quad4vIntersector1MoellerNoFilter));
     IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512(features,BVH8Quad4iIntersector1Moeller));
     IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512(features,BVH8Quad4vIntersector1Pluecker));
     IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512(features,BVH8Quad4iIntersector1Pluecker));
@@ -516,6 +530,8 @@ namespace embree
     Accel::Intersectors intersectors;
     intersectors.ptr = bvh;
     intersectors.intersector1           = BVH8Triangle4Intersector1Moeller();
+    intersectors.intersector1_filter    = BVH8Triangle4Intersector1Moeller();
+    intersectors.intersector1_nofilter  = BVH8Triangle4Intersector1MoellerNoFilter();
 #if defined (EMBREE_RAY_PACKETS)
     intersectors.intersector4_filter    = BVH8Triangle4Intersector4HybridMoeller();
     intersectors.intersector4_nofilter  = BVH8Triangle4Intersector4HybridMoellerNoFilter();
@@ -524,6 +540,7 @@ namespace embree
     intersectors.intersector16_filter   = BVH8Triangle4Intersector16HybridMoeller();
     intersectors.intersector16_nofilter = BVH8Triangle4Intersector16HybridMoellerNoFilter();
 #endif
+    intersectors.collider = BVH8ColliderMesh();
     return intersectors;
   }
 
@@ -544,6 +561,7 @@ namespace embree
     intersectors.intersector8    = BVH8Triangle4vIntersector8HybridPluecker();
     intersectors.intersector16   = BVH8Triangle4vIntersector16HybridPluecker();
 #endif
+    intersectors.collider = BVH8ColliderMesh();
     return intersectors;
   }
 
@@ -560,6 +578,7 @@ namespace embree
       intersectors.intersector8  = BVH8Triangle4iIntersector8HybridMoeller();
       intersectors.intersector16 = BVH8Triangle4iIntersector16HybridMoeller();
 #endif
+      intersectors.collider = BVH8ColliderMesh();
       return intersectors;
     }
     case IntersectVariant::ROBUST:
@@ -572,6 +591,7 @@ namespace embree
       intersectors.intersector8  = BVH8Triangle4iIntersector8HybridPluecker();
       intersectors.intersector16 = BVH8Triangle4iIntersector16HybridPluecker();
 #endif
+      intersectors.collider = BVH8ColliderMesh();
       return intersectors;
     }
     }
@@ -591,6 +611,7 @@ namespace embree
       intersectors.intersector8  = BVH8Triangle4vMBIntersector8HybridMoeller();
       intersectors.intersector16 = BVH8Triangle4vMBIntersector16HybridMoeller();
 #endif
+      intersectors.collider = BVH8ColliderContinuous();
       return intersectors;
     }
     case IntersectVariant::ROBUST:
@@ -603,6 +624,7 @@ namespace embree
       intersectors.intersector8  = BVH8Triangle4vMBIntersector8HybridPluecker();
       intersectors.intersector16 = BVH8Triangle4vMBIntersector16HybridPluecker();
 #endif
+      intersectors.collider = BVH8ColliderContinuous();
       return intersectors;
     }
     }
@@ -622,6 +644,7 @@ namespace embree
       intersectors.intersector8  = BVH8Triangle4iMBIntersector8HybridMoeller();
       intersectors.intersector16 = BVH8Triangle4iMBIntersector16HybridMoeller();
 #endif
+      intersectors.collider = BVH8ColliderContinuous();
       return intersectors;
     }
     case IntersectVariant::ROBUST:
@@ -634,6 +657,7 @@ namespace embree
       intersectors.intersector8  = BVH8Triangle4iMBIntersector8HybridPluecker();
       intersectors.intersector16 = BVH8Triangle4iMBIntersector16HybridPluecker();
 #endif
+      intersectors.collider = BVH8ColliderContinuous();
       return intersectors;
     }
     }
@@ -648,6 +672,8 @@ namespace embree
       Accel::Intersectors intersectors;
       intersectors.ptr = bvh;
       intersectors.intersector1           = BVH8Quad4vIntersector1Moeller();
+      intersectors.intersector1_filter    = BVH8Quad4vIntersector1Moeller();
+      intersectors.intersector1_nofilter  = BVH8Quad4vIntersector1MoellerNoFilter();
 #if defined (EMBREE_RAY_PACKETS)
       intersectors.intersector4_filter    = BVH8Quad4vIntersector4HybridMoeller();
       intersectors.intersector4_nofilter  = BVH8Quad4vIntersector4HybridMoellerNoFilter();
@@ -656,6 +682,7 @@ namespace embree
       intersectors.intersector16_filter   = BVH8Quad4vIntersector16HybridMoeller();
       intersectors.intersector16_nofilter = BVH8Quad4vIntersector16HybridMoellerNoFilter();
 #endif
+      intersectors.collider = BVH8ColliderMesh();
       return intersectors;
     }
     case IntersectVariant::ROBUST:
@@ -668,6 +695,7 @@ namespace embree
       intersectors.intersector8  = BVH8Quad4vIntersector8HybridPluecker();
       intersectors.intersector16 = BVH8Quad4vIntersector16HybridPluecker();
 #endif
+      intersectors.collider = BVH8ColliderMesh();
       return intersectors;
     }
     }
@@ -687,6 +715,7 @@ namespace embree
       intersectors.intersector8  = BVH8Quad4iIntersector8HybridMoeller();
       intersectors.intersector16 = BVH8Quad4iIntersector16HybridMoeller();
 #endif
+      intersectors.collider = BVH8ColliderMesh();
       return intersectors;
     }
     case IntersectVariant::ROBUST:
@@ -699,6 +728,7 @@ namespace embree
       intersectors.intersector8  = BVH8Quad4iIntersector8HybridPluecker();
       intersectors.intersector16 = BVH8Quad4iIntersector16HybridPluecker();
 #endif
+      intersectors.collider = BVH8ColliderMesh();
       return intersectors;
     }
     }
@@ -718,6 +748,7 @@ namespace embree
       intersectors.intersector8  = BVH8Quad4iMBIntersector8HybridMoeller();
       intersectors.intersector16 = BVH8Quad4iMBIntersector16HybridMoeller();
 #endif
+      intersectors.collider = BVH8ColliderContinuous();
       return intersectors;
     }
     case IntersectVariant::ROBUST:
@@ -730,6 +761,7 @@ namespace embree
       intersectors.intersector8  = BVH8Quad4iMBIntersector8HybridPluecker();
       intersectors.intersector16 = BVH8Quad4iMBIntersector16HybridPluecker();
 #endif
+      intersectors.collider = BVH8ColliderContinuous();
       return intersectors;
     }
     }
@@ -784,6 +816,7 @@ namespace embree
     intersectors.intersector8  = BVH8VirtualMBIntersector8Chunk();
     intersectors.intersector16 = BVH8VirtualMBIntersector16Chunk();
 #endif
+    intersectors.collider = BVH8ColliderContinuous();
     return intersectors;
   }
 
@@ -855,6 +888,16 @@ namespace embree
     return new AccelInstance(accel,builder,intersectors);
   }
 
+#if defined(EMBREE_TARGET_SIMD16)
+  Accel* BVH8Factory::BVH8OBBVirtualCurve16i(Scene* scene, IntersectVariant ivariant)
+  {
+    BVH8* accel = new BVH8(Curve16i::type,scene);
+    Accel::Intersectors intersectors = BVH8OBBVirtualCurveIntersectors(accel,VirtualCurveIntersector16i(),ivariant);
+    Builder* builder = BVH8Curve16iBuilder_OBB_New(accel,scene,0);
+    return new AccelInstance(accel,builder,intersectors);
+  }
+#endif
+
   Accel* BVH8Factory::BVH8Triangle4(Scene* scene, BuildVariant bvariant, IntersectVariant ivariant)
   {
     BVH8* accel = new BVH8(Triangle4::type,scene);
@@ -47,7 +47,10 @@ namespace embree
 
         /* create primref array */
         prims.resize(numPrimitives);
-        const PrimInfo pinfo = createPrimRefArray(scene,Geometry::MTY_CURVES,false,numPrimitives,prims,scene->progressInterface);
+        PrimInfo pinfo = createPrimRefArray(scene,Geometry::MTY_CURVES,false,numPrimitives,prims,scene->progressInterface);
+
+        /* split curve segments into sub-segments for high quality curve geometries */
+        pinfo = presplitCurves(scene,prims,pinfo);
 
         /* estimate acceleration structure size */
         const size_t node_bytes = pinfo.size()*sizeof(typename BVH::OBBNode)/(4*N);
@@ -126,6 +129,10 @@ namespace embree
     Builder* BVH4Curve8iBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<4,Curve8i,Line8i,Point8i>((BVH4*)bvh,scene); }
 #endif
 
+#if defined(__AVX512F__)
+    Builder* BVH8Curve16iBuilder_OBB_New  (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<8,Curve16i,Line16i,Point16i>((BVH8*)bvh,scene); }
+#endif
+
   }
 }
 #endif
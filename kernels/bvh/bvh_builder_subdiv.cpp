@@ -27,6 +27,64 @@ namespace embree
   {
     typedef FastAllocator::CachedAllocator Allocator;
 
+    /* tessellation of a subdivision mesh that gets reused by later builds as long as the mesh does not change */
+    struct SubdivMeshTessellation
+    {
+      SubdivMeshTessellation (Scene* scene, SubdivMesh* mesh)
+        : mesh(nullptr), modified(true), numPrims(0), offset(0), pinfo(empty), alloc(scene->device,scene->isStaticAccel()), prims(scene->device,0) {}
+
+      /* all buffers the tessellation of a mesh depends on */
+      static const size_t NUM_BUFFERS = 9;
+      static void getBuffers(const SubdivMesh* mesh, const RawBufferView* buffers[NUM_BUFFERS])
+      {
+        buffers[0] = &mesh->vertices[0];
+        buffers[1] = &mesh->levels;
+        buffers[2] = &mesh->faceVertices;
+        buffers[3] = &mesh->topology[0].vertexIndices;
+        buffers[4] = &mesh->holes;
+        buffers[5] = &mesh->edge_creases;
+        buffers[6] = &mesh->edge_crease_weights;
+        buffers[7] = &mesh->vertex_creases;
+        buffers[8] = &mesh->vertex_crease_weights;
+      }
+
+      /* checks if vertices, levels, and topology of the mesh are unchanged since it got tessellated */
+      bool isValid(const SubdivMesh* mesh) const
+      {
+        if (this->mesh != mesh) return false;
+
+        /* displacements may depend on application state, thus any commit of the geometry invalidates the tessellation */
+        if (mesh->hasDisplacement() && mesh->getModCounter() != geomModCounter) return false;
+        
+        const RawBufferView* buffers[NUM_BUFFERS]; getBuffers(mesh,buffers);
+        for (size_t i=0; i<NUM_BUFFERS; i++)
+          if (buffers[i]->isModified(modCounters[i])) return false;
+        return true;
+      }
+
+      /* records the modification counters of the mesh to tessellate */
+      void reset(SubdivMesh* mesh)
+      {
+        this->mesh = mesh;
+        geomModCounter = mesh->getModCounter();
+        const RawBufferView* buffers[NUM_BUFFERS]; getBuffers(mesh,buffers);
+        for (size_t i=0; i<NUM_BUFFERS; i++)
+          modCounters[i] = buffers[i]->modCounter;
+        numPrims = 0;
+      }
+      
+    public:
+      SubdivMesh* mesh;                    //!< tessellated mesh
+      unsigned int geomModCounter;         //!< modification counter of the mesh
+      unsigned int modCounters[NUM_BUFFERS]; //!< modification counters of the buffers of the mesh
+      bool modified;                       //!< mesh gets tessellated in the current build
+      std::atomic<size_t> numPrims;        //!< number of leaves of the mesh
+      size_t offset;                       //!< offset of the leaves in the current build
+      PrimInfo pinfo;                      //!< bounds of the leaves
+      FastAllocator alloc;                 //!< allocator for the grids of the mesh
+      mvector<PrimRef> prims;              //!< leaves of the mesh
+    };
+
     template<int N>
     struct BVHNSubdivPatch1BuilderSAH : public Builder
     {
@@ -38,6 +96,7 @@ namespace embree
       BVH* bvh;
       Scene* scene;
       mvector<PrimRef> prims;
+      std::vector<std::unique_ptr<SubdivMeshTessellation>> tessellations;
             
       BVHNSubdivPatch1BuilderSAH (BVH* bvh, Scene* scene)
         : bvh(bvh), scene(scene), prims(scene->device,0) {}
@@ -80,6 +139,7 @@ namespace embree
         const size_t numPrimitives = scene->getNumPrimitives(SubdivMesh::geom_type,false);
         if (numPrimitives == 0) {
           prims.resize(numPrimitives);
+          removeTessellations();
           bvh->set(BVH::emptyNode,empty,0);
           return;
         }
@@ -92,14 +152,32 @@ namespace embree
         auto progress = [&] (size_t dn) { bvh->scene->progressMonitor(double(dn)); };
         auto virtualprogress = BuildProgressMonitorFromClosure(progress);
 
+        /* only tessellate meshes that changed since the last build, the builder of non-dynamic scenes does not survive the build */
+        const bool reuseTessellations = scene->isDynamicAccel();
+        if (!reuseTessellations) tessellations.clear();
+        removeTessellations();
+        Scene::Iterator<SubdivMesh> iter(scene);
+        tessellations.resize(iter.size());
+        for (size_t geomID=0; geomID<iter.size(); geomID++)
+        {
+          SubdivMesh* mesh = iter.at(geomID);
+          if (mesh == nullptr) continue;
+          std::unique_ptr<SubdivMeshTessellation>& tess = tessellations[geomID];
+          if (!tess) tess.reset(new SubdivMeshTessellation(scene,mesh));
+          tess->modified = !reuseTessellations || !tess->isValid(mesh);
+          if (tess->modified) tess->reset(mesh);
+        }
+
         ParallelForForPrefixSumState<PrimInfo> pstate;
         
         /* initialize allocator and parallel_for_for_prefix_sum */
-        Scene::Iterator<SubdivMesh> iter(scene);
         pstate.init(iter,size_t(1024));
 
-        PrimInfo pinfo1 = parallel_for_for_prefix_sum0( pstate, iter, PrimInfo(empty), [&](SubdivMesh* mesh, const range<size_t>& r, size_t k, size_t /*geomID*/) -> PrimInfo
+        PrimInfo pinfo1 = parallel_for_for_prefix_sum0( pstate, iter, PrimInfo(empty), [&](SubdivMesh* mesh, const range<size_t>& r, size_t k, size_t geomID) -> PrimInfo
         { 
+          SubdivMeshTessellation* tess = tessellations[geomID].get();
+          if (!tess->modified) return PrimInfo(empty);
+          
           size_t p = 0;
           size_t g = 0;
           for (size_t f=r.begin(); f!=r.end(); ++f) {          
@@ -113,23 +191,39 @@ namespace embree
               p++;
             });
           }
+          tess->numPrims += g;
           return PrimInfo(p,g,empty);
         }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo(a.begin+b.begin,a.end+b.end,empty); });
-        size_t numSubPatches = pinfo1.begin;
-        if (numSubPatches == 0) {
-          bvh->set(BVH::emptyNode,empty,0);
-          return;
+
+        /* the leaves of tessellated meshes are stored in mesh order, followed by the leaves of unchanged meshes */
+        size_t numNewPrims = 0, numPrims = pinfo1.end;
+        for (size_t geomID=0; geomID<tessellations.size(); geomID++)
+        {
+          SubdivMeshTessellation* tess = tessellations[geomID].get();
+          if (!tess || !iter.at(geomID)) continue;
+          if (tess->modified) {
+            tess->offset = numNewPrims;
+            numNewPrims += tess->numPrims;
+            if (reuseTessellations) tess->alloc.init_estimate(tess->numPrims*sizeof(PrimRef));
+          } else {
+            tess->offset = numPrims;
+            numPrims += tess->prims.size();
+          }
         }
+        assert(numNewPrims == pinfo1.end);
 
-        prims.resize(pinfo1.end);
-        if (pinfo1.end == 0) {
+        prims.resize(numPrims);
+        if (numPrims == 0) {
           bvh->set(BVH::emptyNode,empty,0);
           return;
         }
 
         PrimInfo pinfo3 = parallel_for_for_prefix_sum1( pstate, iter, PrimInfo(empty), [&](SubdivMesh* mesh, const range<size_t>& r, size_t k, size_t geomID, const PrimInfo& base) -> PrimInfo
         {
-          Allocator alloc = bvh->alloc.getCachedAllocator();
+          SubdivMeshTessellation* tess = tessellations[geomID].get();
+          if (!tess->modified) return PrimInfo(empty);
+          
+          Allocator alloc = reuseTessellations ? tess->alloc.getCachedAllocator() : bvh->alloc.getCachedAllocator();
           
           PrimInfo s(empty);
           for (size_t f=r.begin(); f!=r.end(); ++f) {
@@ -148,7 +242,35 @@ namespace embree
           return s;
         }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a, b); });
 
-        PrimInfo pinfo(0,pinfo3.end,pinfo3);
+        /* keep the leaves of tessellated meshes for later builds and reuse the leaves of unchanged meshes */
+        if (reuseTessellations) parallel_for(tessellations.size(), [&] (const size_t geomID)
+        {
+          SubdivMeshTessellation* tess = tessellations[geomID].get();
+          if (!tess || !iter.at(geomID)) return;
+          if (tess->modified) 
+          {
+            tess->alloc.cleanup();
+            tess->prims.resize(tess->numPrims);
+            tess->pinfo = PrimInfo(empty);
+            for (size_t i=0; i<tess->prims.size(); i++) {
+              tess->prims[i] = prims[tess->offset+i];
+              tess->pinfo.add_center2(tess->prims[i]);
+            }
+          }
+          else {
+            for (size_t i=0; i<tess->prims.size(); i++)
+              prims[tess->offset+i] = tess->prims[i];
+          }
+        });
+
+        for (size_t geomID=0; geomID<tessellations.size(); geomID++)
+        {
+          SubdivMeshTessellation* tess = tessellations[geomID].get();
+          if (!tess || !iter.at(geomID) || tess->modified) continue;
+          pinfo3.merge(tess->pinfo);
+        }
+
+        PrimInfo pinfo(0,numPrims,pinfo3);
         
         auto createLeaf = [&] (const PrimRef* prims, const range<size_t>& range, Allocator alloc) -> NodeRef {
           assert(range.size() == 1);
@@ -173,12 +295,31 @@ namespace embree
 	if (scene->isStaticAccel()) {
           prims.clear();
         }
+        if (!reuseTessellations) {
+          tessellations.clear();
+        }
         bvh->cleanup();
         bvh->postBuild(t0);
       }
 
+      /* removes the tessellations of meshes that are no longer part of the scene, disabled meshes keep their tessellation */
+      void removeTessellations()
+      {
+        tessellations.resize(min(tessellations.size(),scene->size()));
+        for (size_t geomID=0; geomID<tessellations.size(); geomID++)
+          if (tessellations[geomID] && tessellations[geomID]->mesh != scene->get(geomID))
+            tessellations[geomID].reset();
+      }
+
+      void deleteGeometry(size_t geomID)
+      {
+        if (geomID < tessellations.size())
+          tessellations[geomID].reset();
+      }
+
       void clear() {
         prims.clear();
+        tessellations.clear();
       }
     };
 
@@ -12,7 +12,8 @@ namespace embree
   {
 #define CSTAT(x)
 
-    size_t parallel_depth_threshold = 3;
+    /* node pairs up to this combined depth are processed as separate tasks that idle threads can steal */
+    static const size_t parallel_depth_threshold = 8;
     CSTAT(std::atomic<size_t> bvh_collide_traversal_steps(0));
     CSTAT(std::atomic<size_t> bvh_collide_leaf_pairs(0));
     CSTAT(std::atomic<size_t> bvh_collide_leaf_iterations(0));
@@ -23,19 +24,6 @@ namespace embree
     CSTAT(std::atomic<size_t> bvh_collide_prim_intersections5(0));
     CSTAT(std::atomic<size_t> bvh_collide_prim_intersections(0));
 
-    struct Collision
-    {
-      __forceinline Collision() {}
-
-      __forceinline Collision (unsigned geomID0, unsigned primID0, unsigned geomID1, unsigned primID1)
-        : geomID0(geomID0), primID0(primID0), geomID1(geomID1), primID1(primID1) {}
-
-      unsigned geomID0;
-      unsigned primID0;
-      unsigned geomID1;
-      unsigned primID1;
-    };
-    
     template<int N>
     __forceinline size_t overlap(const BBox3fa& box0, const typename BVHN<N>::AABBNode& node1)
     {
@@ -110,39 +98,393 @@ namespace embree
     }
     
     template<int N>
-    __forceinline void BVHNColliderUserGeom<N>::processLeaf(NodeRef node0, NodeRef node1)
+    __forceinline void BVHNColliderUserGeom<N>::processLeaf(NodeRef node0, NodeRef node1, Buffer& buffer)
     {
-      Collision collisions[16];
-      size_t num_collisions = 0;
-
       size_t N0; Object* leaf0 = (Object*) node0.leaf(N0);
       size_t N1; Object* leaf1 = (Object*) node1.leaf(N1);
+      const bool sameLeaf = this->self && node0 == node1;
       for (size_t i=0; i<N0; i++) {
-        for (size_t j=0; j<N1; j++) {
+        for (size_t j=sameLeaf ? i+1 : 0; j<N1; j++) {
           const unsigned geomID0 = leaf0[i].geomID();
           const unsigned primID0 = leaf0[i].primID();
           const unsigned geomID1 = leaf1[j].geomID();
           const unsigned primID1 = leaf1[j].primID();
           if (this->scene0 == this->scene1 && geomID0 == geomID1 && primID0 == primID1) continue;
-          collisions[num_collisions++] = Collision(geomID0,primID0,geomID1,primID1);
-          if (num_collisions == 16) {
-            this->callback(this->userPtr,(RTCCollision*)&collisions,num_collisions);
-            num_collisions = 0;
+          buffer.add({geomID0,primID0,geomID1,primID1});
+        }
+      }
+    }
+
+    /* geometry and primitive IDs of all primitives of a BVH leaf */
+    template<int N>
+    struct CollideLeafIDs
+    {
+      static const size_t maxPrims = 4*BVHN<N>::maxLeafBlocks;
+
+      template<typename Primitive>
+      __forceinline void gatherIDs(const char* leaf, size_t num)
+      {
+        const Primitive* prims = (const Primitive*) leaf;
+        for (size_t i=0; i<num; i++) {
+          for (size_t j=0; j<Primitive::max_size(); j++) {
+            if (!prims[i].valid(j)) break;
+            geomIDs[numPrims] = prims[i].geomID(j);
+            primIDs[numPrims] = prims[i].primID(j);
+            numPrims++;
+          }
+        }
+      }
+
+      __forceinline CollideLeafIDs (const PrimitiveType* primTy, typename BVHN<N>::NodeRef ref)
+        : numPrims(0)
+      {
+        size_t num; const char* leaf = ref.leaf(num);
+        if      (primTy == &Triangle4::type   ) gatherIDs<Triangle4   >(leaf,num);
+        else if (primTy == &Triangle4v::type  ) gatherIDs<Triangle4v  >(leaf,num);
+        else if (primTy == &Triangle4i::type  ) gatherIDs<Triangle4i  >(leaf,num);
+        else if (primTy == &Triangle4vMB::type) gatherIDs<Triangle4vMB>(leaf,num);
+        else if (primTy == &Quad4v::type      ) gatherIDs<Quad4v      >(leaf,num);
+        else if (primTy == &Quad4i::type      ) gatherIDs<Quad4i      >(leaf,num);
+        else if (primTy == &Object::type)
+        {
+          const Object* prims = (const Object*) leaf;
+          for (size_t i=0; i<num; i++) {
+            geomIDs[numPrims] = prims[i].geomID();
+            primIDs[numPrims] = prims[i].primID();
+            numPrims++;
           }
         }
+        else assert(false);
+      }
+
+      size_t numPrims;
+      unsigned int geomIDs[maxPrims];
+      unsigned int primIDs[maxPrims];
+    };
+
+    /* triangles of a triangle or quad mesh BVH leaf, quads get split into two triangles */
+    template<int N>
+    struct CollideLeafTriangles : public CollideLeafIDs<N>
+    {
+      static const size_t maxPrims = CollideLeafIDs<N>::maxPrims;
+      static const size_t maxTriangles = 2*maxPrims;
+
+      __forceinline void addTriangle(size_t prim, const Vec3fa& a, const Vec3fa& b, const Vec3fa& c)
+      {
+        v0[numTriangles] = a;
+        v1[numTriangles] = b;
+        v2[numTriangles] = c;
+        primOfTriangle[numTriangles] = (unsigned int) prim;
+        numTriangles++;
+      }
+
+      __forceinline CollideLeafTriangles (Scene* scene, const PrimitiveType* primTy, typename BVHN<N>::NodeRef ref)
+        : CollideLeafIDs<N>(primTy,ref), numTriangles(0)
+      {
+        for (size_t i=0; i<this->numPrims; i++)
+        {
+          Geometry* geom = scene->get(this->geomIDs[i]);
+          if (geom->getType() == Geometry::GTY_TRIANGLE_MESH)
+          {
+            const TriangleMesh* mesh = (const TriangleMesh*) geom;
+            const TriangleMesh::Triangle& tri = mesh->triangle(this->primIDs[i]);
+            vertexIDs[i] = vint4(tri.v[0],tri.v[1],tri.v[2],tri.v[2]);
+            addTriangle(i,mesh->vertex(tri.v[0]),mesh->vertex(tri.v[1]),mesh->vertex(tri.v[2]));
+          }
+          else
+          {
+            const QuadMesh* mesh = (const QuadMesh*) geom;
+            const QuadMesh::Quad& quad = mesh->quad(this->primIDs[i]);
+            vertexIDs[i] = vint4(quad.v[0],quad.v[1],quad.v[2],quad.v[3]);
+            const Vec3fa q0 = mesh->vertex(quad.v[0]);
+            const Vec3fa q1 = mesh->vertex(quad.v[1]);
+            const Vec3fa q2 = mesh->vertex(quad.v[2]);
+            const Vec3fa q3 = mesh->vertex(quad.v[3]);
+            addTriangle(i,q0,q1,q3);
+            if (quad.v[2] != quad.v[3]) addTriangle(i,q2,q3,q1);
+          }
+        }
+      }
+
+      size_t numTriangles;
+      vint4 vertexIDs[maxPrims];
+      Vec3fa v0[maxTriangles];
+      Vec3fa v1[maxTriangles];
+      Vec3fa v2[maxTriangles];
+      unsigned int primOfTriangle[maxTriangles];
+    };
+
+    template<int N>
+    __forceinline void BVHNColliderMesh<N>::processLeaf(NodeRef node0, NodeRef node1, Buffer& buffer)
+    {
+      const CollideLeafTriangles<N> leaf0(this->scene0,primTy0,node0);
+      const CollideLeafTriangles<N> leaf1(this->scene1,primTy1,node1);
+      const size_t maxPrims = CollideLeafTriangles<N>::maxPrims;
+      bool reported[maxPrims][maxPrims] = {};
+
+      /* in self collision mode pairs within a leaf get visited once, skipping shared vertices is optional */
+      const bool sameLeaf = this->self && node0 == node1;
+      const bool skipShared = !this->self || (this->flags & RTC_COLLIDE_FLAG_SKIP_SHARED_VERTICES);
+
+      for (size_t j=0; j<leaf1.numTriangles; j+=4)
+      {
+        /* gather up to 4 triangles of the second leaf */
+        Vec3vf4 b0, b1, b2;
+        const size_t numB = min(leaf1.numTriangles-j,size_t(4));
+        for (size_t k=0; k<4; k++) {
+          const size_t jk = j+min(k,numB-1);
+          b0.x[k] = leaf1.v0[jk].x; b0.y[k] = leaf1.v0[jk].y; b0.z[k] = leaf1.v0[jk].z;
+          b1.x[k] = leaf1.v1[jk].x; b1.y[k] = leaf1.v1[jk].y; b1.z[k] = leaf1.v1[jk].z;
+          b2.x[k] = leaf1.v2[jk].x; b2.y[k] = leaf1.v2[jk].y; b2.z[k] = leaf1.v2[jk].z;
+        }
+        const BBox<Vec3vf4> boundsB(min(b0,b1,b2),max(b0,b1,b2));
+        const size_t validB = (size_t(1) << numB)-1;
+
+        for (size_t i=0; i<leaf0.numTriangles; i++)
+        {
+          CSTAT(bvh_collide_leaf_iterations++);
+          const Vec3fa& a0 = leaf0.v0[i];
+          const Vec3fa& a1 = leaf0.v1[i];
+          const Vec3fa& a2 = leaf0.v2[i];
+          size_t mask = validB & overlap<4>(BBox3fa(min(a0,a1,a2),max(a0,a1,a2)),boundsB);
+          if (mask == 0) continue;
+          mask &= movemask(TriangleTriangleIntersector::cull_triangle_triangle<4>(a0,a1,a2,b0,b1,b2));
+
+          for (; mask!=0; mask=btc(mask,bsf(mask)))
+          {
+            const size_t jk = j+bsf(mask);
+            const unsigned int prim0 = leaf0.primOfTriangle[i];
+            const unsigned int prim1 = leaf1.primOfTriangle[jk];
+            if (sameLeaf && prim0 >= prim1) continue;
+            if (reported[prim0][prim1]) continue;
+
+            const unsigned geomID0 = leaf0.geomIDs[prim0];
+            const unsigned primID0 = leaf0.primIDs[prim0];
+            const unsigned geomID1 = leaf1.geomIDs[prim1];
+            const unsigned primID1 = leaf1.primIDs[prim1];
+
+            /* ignore self intersections and intersections with topological neighbors */
+            if (this->scene0 == this->scene1 && geomID0 == geomID1)
+            {
+              if (primID0 == primID1) continue;
+              if (skipShared) {
+                const vint4& t0 = leaf0.vertexIDs[prim0];
+                const vint4& t1 = leaf1.vertexIDs[prim1];
+                if (any(vint4(t1[0]) == t0) || any(vint4(t1[1]) == t0) || any(vint4(t1[2]) == t0) || any(vint4(t1[3]) == t0)) continue;
+              }
+            }
+
+            CSTAT(bvh_collide_prim_intersections++);
+            if (!TriangleTriangleIntersector::intersect_triangle_triangle(a0,a1,a2,leaf1.v0[jk],leaf1.v1[jk],leaf1.v2[jk]))
+              continue;
+
+            reported[prim0][prim1] = true;
+            buffer.add({geomID0,primID0,geomID1,primID1});
+          }
+        }
+      }
+    }
+
+    /* sub range of [0,1] in which d0+t*(d1-d0) <= 0 holds */
+    __forceinline BBox1f nonPositiveRange(float d0, float d1)
+    {
+      if (d0 <= 0.0f && d1 <= 0.0f) return BBox1f(0.0f,1.0f);
+      if (d0 >  0.0f && d1 >  0.0f) return BBox1f(empty);
+      const float t = d0/(d0-d1);
+      return d0 <= 0.0f ? BBox1f(0.0f,t) : BBox1f(t,1.0f);
+    }
+
+    /* sub range of time_range in which two linear bounds overlap, the bounds are given at the start and end of time_range */
+    __forceinline BBox1f overlapRange(const LBBox3fa& box0, const LBBox3fa& box1, const BBox1f& time_range)
+    {
+      const Vec3fa dl0 = box0.bounds0.lower-box1.bounds0.upper;
+      const Vec3fa dl1 = box0.bounds1.lower-box1.bounds1.upper;
+      const Vec3fa du0 = box1.bounds0.lower-box0.bounds0.upper;
+      const Vec3fa du1 = box1.bounds1.lower-box0.bounds1.upper;
+      BBox1f t(0.0f,1.0f);
+      for (size_t i=0; i<3; i++) {
+        t = intersect(t,nonPositiveRange(dl0[i],dl1[i]));
+        t = intersect(t,nonPositiveRange(du0[i],du1[i]));
+      }
+      if (t.empty()) return t;
+      return BBox1f(lerp(time_range.lower,time_range.upper,t.lower),
+                    lerp(time_range.lower,time_range.upper,t.upper));
+    }
+
+    /* linear bounds of a primitive over some time range, primitives without motion blur have constant bounds */
+    template<typename Mesh>
+    __forceinline LBBox3fa primLinearBounds(const Mesh* mesh, size_t primID, const BBox1f& time_range)
+    {
+      if (mesh->numTimeSteps == 1)
+        return LBBox3fa(mesh->bounds(primID,0));
+
+      const BBox1f dt = intersect(time_range,mesh->time_range);
+      if (dt.lower < dt.upper)
+        return mesh->linearBounds(primID,dt);
+
+      /* the time range is a single point in time or outside the time range of the geometry */
+      float ftime; const int itime = mesh->timeSegment(clamp(time_range.lower,mesh->time_range.lower,mesh->time_range.upper),ftime);
+      return LBBox3fa(mesh->linearBounds(primID,size_t(itime)).interpolate(ftime));
+    }
+
+    __forceinline LBBox3fa primLinearBounds(Scene* scene, unsigned geomID, unsigned primID, const BBox1f& time_range)
+    {
+      const Geometry* geom = scene->get(geomID);
+      switch (geom->getType()) {
+      case Geometry::GTY_TRIANGLE_MESH: return primLinearBounds((const TriangleMesh*) geom,primID,time_range);
+      case Geometry::GTY_QUAD_MESH    : return primLinearBounds((const QuadMesh*) geom,primID,time_range);
+      default                         : return primLinearBounds((const AccelSet*) geom,primID,time_range);
+      }
+    }
+
+    template<int N>
+    void BVHNColliderContinuous<N>::processLeaf(NodeRef node0, NodeRef node1, const BBox1f& time_range, Buffer& buffer)
+    {
+      const CollideLeafIDs<N> leaf0(primTy0,node0);
+      const CollideLeafIDs<N> leaf1(primTy1,node1);
+      LBBox3fa bounds1[CollideLeafIDs<N>::maxPrims];
+      for (size_t j=0; j<leaf1.numPrims; j++)
+        bounds1[j] = primLinearBounds(scene1,leaf1.geomIDs[j],leaf1.primIDs[j],time_range);
+
+      for (size_t i=0; i<leaf0.numPrims; i++)
+      {
+        const unsigned geomID0 = leaf0.geomIDs[i];
+        const unsigned primID0 = leaf0.primIDs[i];
+        const LBBox3fa bounds0 = primLinearBounds(scene0,geomID0,primID0,time_range);
+        const unsigned numTimeSegments0 = scene0->get(geomID0)->numTimeSegments();
+
+        for (size_t j=0; j<leaf1.numPrims; j++)
+        {
+          CSTAT(bvh_collide_leaf_iterations++);
+          const unsigned geomID1 = leaf1.geomIDs[j];
+          const unsigned primID1 = leaf1.primIDs[j];
+          if (scene0 == scene1 && geomID0 == geomID1 && primID0 == primID1) continue;
+
+          BBox1f t = overlapRange(bounds0,bounds1[j],time_range);
+          if (t.empty()) continue;
+
+          /* for multi segment motion blur find the earliest segment sized sub range the primitives overlap in */
+          const unsigned numSegments = max(numTimeSegments0,scene1->get(geomID1)->numTimeSegments());
+          if (numSegments > 1 && t.lower < t.upper)
+          {
+            const BBox1f range = t;
+            t = BBox1f(empty);
+            for (unsigned k=0; k<numSegments && t.empty(); k++) {
+              const BBox1f dt(lerp(range.lower,range.upper,float(k+0)/float(numSegments)),
+                              lerp(range.lower,range.upper,float(k+1)/float(numSegments)));
+              t = overlapRange(primLinearBounds(scene0,geomID0,primID0,dt),
+                               primLinearBounds(scene1,geomID1,primID1,dt),dt);
+            }
+            if (t.empty()) continue;
+          }
+
+          buffer.add({geomID0,primID0,geomID1,primID1,t.lower,t.upper});
+        }
+      }
+    }
+
+    /* calls func for all children of a node with their linear bounds and the time range they are valid in */
+    template<int N, typename Func>
+    __forceinline void foreachChild(typename BVHN<N>::NodeRef ref, const Func& func)
+    {
+      if (ref.isAABBNode())
+      {
+        const typename BVHN<N>::AABBNode* node = ref.getAABBNode();
+        for (size_t i=0; i<N; i++) {
+          if (node->child(i) == BVHN<N>::emptyNode) continue;
+          func(node->child(i),LBBox3fa(node->bounds(i)),BBox1f(0.0f,1.0f));
+        }
+      }
+      else if (ref.isAABBNodeMB4D())
+      {
+        const typename BVHN<N>::AABBNodeMB4D* node = ref.getAABBNodeMB4D();
+        for (size_t i=0; i<N; i++) {
+          if (node->child(i) == BVHN<N>::emptyNode) continue;
+          func(node->child(i),node->lbounds(i),node->timeRange(i));
+        }
+      }
+      else
+      {
+        assert(ref.isAABBNodeMB());
+        const typename BVHN<N>::AABBNodeMB* node = ref.getAABBNodeMB();
+        for (size_t i=0; i<N; i++) {
+          if (node->child(i) == BVHN<N>::emptyNode) continue;
+          func(node->child(i),node->lbounds(i),BBox1f(0.0f,1.0f));
+        }
       }
-      if (num_collisions)
-        this->callback(this->userPtr,(RTCCollision*)&collisions,num_collisions);
     }
 
     template<int N>
-    void BVHNCollider<N>::collide_recurse(NodeRef ref0, const BBox3fa& bounds0, NodeRef ref1, const BBox3fa& bounds1, size_t depth0, size_t depth1)
+    void BVHNColliderContinuous<N>::collide_recurse(NodeRef ref0, const LBBox3fa& bounds0, NodeRef ref1, const LBBox3fa& bounds1, const BBox1f& time_range, size_t depth, Buffer& buffer)
+    {
+      CSTAT(bvh_collide_traversal_steps++);
+      if (ref0.isLeaf() && ref1.isLeaf()) {
+        CSTAT(bvh_collide_leaf_pairs++);
+        processLeaf(ref0,ref1,time_range,buffer);
+        return;
+      }
+
+      /* descend into the node with the larger expected area */
+      const bool recurse_node0 = !ref0.isLeaf() && (ref1.isLeaf() || bounds0.expectedHalfArea(time_range) > bounds1.expectedHalfArea(time_range));
+      const NodeRef ref = recurse_node0 ? ref0 : ref1;
+      const LBBox3fa& other = recurse_node0 ? bounds1 : bounds0;
+
+      NodeRef children[N];
+      LBBox3fa childBounds[N];
+      BBox1f childTimeRange[N];
+      size_t numChildren = 0;
+      foreachChild<N>(ref, [&] (NodeRef child, const LBBox3fa& lbounds, const BBox1f& child_time_range)
+      {
+        const BBox1f dt = intersect(time_range,child_time_range);
+        if (dt.empty()) return;
+        const BBox1f t = overlapRange(lbounds.interpolate(dt),other.interpolate(dt),dt);
+        if (t.empty()) return;
+        children[numChildren] = child;
+        childBounds[numChildren] = lbounds;
+        childTimeRange[numChildren] = t;
+        numChildren++;
+      });
+
+      auto recurse = [&] (size_t i, Buffer& buffer) {
+        if (recurse_node0) collide_recurse(children[i],childBounds[i],ref1,bounds1,childTimeRange[i],depth+1,buffer);
+        else               collide_recurse(ref0,bounds0,children[i],childBounds[i],childTimeRange[i],depth+1,buffer);
+      };
+
+      /* spawn a task with its own collision buffer per child, idle threads steal these tasks */
+      if (depth < parallel_depth_threshold && numChildren > 1) {
+        parallel_for(numChildren, [&] (size_t i) {
+          Buffer taskBuffer(callback,userPtr);
+          recurse(i,taskBuffer);
+        });
+      }
+      else for (size_t i=0; i<numChildren; i++) recurse(i,buffer);
+    }
+
+    template<int N>
+    void BVHNColliderContinuous<N>::collideContinuous(BVH* __restrict__ bvh0, BVH* __restrict__ bvh1, const BBox1f& time_range, RTCCollideContinuousFunc callback, void* userPtr)
+    {
+      if (bvh0->root == BVH::emptyNode || bvh1->root == BVH::emptyNode) return;
+      const BBox1f t = overlapRange(bvh0->bounds.interpolate(time_range),bvh1->bounds.interpolate(time_range),time_range);
+      if (t.empty()) return;
+      Buffer buffer(callback,userPtr);
+      BVHNColliderContinuous<N>(bvh0->scene,bvh0->primTy,bvh1->scene,bvh1->primTy,callback,userPtr).
+        collide_recurse(bvh0->root,bvh0->bounds,bvh1->root,bvh1->bounds,t,0,buffer);
+    }
+
+    template<int N>
+    void BVHNCollider<N>::collideContinuous(BVH* __restrict__ bvh0, BVH* __restrict__ bvh1, const BBox1f& time_range, RTCCollideContinuousFunc callback, void* userPtr)
+    {
+      BVHNColliderContinuous<N>::collideContinuous(bvh0,bvh1,time_range,callback,userPtr);
+    }
+
+    template<int N>
+    void BVHNCollider<N>::collide_recurse(NodeRef ref0, const BBox3fa& bounds0, NodeRef ref1, const BBox3fa& bounds1, size_t depth0, size_t depth1, Buffer& buffer)
     {
       CSTAT(bvh_collide_traversal_steps++);
       if (unlikely(ref0.isLeaf())) {
         if (unlikely(ref1.isLeaf())) {
           CSTAT(bvh_collide_leaf_pairs++);
-          processLeaf(ref0,ref1);
+          processLeaf(ref0,ref1,buffer);
           return;
         } else goto recurse_node1;
         
@@ -163,24 +505,23 @@ namespace embree
       recurse_node0:
         AABBNode* node0 = ref0.getAABBNode();
         size_t mask = overlap<N>(bounds1,*node0);
-        //for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m)) {
-        //for (size_t i=0; i<N; i++) {
-#if 0
-        if (depth0 < parallel_depth_threshold) 
+
+        /* spawn a task with its own collision buffer per overlapping child, idle threads steal these tasks */
+        if (depth0+depth1 < parallel_depth_threshold && (mask & (mask-1)))
         {
-          parallel_for(size_t(N), [&] ( size_t i ) {
-              if (mask & ( 1 << i)) {
-                BVHN<N>::prefetch(node0->child(i),BVH_FLAG_ALIGNED_NODE);
-                collide_recurse(node0->child(i),node0->bounds(i),ref1,bounds1,depth0+1,depth1);
-              }
+          size_t children[N], num = 0;
+          for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m)) children[num++] = i;
+          parallel_for(num, [&] ( size_t k ) {
+              const size_t i = children[k];
+              Buffer taskBuffer(callback,userPtr);
+              collide_recurse(node0->child(i),node0->bounds(i),ref1,bounds1,depth0+1,depth1,taskBuffer);
             });
         } 
         else
-#endif
         {
           for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m)) {
             BVHN<N>::prefetch(node0->child(i),BVH_FLAG_ALIGNED_NODE);
-            collide_recurse(node0->child(i),node0->bounds(i),ref1,bounds1,depth0+1,depth1);
+            collide_recurse(node0->child(i),node0->bounds(i),ref1,bounds1,depth0+1,depth1,buffer);
           }
         }
         return;
@@ -190,72 +531,29 @@ namespace embree
       recurse_node1:
         AABBNode* node1 = ref1.getAABBNode();
         size_t mask = overlap<N>(bounds0,*node1);
-        //for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m)) {
-        //for (size_t i=0; i<N; i++) {
-#if 0
-        if (depth1 < parallel_depth_threshold) 
+
+        /* spawn a task with its own collision buffer per overlapping child, idle threads steal these tasks */
+        if (depth0+depth1 < parallel_depth_threshold && (mask & (mask-1)))
         {
-          parallel_for(size_t(N), [&] ( size_t i ) {
-              if (mask & ( 1 << i)) {
-                BVHN<N>::prefetch(node1->child(i),BVH_FLAG_ALIGNED_NODE);
-                collide_recurse(ref0,bounds0,node1->child(i),node1->bounds(i),depth0,depth1+1);
-              }
+          size_t children[N], num = 0;
+          for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m)) children[num++] = i;
+          parallel_for(num, [&] ( size_t k ) {
+              const size_t i = children[k];
+              Buffer taskBuffer(callback,userPtr);
+              collide_recurse(ref0,bounds0,node1->child(i),node1->bounds(i),depth0,depth1+1,taskBuffer);
             });
         }
         else
-#endif
         {
           for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m)) {
             BVHN<N>::prefetch(node1->child(i),BVH_FLAG_ALIGNED_NODE);
-            collide_recurse(ref0,bounds0,node1->child(i),node1->bounds(i),depth0,depth1+1);
+            collide_recurse(ref0,bounds0,node1->child(i),node1->bounds(i),depth0,depth1+1,buffer);
           }
         }
         return;
       }
     }
 
-    template<int N>
-    void BVHNCollider<N>::split(const CollideJob& job, jobvector& jobs)
-    {
-      if (unlikely(job.ref0.isLeaf())) {
-        if (unlikely(job.ref1.isLeaf())) {
-          jobs.push_back(job);
-          return;
-        } else goto recurse_node1;
-      } else {
-        if (unlikely(job.ref1.isLeaf())) {
-          goto recurse_node0;
-        } else {
-          if (area(job.bounds0) > area(job.bounds1)) {
-            goto recurse_node0;
-          }
-          else {
-            goto recurse_node1;
-          }
-        }
-      }
-      
-      {
-      recurse_node0:
-        const AABBNode* node0 = job.ref0.getAABBNode();
-        size_t mask = overlap<N>(job.bounds1,*node0);
-        for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m)) {
-          jobs.push_back(CollideJob(node0->child(i),node0->bounds(i),job.depth0+1,job.ref1,job.bounds1,job.depth1));
-        }
-        return;
-      }
-      
-      {
-      recurse_node1:
-        const AABBNode* node1 = job.ref1.getAABBNode();
-        size_t mask = overlap<N>(job.bounds0,*node1);
-        for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m)) {
-          jobs.push_back(CollideJob(job.ref0,job.bounds0,job.depth0,node1->child(i),node1->bounds(i),job.depth1+1));
-        }
-        return;
-      }
-    }
-    
     template<int N>
     void BVHNCollider<N>::collide_recurse_entry(NodeRef ref0, const BBox3fa& bounds0, NodeRef ref1, const BBox3fa& bounds1)
     {
@@ -268,47 +566,12 @@ namespace embree
       CSTAT(bvh_collide_prim_intersections4 = 0);
       CSTAT(bvh_collide_prim_intersections5 = 0);
       CSTAT(bvh_collide_prim_intersections = 0);
-#if 0
-      collide_recurse(ref0,bounds0,ref1,bounds1,0,0);
-#else
-      const int M = 2048;
-      jobvector jobs[2];
-      jobs[0].reserve(M);
-      jobs[1].reserve(M);
-      jobs[0].push_back(CollideJob(ref0,bounds0,0,ref1,bounds1,0));
-      int source = 0;
-      int target = 1;
-
-      /* try to split job until job list is full */
-      while (jobs[source].size()+8 <= M)
-      {
-        for (size_t i=0; i<jobs[source].size(); i++)
-        {
-          const CollideJob& job = jobs[source][i];
-          size_t remaining = jobs[source].size()-i;
-          if (jobs[target].size()+remaining+8 > M) {
-            jobs[target].push_back(job);
-          } else {
-            split(job,jobs[target]);
-          }
-        }
 
-        /* stop splitting jobs if we reached only leaves and cannot make progress anymore */
-        if (jobs[target].size() == jobs[source].size())
-          break;
-
-        jobs[source].resize(0);
-        std::swap(source,target);
+      {
+        Buffer buffer(callback,userPtr);
+        collide_recurse(ref0,bounds0,ref1,bounds1,0,0,buffer);
       }
 
-      /* parallel processing of all jobs */
-      parallel_for(size_t(jobs[source].size()), [&] ( size_t i ) {
-          CollideJob& j = jobs[source][i];
-          collide_recurse(j.ref0,j.bounds0,j.ref1,j.bounds1,j.depth0,j.depth1);
-        });
-      
-      
-#endif
       CSTAT(PRINT(bvh_collide_traversal_steps));
       CSTAT(PRINT(bvh_collide_leaf_pairs));
       CSTAT(PRINT(bvh_collide_leaf_iterations));
@@ -320,6 +583,47 @@ namespace embree
       CSTAT(PRINT(bvh_collide_prim_intersections));
     }
    
+    template<int N>
+    void BVHNCollider<N>::collide_self_recurse(NodeRef ref, size_t depth, Buffer& buffer)
+    {
+      CSTAT(bvh_collide_traversal_steps++);
+      if (unlikely(ref.isLeaf())) {
+        CSTAT(bvh_collide_leaf_pairs++);
+        processLeaf(ref,ref,buffer);
+        return;
+      }
+
+      /* collide each child with itself and with all children to its right, thus every unordered pair of children is visited once */
+      const AABBNode* node = ref.getAABBNode();
+      auto recurse = [&] (size_t i, Buffer& buffer)
+      {
+        if (node->child(i) == BVH::emptyNode) return;
+        collide_self_recurse(node->child(i),depth+1,buffer);
+        
+        const BBox3fa bounds_i = node->bounds(i);
+        size_t mask = overlap<N>(bounds_i,*node) & ~((size_t(2) << i)-1);
+        for (size_t m=mask, j=bsf(m); m!=0; m=btc(m,j), j=bsf(m))
+          collide_recurse(node->child(i),bounds_i,node->child(j),node->bounds(j),depth+1,depth+1,buffer);
+      };
+
+      if (2*depth < parallel_depth_threshold) {
+        parallel_for(size_t(N), [&] (size_t i) {
+          Buffer taskBuffer(callback,userPtr);
+          recurse(i,taskBuffer);
+        });
+      }
+      else for (size_t i=0; i<N; i++) recurse(i,buffer);
+    }
+
+    template<int N>
+    void BVHNCollider<N>::collide_self_entry(NodeRef ref, RTCCollideFlags flags)
+    {
+      this->self = true;
+      this->flags = flags;
+      Buffer buffer(callback,userPtr);
+      collide_self_recurse(ref,0,buffer);
+    }
+
     template<int N>
     void BVHNColliderUserGeom<N>::collide(BVH* __restrict__ bvh0, BVH* __restrict__ bvh1, RTCCollideFunc callback, void* userPtr)
     { 
@@ -327,6 +631,25 @@ namespace embree
         collide_recurse_entry(bvh0->root,bvh0->bounds.bounds(),bvh1->root,bvh1->bounds.bounds());
     }
 
+    template<int N>
+    void BVHNColliderMesh<N>::collide(BVH* __restrict__ bvh0, BVH* __restrict__ bvh1, RTCCollideFunc callback, void* userPtr)
+    { 
+      BVHNColliderMesh<N>(bvh0->scene,bvh0->primTy,bvh1->scene,bvh1->primTy,callback,userPtr).
+        collide_recurse_entry(bvh0->root,bvh0->bounds.bounds(),bvh1->root,bvh1->bounds.bounds());
+    }
+
+    template<int N>
+    void BVHNColliderUserGeom<N>::collideSelf(BVH* __restrict__ bvh, RTCCollideFlags flags, RTCCollideFunc callback, void* userPtr)
+    {
+      BVHNColliderUserGeom<N>(bvh->scene,bvh->scene,callback,userPtr).collide_self_entry(bvh->root,flags);
+    }
+
+    template<int N>
+    void BVHNColliderMesh<N>::collideSelf(BVH* __restrict__ bvh, RTCCollideFlags flags, RTCCollideFunc callback, void* userPtr)
+    {
+      BVHNColliderMesh<N>(bvh->scene,bvh->primTy,bvh->scene,bvh->primTy,callback,userPtr).collide_self_entry(bvh->root,flags);
+    }
+
 #if defined (EMBREE_LOWEST_ISA)
     struct collision_regression_test : public RegressionTest
     {
@@ -369,9 +692,13 @@ namespace embree
     ////////////////////////////////////////////////////////////////////////////////
 
     DEFINE_COLLIDER(BVH4ColliderUserGeom,BVHNColliderUserGeom<4>);
+    DEFINE_COLLIDER(BVH4ColliderMesh,BVHNColliderMesh<4>);
+    DEFINE_CONTINUOUS_COLLIDER(BVH4ColliderContinuous,BVHNColliderContinuous<4>);
 
 #if defined(__AVX__)
     DEFINE_COLLIDER(BVH8ColliderUserGeom,BVHNColliderUserGeom<8>);
+    DEFINE_COLLIDER(BVH8ColliderMesh,BVHNColliderMesh<8>);
+    DEFINE_CONTINUOUS_COLLIDER(BVH8ColliderContinuous,BVHNColliderContinuous<8>);
 #endif
   }
 }
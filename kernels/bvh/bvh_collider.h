@@ -4,13 +4,51 @@
 #pragma once
 
 #include "bvh.h"
+#include "../geometry/triangle.h"
 #include "../geometry/trianglev.h"
+#include "../geometry/trianglev_mb.h"
+#include "../geometry/trianglei.h"
+#include "../geometry/quadv.h"
+#include "../geometry/quadi.h"
 #include "../geometry/object.h"
 
 namespace embree
 {
   namespace isa
   {
+    /* collects the collisions found by one traversal task and passes them in batches to the user callback */
+    template<typename Collision, typename CollideFunc>
+      struct CollisionBuffer
+    {
+      static const size_t maxCollisions = 256;
+
+      __forceinline CollisionBuffer (CollideFunc callback, void* userPtr)
+        : num(0), callback(callback), userPtr(userPtr) {}
+
+      __forceinline ~CollisionBuffer () {
+        flush();
+      }
+
+      __forceinline void add(const Collision& collision)
+      {
+        collisions[num++] = collision;
+        if (unlikely(num == maxCollisions)) flush();
+      }
+
+      __forceinline void flush()
+      {
+        if (num == 0) return;
+        callback(userPtr,collisions,(unsigned int)num);
+        num = 0;
+      }
+
+    private:
+      Collision collisions[maxCollisions];
+      size_t num;
+      CollideFunc callback;
+      void* userPtr;
+    };
+
     template<int N>
       class BVHNCollider
     {
@@ -18,40 +56,30 @@ namespace embree
       typedef typename BVH::NodeRef NodeRef;
       typedef typename BVH::AABBNode AABBNode;
 
-      struct CollideJob
-      {
-        CollideJob () {}
-        
-        CollideJob (NodeRef ref0, const BBox3fa& bounds0, size_t depth0,
-                    NodeRef ref1, const BBox3fa& bounds1, size_t depth1)
-        : ref0(ref0), bounds0(bounds0), depth0(depth0), ref1(ref1), bounds1(bounds1), depth1(depth1) {}
-        
-        NodeRef ref0;
-        BBox3fa bounds0;
-        size_t depth0;
-        NodeRef ref1;
-        BBox3fa bounds1;
-        size_t depth1;
-      };
-
-      typedef vector_t<CollideJob, aligned_allocator<CollideJob,16>> jobvector;
-
-      void split(const CollideJob& job, jobvector& jobs);
-      
+    protected:
+      typedef CollisionBuffer<RTCCollision,RTCCollideFunc> Buffer;
+
     public:
       __forceinline BVHNCollider (Scene* scene0, Scene* scene1, RTCCollideFunc callback, void* userPtr)
-        : scene0(scene0), scene1(scene1), callback(callback), userPtr(userPtr) {}
+        : scene0(scene0), scene1(scene1), callback(callback), userPtr(userPtr), self(false), flags(RTC_COLLIDE_FLAG_NONE) {}
 
     public:
-      virtual void processLeaf(NodeRef leaf0, NodeRef leaf1) = 0;
-      void collide_recurse(NodeRef node0, const BBox3fa& bounds0, NodeRef node1, const BBox3fa& bounds1, size_t depth0, size_t depth1);
+      virtual void processLeaf(NodeRef leaf0, NodeRef leaf1, Buffer& buffer) = 0;
+      void collide_recurse(NodeRef node0, const BBox3fa& bounds0, NodeRef node1, const BBox3fa& bounds1, size_t depth0, size_t depth1, Buffer& buffer);
       void collide_recurse_entry(NodeRef node0, const BBox3fa& bounds0, NodeRef node1, const BBox3fa& bounds1);
+      void collide_self_recurse(NodeRef node, size_t depth, Buffer& buffer);
+      void collide_self_entry(NodeRef node, RTCCollideFlags flags);
+
+    public:
+      static void collideContinuous(BVH* __restrict__ bvh0, BVH* __restrict__ bvh1, const BBox1f& time_range, RTCCollideContinuousFunc callback, void* userPtr);
     
     protected:
       Scene* scene0;
       Scene* scene1;
       RTCCollideFunc callback;
       void* userPtr;
+      bool self;               //!< each unordered pair of primitives of scene0 gets visited once
+      RTCCollideFlags flags;
     };
 
     template<int N>
@@ -60,13 +88,62 @@ namespace embree
       typedef BVHN<N> BVH;
       typedef typename BVH::NodeRef NodeRef;
       typedef typename BVH::AABBNode AABBNode;
+      typedef typename BVHNCollider<N>::Buffer Buffer;
 
       __forceinline BVHNColliderUserGeom (Scene* scene0, Scene* scene1, RTCCollideFunc callback, void* userPtr)
         : BVHNCollider<N>(scene0,scene1,callback,userPtr) {}
 
-      virtual void processLeaf(NodeRef leaf0, NodeRef leaf1);
+      virtual void processLeaf(NodeRef leaf0, NodeRef leaf1, Buffer& buffer);
     public:
       static void collide(BVH* __restrict__ bvh0, BVH* __restrict__ bvh1, RTCCollideFunc callback, void* userPtr);
+      static void collideSelf(BVH* __restrict__ bvh, RTCCollideFlags flags, RTCCollideFunc callback, void* userPtr);
+    };
+
+    template<int N>
+      class BVHNColliderMesh : public BVHNCollider<N>
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
+      typedef typename BVH::AABBNode AABBNode;
+      typedef typename BVHNCollider<N>::Buffer Buffer;
+
+      __forceinline BVHNColliderMesh (Scene* scene0, const PrimitiveType* primTy0, Scene* scene1, const PrimitiveType* primTy1, RTCCollideFunc callback, void* userPtr)
+        : BVHNCollider<N>(scene0,scene1,callback,userPtr), primTy0(primTy0), primTy1(primTy1) {}
+
+      virtual void processLeaf(NodeRef leaf0, NodeRef leaf1, Buffer& buffer);
+    public:
+      static void collide(BVH* __restrict__ bvh0, BVH* __restrict__ bvh1, RTCCollideFunc callback, void* userPtr);
+      static void collideSelf(BVH* __restrict__ bvh, RTCCollideFlags flags, RTCCollideFunc callback, void* userPtr);
+
+    private:
+      const PrimitiveType* primTy0;
+      const PrimitiveType* primTy1;
+    };
+
+    template<int N>
+      class BVHNColliderContinuous
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
+      typedef CollisionBuffer<RTCContinuousCollision,RTCCollideContinuousFunc> Buffer;
+
+    public:
+      __forceinline BVHNColliderContinuous (Scene* scene0, const PrimitiveType* primTy0, Scene* scene1, const PrimitiveType* primTy1, RTCCollideContinuousFunc callback, void* userPtr)
+        : scene0(scene0), primTy0(primTy0), scene1(scene1), primTy1(primTy1), callback(callback), userPtr(userPtr) {}
+
+      void processLeaf(NodeRef leaf0, NodeRef leaf1, const BBox1f& time_range, Buffer& buffer);
+      void collide_recurse(NodeRef node0, const LBBox3fa& bounds0, NodeRef node1, const LBBox3fa& bounds1, const BBox1f& time_range, size_t depth, Buffer& buffer);
+
+    public:
+      static void collideContinuous(BVH* __restrict__ bvh0, BVH* __restrict__ bvh1, const BBox1f& time_range, RTCCollideContinuousFunc callback, void* userPtr);
+
+    private:
+      Scene* scene0;
+      const PrimitiveType* primTy0;
+      Scene* scene1;
+      const PrimitiveType* primTy1;
+      RTCCollideContinuousFunc callback;
+      void* userPtr;
     };
   }
 }
@@ -0,0 +1,222 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "bvh_frustum_query.h"
+
+#include "../geometry/triangle.h"
+#include "../geometry/trianglev.h"
+#include "../geometry/trianglev_mb.h"
+#include "../geometry/trianglei.h"
+#include "../geometry/quadv.h"
+#include "../geometry/quadi.h"
+#include "../geometry/object.h"
+#include "../geometry/instance.h"
+#include "../geometry/instance_array.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /* classifies boxes against the frustum planes, a box is outside if it is completely behind some plane and
+     * inside if it is completely in front of all planes, works for single boxes and N boxes of a node */
+    template<typename Float, typename Bool>
+    __forceinline void classifyBounds(const FrustumQueryContext::Planes& planes,
+                                      const Float& lowerX, const Float& lowerY, const Float& lowerZ,
+                                      const Float& upperX, const Float& upperY, const Float& upperZ,
+                                      Bool& outside, Bool& inside)
+    {
+      for (size_t i=0; i<6; i++)
+      {
+        const Vec3fa& n = planes.normal[i];
+
+        /* the box corners farthest in front of and behind the plane */
+        const Float maxDist = madd(Float(n.x),n.x >= 0.0f ? upperX : lowerX,
+                              madd(Float(n.y),n.y >= 0.0f ? upperY : lowerY,
+                              madd(Float(n.z),n.z >= 0.0f ? upperZ : lowerZ,Float(planes.offset[i]))));
+        const Float minDist = madd(Float(n.x),n.x >= 0.0f ? lowerX : upperX,
+                              madd(Float(n.y),n.y >= 0.0f ? lowerY : upperY,
+                              madd(Float(n.z),n.z >= 0.0f ? lowerZ : upperZ,Float(planes.offset[i]))));
+        outside = outside | (maxDist < Float(zero));
+        inside  = inside  & (minDist >= Float(zero));
+      }
+    }
+
+    /* returns the masks of children outside and completely inside the frustum */
+    template<int N>
+    __forceinline void classifyNode(const FrustumQueryContext::Planes& planes,
+                                    const vfloat<N>& lowerX, const vfloat<N>& lowerY, const vfloat<N>& lowerZ,
+                                    const vfloat<N>& upperX, const vfloat<N>& upperY, const vfloat<N>& upperZ,
+                                    size_t& outside, size_t& inside)
+    {
+      vbool<N> vout(false), vin(true);
+      classifyBounds(planes,lowerX,lowerY,lowerZ,upperX,upperY,upperZ,vout,vin);
+      outside = movemask(vout);
+      inside  = movemask(vin);
+    }
+
+    template<int N>
+    void BVHNFrustumQuery<N>::query_recurse(NodeRef ref, bool inside)
+    {
+      if (unlikely(ref.isLeaf())) {
+        processLeaf(ref,inside);
+        return;
+      }
+
+      /* all children of a node inside the frustum are inside, no more plane tests required */
+      const typename BVH::BaseNode* node = ref.baseNode();
+      if (inside)
+      {
+        for (size_t i=0; i<N; i++) {
+          if (node->child(i) == BVH::emptyNode) continue;
+          query_recurse(node->child(i),true);
+        }
+        return;
+      }
+
+      const float time = context->time;
+      size_t valid = 0, outside = 0, insideMask = 0;
+      if (likely(ref.isAABBNode()))
+      {
+        const typename BVH::AABBNode* n = ref.getAABBNode();
+        classifyNode<N>(context->planes,n->lower_x,n->lower_y,n->lower_z,n->upper_x,n->upper_y,n->upper_z,outside,insideMask);
+        valid = (size_t(1) << N)-1;
+      }
+      else if (ref.isAABBNodeMB() || ref.isAABBNodeMB4D())
+      {
+        const typename BVH::AABBNodeMB* n = ref.getAABBNodeMB();
+        classifyNode<N>(context->planes,
+                        madd(time,n->lower_dx,n->lower_x),madd(time,n->lower_dy,n->lower_y),madd(time,n->lower_dz,n->lower_z),
+                        madd(time,n->upper_dx,n->upper_x),madd(time,n->upper_dy,n->upper_y),madd(time,n->upper_dz,n->upper_z),
+                        outside,insideMask);
+        valid = (size_t(1) << N)-1;
+        if (unlikely(ref.isAABBNodeMB4D())) {
+          const typename BVH::AABBNodeMB4D* n4d = ref.getAABBNodeMB4D();
+          valid = movemask((n4d->lower_t <= time) & (time < n4d->upper_t));
+        }
+      }
+      else if (ref.isQuantizedNode())
+      {
+        const typename BVH::QuantizedNode* n = ref.quantizedNode();
+        classifyNode<N>(context->planes,
+                        n->dequantizeLowerX(),n->dequantizeLowerY(),n->dequantizeLowerZ(),
+                        n->dequantizeUpperX(),n->dequantizeUpperY(),n->dequantizeUpperZ(),
+                        outside,insideMask);
+        valid = movemask(n->validMask());
+      }
+      else
+      {
+        /* oriented nodes are conservatively treated as intersecting the frustum */
+        valid = (size_t(1) << N)-1;
+      }
+
+      for (size_t i=0; i<N; i++)
+      {
+        if (node->child(i) == BVH::emptyNode) continue;
+        if (!(valid & (size_t(1) << i)) || (outside & (size_t(1) << i))) continue;
+        query_recurse(node->child(i),(insideMask >> i) & 1);
+      }
+    }
+
+    template<typename Primitive>
+    __forceinline void reportPrimitives(FrustumQueryContext* context, const char* leaf, size_t num, bool inside)
+    {
+      const Primitive* prims = (const Primitive*) leaf;
+      for (size_t i=0; i<num; i++) {
+        for (size_t j=0; j<Primitive::max_size(); j++) {
+          if (!prims[i].valid(j)) break;
+          context->add(prims[i].geomID(j),prims[i].primID(j),inside);
+        }
+      }
+    }
+
+    template<int N>
+    void BVHNFrustumQuery<N>::processLeaf(NodeRef ref, bool inside)
+    {
+      size_t num; const char* leaf = ref.leaf(num);
+      const PrimitiveType* primTy = bvh->primTy;
+      if      (primTy == &Triangle4::type   ) reportPrimitives<Triangle4   >(context,leaf,num,inside);
+      else if (primTy == &Triangle4v::type  ) reportPrimitives<Triangle4v  >(context,leaf,num,inside);
+      else if (primTy == &Triangle4i::type  ) reportPrimitives<Triangle4i  >(context,leaf,num,inside);
+      else if (primTy == &Triangle4vMB::type) reportPrimitives<Triangle4vMB>(context,leaf,num,inside);
+      else if (primTy == &Quad4v::type      ) reportPrimitives<Quad4v      >(context,leaf,num,inside);
+      else if (primTy == &Quad4i::type      ) reportPrimitives<Quad4i      >(context,leaf,num,inside);
+      else if (primTy == &Object::type)
+      {
+        const Object* prims = (const Object*) leaf;
+        for (size_t i=0; i<num; i++)
+          context->add(prims[i].geomID(),prims[i].primID(),inside);
+      }
+      else if (primTy == &InstancePrimitive::type)
+      {
+        const InstancePrimitive* prims = (const InstancePrimitive*) leaf;
+        for (size_t i=0; i<num; i++) {
+          const Instance* instance = prims[i].instance;
+          processInstance(prims[i].instID_,0,instance->object,instance->getLocal2World(context->time),inside);
+        }
+      }
+      else if (primTy == &InstanceArrayPrimitive::type)
+      {
+        const InstanceArrayPrimitive* prims = (const InstanceArrayPrimitive*) leaf;
+        for (size_t i=0; i<num; i++) {
+          if (!prims[i].valid()) continue;
+          const InstanceArray* instance = bvh->scene->template get<InstanceArray>(prims[i].instID_);
+          processInstance(prims[i].instID_,prims[i].primID_,instance->getObject(prims[i].primID_),instance->getLocal2World(prims[i].primID_,context->time),inside);
+        }
+      }
+    }
+
+    template<int N>
+    void BVHNFrustumQuery<N>::processInstance(unsigned int geomID, unsigned int primID, Accel* object, const AffineSpace3fa& local2world, bool inside)
+    {
+      if (context->flags & RTC_FRUSTUM_QUERY_FLAG_INSTANCES) {
+        context->add(geomID,primID,inside);
+        return;
+      }
+      if (!object) return;
+
+      const FrustumQueryContext::Planes parent = context->planes;
+      if (!context->push(geomID,primID,local2world)) return;
+      ((Scene*)object)->frustumQuery(context,inside);
+      context->pop(parent);
+    }
+
+    template<int N>
+    void BVHNFrustumQuery<N>::query(AccelData* accel, FrustumQueryContext* context, bool inside)
+    {
+      BVH* bvh = (BVH*) accel;
+      if (bvh->root == BVH::emptyNode) return;
+
+      /* primitives without stored IDs in their leaves are not supported */
+      const PrimitiveType* primTy = bvh->primTy;
+      if (primTy != &Triangle4::type && primTy != &Triangle4v::type && primTy != &Triangle4i::type && primTy != &Triangle4vMB::type &&
+          primTy != &Quad4v::type && primTy != &Quad4i::type && primTy != &Object::type &&
+          primTy != &InstancePrimitive::type && primTy != &InstanceArrayPrimitive::type)
+        return;
+
+      /* the root has no node storing its bounds, thus test the bounds of the BVH */
+      if (!inside)
+      {
+        const BBox3fa bounds = bvh->getBounds(context->time);
+        bool outside = false; inside = true;
+        classifyBounds(context->planes,bounds.lower.x,bounds.lower.y,bounds.lower.z,bounds.upper.x,bounds.upper.y,bounds.upper.z,outside,inside);
+        if (outside) return;
+      }
+
+      BVHNFrustumQuery<N>(bvh,context).query_recurse(bvh->root,inside);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// Frustum Query Definitions
+    ////////////////////////////////////////////////////////////////////////////////
+
+    Accel::FrustumQueryFunc BVH4FrustumQuery() {
+      return BVHNFrustumQuery<4>::query;
+    }
+
+#if defined(__AVX__)
+    Accel::FrustumQueryFunc BVH8FrustumQuery() {
+      return BVHNFrustumQuery<8>::query;
+    }
+#endif
+  }
+}
@@ -0,0 +1,35 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "bvh.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /* reports the primitives of a BVH whose leaf bounds are not outside a frustum, descending into instances */
+    template<int N>
+      class BVHNFrustumQuery
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
+
+    public:
+      __forceinline BVHNFrustumQuery (BVH* bvh, FrustumQueryContext* context)
+        : bvh(bvh), context(context) {}
+
+      void query_recurse(NodeRef node, bool inside);
+      void processLeaf(NodeRef leaf, bool inside);
+      void processInstance(unsigned int geomID, unsigned int primID, Accel* object, const AffineSpace3fa& local2world, bool inside);
+
+    public:
+      static void query(AccelData* accel, FrustumQueryContext* context, bool inside);
+
+    private:
+      BVH* bvh;
+      FrustumQueryContext* context;
+    };
+  }
+}
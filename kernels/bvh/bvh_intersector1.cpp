@@ -113,6 +113,144 @@ namespace embree
       }
     }
 
+    template<int N, int types, bool robust, typename PrimitiveIntersector1>
+    void BVHNIntersector1<N, types, robust, PrimitiveIntersector1>::intersectM(const Accel::Intersectors* __restrict__ This,
+                                                                               RayHit* __restrict__ rays, size_t M,
+                                                                               RayQueryContext* __restrict__ context)
+    {
+      const BVH* __restrict__ bvh = (const BVH*)This->ptr;
+
+      /* we may traverse an empty BVH in case all geometry was invalid */
+      if (bvh->root == BVH::emptyNode)
+        return;
+
+      /* traversal state of a single ray, the traversal of a ray gets suspended after
+       * each step to give the prefetch of its next node time to complete */
+      struct TraversalState
+      {
+        __forceinline TraversalState (RayHit& ray, const BVH* bvh)
+          : ray(ray), pre(ray,bvh), tray(ray.org, ray.dir, max(ray.tnear(), 0.0f), max(ray.tfar, 0.0f)),
+            stackPtr(stack), cur(bvh->root), popNext(false) {}
+
+        /* performs one traversal step, returns false once the traversal of the ray is finished */
+        __forceinline bool step(const Accel::Intersectors* This, RayQueryContext* context)
+        {
+          /* pop next node that is not too far and prefetch it */
+          if (popNext)
+          {
+            do {
+              if (unlikely(stackPtr == stack)) return false;
+              stackPtr--;
+            } while (unlikely(*(float*)&stackPtr->dist > ray.tfar));
+
+            cur = NodeRef(stackPtr->ptr);
+            BVH::prefetch(cur,types);
+            popNext = false;
+            return true;
+          }
+
+          /* intersect node, the traverser prefetches the child to continue with */
+          size_t mask; vfloat<N> tNear;
+          STAT3(normal.trav_nodes,1,1,1);
+          const bool nodeIntersected = BVHNNodeIntersector1<N, types, robust>::intersect(cur, tray, ray.time(), tNear, mask);
+          if (likely(nodeIntersected))
+          {
+            if (unlikely(mask == 0)) popNext = true;
+            else nodeTraverser.traverseClosestHit(cur, mask, tNear, stackPtr, stack+stackSize);
+            return true;
+          }
+          STAT3(normal.trav_nodes,-1,-1,-1);
+
+          /* this is a leaf node */
+          assert(cur != BVH::emptyNode);
+          STAT3(normal.trav_leaves,1,1,1);
+          size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
+          size_t lazy_node = 0;
+          PrimitiveIntersector1::intersect(This, pre, ray, context, prim, num, tray, lazy_node);
+          tray.tfar = ray.tfar;
+
+          /* push lazy node onto stack */
+          if (unlikely(lazy_node)) {
+            stackPtr->ptr = lazy_node;
+            stackPtr->dist = neg_inf;
+            stackPtr++;
+          }
+          popNext = true;
+          return true;
+        }
+
+        RayHit& ray;
+        Precalculations pre;
+        TravRay<N,robust> tray;
+        BVHNNodeTraverser1Hit<N, types> nodeTraverser;
+        StackItemT<NodeRef> stack[stackSize];
+        StackItemT<NodeRef>* stackPtr;
+        NodeRef cur;
+        bool popNext;
+      };
+
+      /* round robin traversal of multiple rays, finished rays get replaced by the next ones */
+      __aligned(64) char storage[numInterleavedRays*sizeof(TraversalState)];
+      TraversalState* states = (TraversalState*) storage;
+      bool active[numInterleavedRays];
+      for (size_t i=0; i<numInterleavedRays; i++)
+        active[i] = false;
+
+      size_t next = 0;
+      while (true)
+      {
+        size_t numActive = 0;
+        for (size_t i=0; i<numInterleavedRays; i++)
+        {
+          /* start traversal of next ray */
+          while (!active[i] && next < M)
+          {
+            RayHit& ray = rays[next++];
+
+            /* filter out invalid rays */
+#if defined(EMBREE_IGNORE_INVALID_RAYS)
+            if (!ray.valid()) continue;
+#endif
+            /* verify correct input */
+            assert(ray.valid());
+            assert(ray.tnear() >= 0.0f);
+            assert(!(types & BVH_MB) || (ray.time() >= 0.0f && ray.time() <= 1.0f));
+
+            new (&states[i]) TraversalState(ray,bvh);
+            active[i] = true;
+          }
+          if (!active[i]) continue;
+
+          numActive++;
+          if (unlikely(!states[i].step(This,context))) {
+            states[i].~TraversalState();
+            active[i] = false;
+          }
+        }
+        if (numActive == 0) break;
+      }
+    }
+
+    /* per thread cache of the leaves that most recently occluded a shadow ray, entries are
+     * tagged with the build ID of their BVH to never access leaves of an outdated build */
+    struct OccluderCache
+    {
+      static const size_t size = 4;
+
+      __forceinline void insert(size_t buildID, size_t leaf)
+      {
+        buildIDs[next] = buildID;
+        leaves[next] = leaf;
+        next = (next+1) % size;
+      }
+
+      size_t buildIDs[size];
+      size_t leaves[size];
+      size_t next;
+    };
+
+    static __thread OccluderCache occluderCache;
+
     template<int N, int types, bool robust, typename PrimitiveIntersector1>
     void BVHNIntersector1<N, types, robust, PrimitiveIntersector1>::occluded(const Accel::Intersectors* __restrict__ This,
                                                                              Ray& __restrict__ ray,
@@ -150,6 +288,22 @@ namespace embree
       /* load the ray into SIMD registers */
       TravRay<N,robust> tray(ray.org, ray.dir, max(ray.tnear(), 0.0f), max(ray.tfar, 0.0f));
 
+      /* test the leaves that recently occluded other rays before traversing the BVH */
+      const bool useOccluderCache = context->useOccluderCache();
+      if (unlikely(useOccluderCache))
+      {
+        for (size_t i=0; i<OccluderCache::size; i++)
+        {
+          if (occluderCache.buildIDs[i] != bvh->buildID) continue;
+          size_t num; Primitive* prim = (Primitive*)NodeRef(occluderCache.leaves[i]).leaf(num);
+          size_t lazy_node = 0;
+          if (PrimitiveIntersector1::occluded(This, pre, ray, context, prim, num, tray, lazy_node)) {
+            ray.tfar = neg_inf;
+            return;
+          }
+        }
+      }
+
       /* initialize the node traverser */
       BVHNNodeTraverser1Hit<N, types> nodeTraverser;
 
@@ -184,6 +338,7 @@ namespace embree
         size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
         size_t lazy_node = 0;
         if (PrimitiveIntersector1::occluded(This, pre, ray, context, prim, num, tray, lazy_node)) {
+          if (unlikely(useOccluderCache)) occluderCache.insert(bvh->buildID,cur);
           ray.tfar = neg_inf;
           break;
         }
@@ -24,9 +24,11 @@ namespace embree
       typedef typename BVH::AABBNodeMB4D AABBNodeMB4D;
 
       static const size_t stackSize = 1+(N-1)*BVH::maxDepth+3; // +3 due to 16-wide store
+      static const size_t numInterleavedRays = 32/N; // number of rays intersectM traverses at once
 
     public:
       static void intersect (const Accel::Intersectors* This, RayHit& ray, RayQueryContext* context);
+      static void intersectM(const Accel::Intersectors* This, RayHit* rays, size_t M, RayQueryContext* context);
       static void occluded  (const Accel::Intersectors* This, Ray& ray, RayQueryContext* context);
       static bool pointQuery(const Accel::Intersectors* This, PointQuery* query, PointQueryContext* context);
     };
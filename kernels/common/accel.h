@@ -65,6 +65,15 @@ namespace embree
     /*! Type of collide function */
     typedef void (*CollideFunc)(void* bvh0, void* bvh1, RTCCollideFunc callback, void* userPtr);
 
+    /*! Type of self collide function */
+    typedef void (*CollideSelfFunc)(void* bvh, RTCCollideFlags flags, RTCCollideFunc callback, void* userPtr);
+
+    /*! Type of continuous collide function */
+    typedef void (*CollideContinuousFunc)(void* bvh0, void* bvh1, const BBox1f& time_range, RTCCollideContinuousFunc callback, void* userPtr);
+
+    /*! Type of frustum query function */
+    typedef void (*FrustumQueryFunc)(AccelData* accel, FrustumQueryContext* context, bool inside);
+
     /*! Type of point query function */
     typedef bool(*PointQueryFunc)(Intersectors* This,          /*!< this pointer to accel */
                                   PointQuery* query,        /*!< point query for lookup */
@@ -75,6 +84,12 @@ namespace embree
                                   RTCRayHit& ray,      /*!< ray to intersect */
                                   RayQueryContext* context);
     
+    /*! Type of intersect function pointer for arrays of single rays. */
+    typedef void (*IntersectMFunc)(Intersectors* This,  /*!< this pointer to accel */
+                                   RTCRayHit* rays,     /*!< array of rays to intersect */
+                                   size_t M,            /*!< number of rays */
+                                   RayQueryContext* context);
+
     /*! Type of intersect function pointer for ray packets of size 4. */
     typedef void (*IntersectFunc4)(const void* valid,  /*!< pointer to valid mask */
                                    Intersectors* This, /*!< this pointer to accel */
@@ -121,28 +136,33 @@ namespace embree
     struct Collider
     {
       Collider (ErrorFunc error = nullptr) 
-      : collide((CollideFunc)error), name(nullptr) {}
+      : collide((CollideFunc)error), collideSelf((CollideSelfFunc)error), collideContinuous((CollideContinuousFunc)error), name(nullptr) {}
 
-      Collider (CollideFunc collide, const char* name)
-      : collide(collide), name(name) {}
+      Collider (CollideFunc collide, CollideSelfFunc collideSelf, CollideContinuousFunc collideContinuous, const char* name)
+      : collide(collide), collideSelf(collideSelf), collideContinuous(collideContinuous), name(name) {}
 
       operator bool() const { return name; }
 
     public:
       CollideFunc collide;  
+      CollideSelfFunc collideSelf;
+      CollideContinuousFunc collideContinuous;
       const char* name;
     };
     
     struct Intersector1
     {
       Intersector1 (ErrorFunc error = nullptr)
-      : intersect((IntersectFunc)error), occluded((OccludedFunc)error), name(nullptr) {}
+      : intersect((IntersectFunc)error), occluded((OccludedFunc)error), intersectM(nullptr), name(nullptr) {}
       
       Intersector1 (IntersectFunc intersect, OccludedFunc occluded, const char* name)
-      : intersect(intersect), occluded(occluded), pointQuery(nullptr), name(name) {}
+      : intersect(intersect), occluded(occluded), pointQuery(nullptr), intersectM(nullptr), name(name) {}
       
       Intersector1 (IntersectFunc intersect, OccludedFunc occluded, PointQueryFunc pointQuery, const char* name)
-      : intersect(intersect), occluded(occluded), pointQuery(pointQuery), name(name) {}
+      : intersect(intersect), occluded(occluded), pointQuery(pointQuery), intersectM(nullptr), name(name) {}
+
+      Intersector1 (IntersectFunc intersect, OccludedFunc occluded, PointQueryFunc pointQuery, IntersectMFunc intersectM, const char* name)
+      : intersect(intersect), occluded(occluded), pointQuery(pointQuery), intersectM(intersectM), name(name) {}
 
       operator bool() const { return name; }
 
@@ -151,6 +171,7 @@ namespace embree
       IntersectFunc intersect;
       OccludedFunc occluded;
       PointQueryFunc pointQuery;
+      IntersectMFunc intersectM;
       const char* name;
     };
     
@@ -239,6 +260,10 @@ namespace embree
 
       void select(bool filter)
       {
+        if (intersector1_filter) {
+          if (filter) intersector1 = intersector1_filter;
+          else        intersector1 = intersector1_nofilter;
+        }
         if (intersector4_filter) {
           if (filter) intersector4 = intersector4_filter;
           else        intersector4 = intersector4_nofilter;
@@ -264,10 +289,44 @@ namespace embree
         collider.collide(scene0->intersectors.ptr,scene1->intersectors.ptr,callback,userPtr);
       }
 
+      /*! collides a scene with itself */
+      __forceinline void collideSelf (Accel* scene, RTCCollideFlags flags, RTCCollideFunc callback, void* userPtr) {
+        assert(collider.collideSelf);
+        collider.collideSelf(scene->intersectors.ptr,flags,callback,userPtr);
+      }
+
+      /*! collides two scenes over a time range */
+      __forceinline void collideContinuous (Accel* scene0, Accel* scene1, const BBox1f& time_range, RTCCollideContinuousFunc callback, void* userPtr) {
+        assert(collider.collideContinuous);
+        collider.collideContinuous(scene0->intersectors.ptr,scene1->intersectors.ptr,time_range,callback,userPtr);
+      }
+
+      /*! Selects the single ray intersector for a query, filter functions are compiled out if the feature mask disables them. */
+      __forceinline const Intersector1& selectIntersector1 (RayQueryContext* context) const
+      {
+        if (likely(!intersector1_filter)) return intersector1;
+        if (unlikely(context->hitList)) return intersector1_filter; // multi-hit queries are implemented in the filter stage
+        if (!(context->args->feature_mask & RTC_FEATURE_FLAG_FILTER_FUNCTION)) return intersector1_nofilter;
+        return intersector1;
+      }
+
       /*! Intersects a single ray with the scene. */
       __forceinline void intersect (RTCRayHit& ray, RayQueryContext* context) {
-        assert(intersector1.intersect);
-        intersector1.intersect(this,ray,context);
+        const Intersector1& intersector = selectIntersector1(context);
+        assert(intersector.intersect);
+        intersector.intersect(this,ray,context);
+      }
+
+      /*! Intersects an array of single rays with the scene, rays may get traversed interleaved. */
+      __forceinline void intersectM (RTCRayHit* rays, size_t M, RayQueryContext* context)
+      {
+        const Intersector1& intersector = selectIntersector1(context);
+        if (likely(intersector.intersectM)) {
+          intersector.intersectM(this,rays,M,context);
+          return;
+        }
+        for (size_t i=0; i<M; i++)
+          intersect(rays[i],context);
       }
 
       /*! Intersects a packet of 4 rays with the scene. */
@@ -327,8 +386,9 @@ namespace embree
       
       /*! Tests if single ray is occluded by the scene. */
       __forceinline void occluded (RTCRay& ray, RayQueryContext* context) {
-        assert(intersector1.occluded);
-        intersector1.occluded(this,ray,context);
+        const Intersector1& intersector = selectIntersector1(context);
+        assert(intersector.occluded);
+        intersector.occluded(this,ray,context);
       }
       
       /*! Tests if a packet of 4 rays is occluded by the scene. */
@@ -403,6 +463,8 @@ namespace embree
       void* leafIntersector;
       Collider collider;
       Intersector1 intersector1;
+      Intersector1 intersector1_filter;
+      Intersector1 intersector1_nofilter;
       Intersector4 intersector4;
       Intersector4 intersector4_filter;
       Intersector4 intersector4_nofilter;
@@ -440,6 +502,16 @@ namespace embree
 #define DEFINE_COLLIDER(symbol,collider)                                \
   Accel::Collider symbol() {                                            \
     return Accel::Collider((Accel::CollideFunc)collider::collide,       \
+                           (Accel::CollideSelfFunc)collider::collideSelf, \
+                           (Accel::CollideContinuousFunc)collider::collideContinuous, \
+                           TOSTRING(isa) "::" TOSTRING(symbol));        \
+  }
+
+#define DEFINE_CONTINUOUS_COLLIDER(symbol,collider)                     \
+  Accel::Collider symbol() {                                            \
+    return Accel::Collider(nullptr,                                     \
+                           nullptr,                                     \
+                           (Accel::CollideContinuousFunc)collider::collideContinuous, \
                            TOSTRING(isa) "::" TOSTRING(symbol));        \
   }
 
@@ -448,6 +520,7 @@ namespace embree
     return Accel::Intersector1((Accel::IntersectFunc )intersector::intersect, \
                                (Accel::OccludedFunc  )intersector::occluded,  \
                                (Accel::PointQueryFunc)intersector::pointQuery,\
+                               (Accel::IntersectMFunc)intersector::intersectM,\
                                TOSTRING(isa) "::" TOSTRING(symbol));          \
   }
   
@@ -49,6 +49,14 @@ namespace embree
         This->accels[i]->intersectors.intersect(ray,context);
   }
 
+  void AccelN::intersectM (Accel::Intersectors* This_in, RTCRayHit* rays, size_t M, RayQueryContext* context) 
+  {
+    AccelN* This = (AccelN*)This_in->ptr;
+    for (size_t i=0; i<This->accels.size(); i++)
+      if (!This->accels[i]->isEmpty())
+        This->accels[i]->intersectors.intersectM(rays,M,context);
+  }
+
   void AccelN::intersect4 (const void* valid, Accel::Intersectors* This_in, RTCRayHit4& ray, RayQueryContext* context) 
   {
     AccelN* This = (AccelN*)This_in->ptr;
@@ -180,7 +188,7 @@ namespace embree
     {
       type = AccelData::TY_ACCELN;
       intersectors.ptr = this;
-      intersectors.intersector1  = Intersector1(&intersect,&occluded,&pointQuery,valid1 ? "AccelN::intersector1": nullptr);
+      intersectors.intersector1  = Intersector1(&intersect,&occluded,&pointQuery,&intersectM,valid1 ? "AccelN::intersector1": nullptr);
       intersectors.intersector4  = Intersector4(&intersect4,&occluded4,valid4 ? "AccelN::intersector4" : nullptr);
       intersectors.intersector8  = Intersector8(&intersect8,&occluded8,valid8 ? "AccelN::intersector8" : nullptr);
       intersectors.intersector16 = Intersector16(&intersect16,&occluded16,valid16 ? "AccelN::intersector16": nullptr);
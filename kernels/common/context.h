@@ -10,6 +10,7 @@
 namespace embree
 {
   class Scene;
+  class Geometry;
 
   struct RayQueryContext
   {
@@ -22,7 +23,14 @@ namespace embree
       : scene(scene), user(user_context), args((RTCIntersectArguments*)args) {}
 
     __forceinline bool hasContextFilter() const {
-      return args->filter != nullptr;
+      return args->filter != nullptr || hitList != nullptr;
+    }
+
+    /* returns the ray distance to continue traversal with after a hit got rejected */
+    __forceinline float rejectedHitTfar(float old_t) const
+    {
+      if (likely(hitList == nullptr) || hitList->hitCount < hitList->maxHitCount) return old_t;
+      return min(old_t,hitList->tfar[hitList->maxHitCount-1]);
     }
 
     RTCFilterFunctionN getFilter() const {
@@ -49,6 +57,10 @@ namespace embree
       return args->flags & RTC_RAY_QUERY_FLAG_INVOKE_ARGUMENT_FILTER;
     }
 
+    __forceinline bool useOccluderCache() const {
+      return args->flags & RTC_RAY_QUERY_FLAG_OCCLUDER_CACHE;
+    }
+
 #if RTC_MIN_WIDTH
     __forceinline float getMinWidthDistanceFactor() const {
       return args->minWidthDistanceFactor;
@@ -59,6 +71,7 @@ namespace embree
     Scene* scene = nullptr;
     RTCRayQueryContext* user = nullptr;
     RTCIntersectArguments* args = nullptr;
+    RTCHitList* hitList = nullptr; //!< collects the closest hits of multi-hit queries
   };
 
   template<int M, typename Geometry>
@@ -99,6 +112,26 @@ namespace embree
 
   typedef bool (*PointQueryFunction)(struct RTCPointQueryFunctionArguments* args);
 
+  /* state of a box query, gathers the primitives overlapping the query box into the user provided buffer */
+  struct BoxQueryContext
+  {
+    __forceinline BoxQueryContext(const BBox3fa& box, float time, RTCBoxQueryPrimitive* primitives, unsigned int capacity, RTCBoxQueryFunction func, void* userPtr)
+      : box(box), time(time), primitives(primitives), capacity(capacity), num(0), func(func), userPtr(userPtr), terminated(false) {}
+
+    /* adds the primitive if its bounds overlap the query box, returns true if the query got terminated */
+    bool add(const Geometry* geom, unsigned int geomID, unsigned int primID);
+
+  public:
+    BBox3fa box;
+    float time;
+    RTCBoxQueryPrimitive* primitives;
+    unsigned int capacity;
+    unsigned int num;           // number of primitives in the buffer that got not passed to func yet
+    RTCBoxQueryFunction func;
+    void* userPtr;
+    bool terminated;
+  };
+
   struct PointQueryContext
   {
   public:
@@ -125,6 +158,14 @@ namespace embree
     }
 
   public:
+    /* adds a primitive to a box query, a terminated box query culls all remaining nodes */
+    __forceinline bool addBoxQueryPrimitive(const Geometry* geom, unsigned int geomID, unsigned int primID)
+    {
+      if (!boxQuery->add(geom,geomID,primID)) return false;
+      query_radius = Vec3fa(neg_inf);
+      return true;
+    }
+
     __forceinline void update()
     {
       if (query_type == POINT_QUERY_TYPE_AABB) {
@@ -168,6 +209,107 @@ public:
     unsigned int geomID;
 
     Vec3fa query_radius;  // used if the query is converted to an AABB internally
+
+    RTCClosestPointResult* closestPoint = nullptr; // set for built-in closest point queries
+    BoxQueryContext* boxQuery = nullptr;           // set for box queries
+  };
+
+  struct FrustumQueryContext
+  {
+    static const size_t maxPrimitives = 256;
+
+    /* frustum planes (normal,offset) in the space of the currently traversed instance level */
+    struct Planes
+    {
+      Vec3fa normal[6];
+      float offset[6];
+    };
+
+    __forceinline FrustumQueryContext(const RTCFrustumQuery& query, RTCFrustumQueryFunction func, void* userPtr)
+      : time(query.time), flags(query.flags), instStackSize(0), func(func), userPtr(userPtr), num(0)
+    {
+      for (size_t i=0; i<6; i++) {
+        planes.normal[i] = Vec3fa(query.planes[i][0],query.planes[i][1],query.planes[i][2]);
+        planes.offset[i] = query.planes[i][3];
+      }
+      for (size_t l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++) {
+        instID[l] = RTC_INVALID_GEOMETRY_ID;
+#if defined(RTC_GEOMETRY_INSTANCE_ARRAY)
+        instPrimID[l] = RTC_INVALID_GEOMETRY_ID;
+#endif
+      }
+    }
+
+    __forceinline ~FrustumQueryContext() {
+      flush();
+    }
+
+    /* reports a primitive of the currently traversed instance level */
+    __forceinline void add(unsigned int geomID, unsigned int primID, bool inside)
+    {
+      RTCFrustumQueryPrimitive& prim = primitives[num++];
+      prim.geomID = geomID;
+      prim.primID = primID;
+      for (size_t l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++) {
+        prim.instID[l] = instID[l];
+#if defined(RTC_GEOMETRY_INSTANCE_ARRAY)
+        prim.instPrimID[l] = instPrimID[l];
+#endif
+      }
+      prim.inside = inside;
+      if (unlikely(num == maxPrimitives)) flush();
+    }
+
+    __forceinline void flush()
+    {
+      if (num == 0) return;
+      func(userPtr,primitives,(unsigned int)num);
+      num = 0;
+    }
+
+    /* enters an instance by transforming the planes into its local space, returns false if the maximal instance level got reached */
+    __forceinline bool push(unsigned int geomID, unsigned int primID, const AffineSpace3fa& local2world)
+    {
+      if (instStackSize >= RTC_MAX_INSTANCE_LEVEL_COUNT) return false;
+      instID[instStackSize] = geomID;
+#if defined(RTC_GEOMETRY_INSTANCE_ARRAY)
+      instPrimID[instStackSize] = primID;
+#endif
+      instStackSize++;
+
+      /* n.(A*p+t)+d = (A^T*n).p + (n.t+d) */
+      for (size_t i=0; i<6; i++) {
+        const Vec3fa n = planes.normal[i];
+        planes.normal[i] = Vec3fa(dot(local2world.l.vx,n),dot(local2world.l.vy,n),dot(local2world.l.vz,n));
+        planes.offset[i] += dot(n,local2world.p);
+      }
+      return true;
+    }
+
+    __forceinline void pop(const Planes& parent)
+    {
+      assert(instStackSize > 0);
+      instStackSize--;
+      instID[instStackSize] = RTC_INVALID_GEOMETRY_ID;
+#if defined(RTC_GEOMETRY_INSTANCE_ARRAY)
+      instPrimID[instStackSize] = RTC_INVALID_GEOMETRY_ID;
+#endif
+      planes = parent;
+    }
+
+  public:
+    Planes planes;
+    float time;
+    RTCFrustumQueryFlags flags;
+    unsigned int instStackSize;
+    unsigned int instID[RTC_MAX_INSTANCE_LEVEL_COUNT];
+#if defined(RTC_GEOMETRY_INSTANCE_ARRAY)
+    unsigned int instPrimID[RTC_MAX_INSTANCE_LEVEL_COUNT];
+#endif
+    RTCFrustumQueryFunction func;
+    void* userPtr;
+    size_t num;
+    RTCFrustumQueryPrimitive primitives[maxPrimitives];
   };
 }
 
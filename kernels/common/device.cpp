@@ -356,6 +356,29 @@ namespace embree
 #endif
   }
 
+  void Device::adaptCacheSize()
+  {
+#if defined(EMBREE_GEOMETRY_SUBDIVISION)
+    if (!checkTessellationCacheThrashing())
+      return;
+
+    Lock<MutexSys> lock(g_mutex);
+    std::map<Device*,size_t>::iterator i = g_cache_size_map.find(this);
+    if (i == g_cache_size_map.end()) return;
+
+    /* double the cache size until the maximal cache size is reached */
+    const size_t bytes = min(2*(*i).second, State::tessellation_cache_max_size);
+    if (bytes <= (*i).second) return;
+    (*i).second = bytes;
+
+    if (State::verbosity(2))
+      std::cout << "growing tessellation cache to " << float(bytes)*1E-6 << " MB" << std::endl;
+    
+    size_t maxCacheSize = getMaxCacheSize();
+    resizeTessellationCache(maxCacheSize);
+#endif
+  }
+
   void Device::initTaskingSystem(size_t numThreads) 
   {
     Lock<MutexSys> lock(g_mutex);
@@ -570,6 +593,20 @@ namespace embree
     case RTC_DEVICE_PROPERTY_PARALLEL_COMMIT_SUPPORTED: return 0;
 #endif
 
+#if defined(EMBREE_GEOMETRY_SUBDIVISION)
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE:       return SharedLazyTessellationCache::sharedLazyTessellationCache.getSize();
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_USED_BYTES: return SharedLazyTessellationCache::sharedLazyTessellationCache.getNumUsedBytes();
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS:       return SharedLazyTessellationCache::sharedLazyTessellationCache.getNumHits();
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MISSES:     return SharedLazyTessellationCache::sharedLazyTessellationCache.getNumMisses();
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_FLUSHES:    return SharedLazyTessellationCache::sharedLazyTessellationCache.getNumFlushes();
+#else
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE:       return 0;
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_USED_BYTES: return 0;
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS:       return 0;
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MISSES:     return 0;
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_FLUSHES:    return 0;
+#endif
+
     default: throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "unknown readable property"); break;
     };
   }
@@ -95,6 +95,9 @@ namespace embree
     /*! sets the size of the software cache. */
     void setCacheSize(size_t bytes);
 
+    /*! grows the software cache if it thrashed since the last invocation */
+    void adaptCacheSize();
+
     /*! sets a property */
     void setProperty(const RTCDeviceProperty prop, ssize_t val);
 
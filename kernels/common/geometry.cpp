@@ -52,6 +52,8 @@ namespace embree
       state((unsigned)State::MODIFIED),
       enabled(true),
       argumentFilterEnabled(false),
+      opacityMicromapEnabled(false),
+      backfaceCullingEnabled(false),
       intersectionFilterN(nullptr), occlusionFilterN(nullptr), pointQueryFunc(nullptr)
   {
     device->refInc();
@@ -238,6 +240,9 @@ namespace embree
   {
     assert(context->primID < size());
 
+    if (unlikely(context->boxQuery))
+      return context->addBoxQueryPrimitive(this,context->geomID,context->primID);
+
     RTCPointQueryFunctionArguments args;
     args.query           = (RTCPointQuery*)context->query_ws;
     args.userPtr         = context->userPtr;
@@ -262,4 +267,45 @@ namespace embree
     }
     return update;
   }
+
+  /* bounds of a primitive at some time, the primitive is assumed to move linearly between time steps */
+  template<typename Mesh>
+  __forceinline BBox3fa primBounds(const Mesh* mesh, size_t primID, float time)
+  {
+    if (mesh->numTimeSteps == 1) return mesh->bounds(primID,0);
+    float ftime; const int itime = mesh->timeSegment(time,ftime);
+    return lerp(mesh->bounds(primID,itime),mesh->bounds(primID,itime+1),ftime);
+  }
+
+  bool BoxQueryContext::add(const Geometry* geom, unsigned int geomID, unsigned int primID)
+  {
+    if (terminated) return true;
+
+    /* geometries without primitive bounds get reported if the BVH leaf overlaps the query box */
+    BBox3fa bounds(box);
+    float ftime; const int itime = geom->timeSegment(time,ftime);
+    switch (geom->getType()) {
+    case Geometry::GTY_TRIANGLE_MESH     : bounds = primBounds((const TriangleMesh*) geom,primID,time); break;
+    case Geometry::GTY_QUAD_MESH         : bounds = primBounds((const QuadMesh*) geom,primID,time); break;
+    case Geometry::GTY_USER_GEOMETRY     : bounds = primBounds((const AccelSet*) geom,primID,time); break;
+    case Geometry::GTY_INSTANCE_CHEAP    :
+    case Geometry::GTY_INSTANCE_EXPENSIVE: bounds = geom->numTimeSteps == 1 ? ((const Instance*) geom)->bounds(0) : ((const Instance*) geom)->bounds(itime,itime+1,ftime); break;
+    case Geometry::GTY_INSTANCE_ARRAY    : bounds = geom->numTimeSteps == 1 ? ((const InstanceArray*) geom)->bounds(primID) : ((const InstanceArray*) geom)->bounds(primID,itime,itime+1,ftime); break;
+    default: break;
+    }
+    if (disjoint(bounds,box)) return false;
+
+    if (num == capacity)
+    {
+      if (!func || !func(userPtr,primitives,num)) {
+        terminated = true;
+        return true;
+      }
+      num = 0;
+    }
+    primitives[num].geomID = geomID;
+    primitives[num].primID = primID;
+    num++;
+    return false;
+  }
 }
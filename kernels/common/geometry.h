@@ -30,7 +30,8 @@ namespace embree
         numInstanceArrays(0), numMBInstanceArrays(0),
         numGrids(0), numMBGrids(0),
         numSubGrids(0), numMBSubGrids(0), 
-        numPoints(0), numMBPoints(0) {}
+        numPoints(0), numMBPoints(0),
+        mask(0) {}
 
     __forceinline size_t size() const {
       return    numTriangles + numQuads + numBezierCurves + numLineSegments + numSubdivPatches + numUserGeometries + numInstancesCheap + numInstancesExpensive + numInstanceArrays + numGrids + numPoints
@@ -94,6 +95,7 @@ namespace embree
       ret.numMBSubGrids = numMBSubGrids + rhs.numMBSubGrids;
       ret.numPoints = numPoints + rhs.numPoints;
       ret.numMBPoints = numMBPoints + rhs.numMBPoints;
+      ret.mask = mask | rhs.mask;
 
       return ret;
     }
@@ -123,6 +125,7 @@ namespace embree
     size_t numMBSubGrids;            //!< number of enabled motion blurred grid geometries
     size_t numPoints;                //!< number of enabled points
     size_t numMBPoints;              //!< number of enabled motion blurred points
+    unsigned int mask;               //!< union of the ray masks of all enabled geometries
   };
 
   /*! Base class all geometries are derived from */
@@ -385,6 +388,16 @@ namespace embree
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
     }
 
+    /*! sets the tolerance for tessellating curves into round linear segments */
+    virtual void setTessellationTolerance(float tolerance) {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
+
+    /*! sets reference points and target edge length for view dependent tessellation */
+    virtual void setViewDependentTessellation(const Vec3fa* points, unsigned int numPoints, float edgeLength) {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
+
     /*! Sets the maximal curve radius scale allowed by min-width feature. */
     virtual void setMaxRadiusScale(float s) {
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
@@ -424,6 +437,16 @@ namespace embree
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
     }
 
+    /*! Set tiled height texture for displacement. */
+    virtual void setDisplacementTexture (const float* texels, unsigned int width, unsigned int height, float scale) {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
+
+    /*! Sets the opacity micromap subdivision level and callback function. */
+    virtual void setOpacityMicromap (unsigned int level, RTCOpacityFunction opacity) {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
+
     virtual unsigned int getFirstHalfEdge(unsigned int faceID) {
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
     }
@@ -484,6 +507,11 @@ namespace embree
       argumentFilterEnabled = enable;
     }
 
+    /*! Enables or disables backface culling for the triangles or quads of the geometry. */
+    virtual void enableBackfaceCulling (bool enable) {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry");
+    }
+
     /*! for instances only */
   public:
 
@@ -497,6 +525,11 @@ namespace embree
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry");
     }
 
+    /*! Sets the level of detail distances of the instances */
+    virtual void setInstanceLOD(const float* distances, unsigned int numDistances, float transitionWidth) {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry");
+    }
+
     /*! Sets transformation of the instance */
     virtual void setTransform(const AffineSpace3fa& transform, unsigned int timeStep) {
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
@@ -599,7 +632,11 @@ namespace embree
     }
 
     virtual Vec3fa computeDirection(unsigned int primID, size_t time) const {
-      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"computeDirection not implemented for this geometry"); 
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"computeDirection not implemented for this geometry");
+    }
+
+    virtual unsigned int computePresplitLevel(unsigned int primID) const {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"computePresplitLevel not implemented for this geometry");
     }
 
     virtual BBox3fa vbounds(size_t primID) const {
@@ -633,6 +670,8 @@ namespace embree
   public:
     __forceinline bool hasIntersectionFilter() const { return intersectionFilterN != nullptr; }
     __forceinline bool hasOcclusionFilter() const { return occlusionFilterN != nullptr; }
+    __forceinline bool hasOpacityMicromap() const { return opacityMicromapEnabled; }
+    __forceinline bool hasBackfaceCulling() const { return backfaceCullingEnabled; }
 
   public:
     Device* device;             //!< device this geometry belongs to
@@ -654,6 +693,8 @@ namespace embree
       unsigned state : 2;
       bool enabled : 1;               //!< true if geometry is enabled
       bool argumentFilterEnabled : 1; //!< true if argument filter functions are enabled for this geometry
+      bool opacityMicromapEnabled : 1; //!< true if an opacity micromap got built for this geometry
+      bool backfaceCullingEnabled : 1; //!< true if hits on the back side of the geometry get ignored
     };
        
     RTCFilterFunctionN intersectionFilterN;
@@ -373,13 +373,52 @@ RTC_NAMESPACE_BEGIN;
     if (scene0->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (scene1->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (scene0->device != scene1->device) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scenes are from different devices");
-    auto nUserPrims0 = scene0->getNumPrimitives (Geometry::MTY_USER_GEOMETRY, false);
-    auto nUserPrims1 = scene1->getNumPrimitives (Geometry::MTY_USER_GEOMETRY, false);
-    if (scene0->numPrimitives() != nUserPrims0 && scene1->numPrimitives() != nUserPrims1) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scenes must only contain user geometries with a single timestep");
 #endif
+    if (!scene0->intersectors.collider.collide || !scene1->intersectors.collider.collide)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scenes must only contain user geometries, triangle meshes, or quad meshes with a single timestep");
+    if (scene0->intersectors.collider.collide != scene1->intersectors.collider.collide)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scenes must contain the same type of geometries");
     scene0->intersectors.collide(scene0,scene1,callback,userPtr);
     RTC_CATCH_END(scene0->device);
   }
+
+  RTC_API void rtcCollideSelf (RTCScene hscene, RTCCollideFlags flags, RTCCollideFunc callback, void* userPtr)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcCollideSelf);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+#endif
+    if (!scene->intersectors.collider.collideSelf)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene must only contain user geometries, triangle meshes, or quad meshes with a single timestep");
+    scene->intersectors.collideSelf(scene,flags,callback,userPtr);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcCollideContinuous (RTCScene hscene0, RTCScene hscene1, float time0, float time1, RTCCollideContinuousFunc callback, void* userPtr)
+  {
+    Scene* scene0 = (Scene*) hscene0;
+    Scene* scene1 = (Scene*) hscene1;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcCollideContinuous);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene0);
+    RTC_VERIFY_HANDLE(hscene1);
+    if (scene0->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (scene1->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (scene0->device != scene1->device) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scenes are from different devices");
+#endif
+    if (!(0.0f <= time0 && time0 <= time1 && time1 <= 1.0f))
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid time range");
+    if (!scene0->intersectors.collider.collideContinuous || !scene1->intersectors.collider.collideContinuous)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scenes must only contain user geometries, triangle meshes, or quad meshes, either all with or all without motion blur");
+    if (scene0->intersectors.collider.collideContinuous != scene1->intersectors.collider.collideContinuous)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scenes must use the same BVH type");
+    scene0->intersectors.collideContinuous(scene0,scene1,BBox1f(time0,time1),callback,userPtr);
+    RTC_CATCH_END(scene0->device);
+  }
   
   inline bool pointQuery(Scene* scene, RTCPointQuery* query, RTCPointQueryContext* userContext, RTCPointQueryFunction queryFunc, void* userPtr)
   {
@@ -512,6 +551,161 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2_FALSE(scene);
   }
 
+  inline bool closestPoint(Scene* scene, RTCPointQuery* query, RTCClosestPointResult* result)
+  {
+    RTCPointQueryContext userContext;
+    rtcInitPointQueryContext(&userContext);
+
+    result->primID = RTC_INVALID_GEOMETRY_ID;
+    result->geomID = RTC_INVALID_GEOMETRY_ID;
+    for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; ++l) {
+      result->instID[l] = RTC_INVALID_GEOMETRY_ID;
+#if defined(RTC_GEOMETRY_INSTANCE_ARRAY)
+      result->instPrimID[l] = RTC_INVALID_GEOMETRY_ID;
+#endif
+    }
+
+    PointQueryContext context(scene, (PointQuery*)query, 
+      POINT_QUERY_TYPE_SPHERE, nullptr, &userContext, 1.f, nullptr);
+    context.closestPoint = result;
+    return scene->intersectors.pointQuery((PointQuery*)query, &context);
+  }
+
+  RTC_API bool rtcClosestPoint(RTCScene hscene, RTCPointQuery* query, RTCClosestPointResult* result)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcClosestPoint);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_HANDLE(result);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");   
+#endif
+
+    return closestPoint(scene, query, result);
+    RTC_CATCH_END2_FALSE(scene);
+  }
+
+  template<int K>
+  inline bool closestPointK(const int* valid, Scene* scene, PointQueryK<K>* queryK, RTCClosestPointResult* results)
+  {
+    STAT(size_t cnt=0; for (size_t i=0; i<K; i++) cnt += ((int*)valid)[i] == -1;);
+    STAT3(point_query.travs,cnt,cnt,cnt);
+
+    bool changed = false;
+    PointQuery query1;
+    for (size_t i=0; i<K; i++) {
+      if (!valid[i]) continue;
+      queryK->get(i,query1);
+      changed |= closestPoint(scene, (RTCPointQuery*)&query1, &results[i]);
+      queryK->set(i,query1);
+    }
+    return changed;
+  }
+
+  RTC_API bool rtcClosestPoint4 (const int* valid, RTCScene hscene, RTCPointQuery4* query, RTCClosestPointResult* results)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcClosestPoint4);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_HANDLE(results);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)valid) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 16 bytes");   
+    if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");   
+#endif
+
+    return closestPointK<4>(valid, scene, (PointQuery4*)query, results);
+    RTC_CATCH_END2_FALSE(scene);
+  }
+
+  RTC_API bool rtcClosestPoint8 (const int* valid, RTCScene hscene, RTCPointQuery8* query, RTCClosestPointResult* results)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcClosestPoint8);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_HANDLE(results);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)valid) & 0x1F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 32 bytes");   
+    if (((size_t)query) & 0x1F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 32 bytes");   
+#endif
+
+    return closestPointK<8>(valid, scene, (PointQuery8*)query, results);
+    RTC_CATCH_END2_FALSE(scene);
+  }
+
+  RTC_API bool rtcClosestPoint16 (const int* valid, RTCScene hscene, RTCPointQuery16* query, RTCClosestPointResult* results)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcClosestPoint16);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_HANDLE(results);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)valid) & 0x3F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 64 bytes");   
+    if (((size_t)query) & 0x3F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 64 bytes");   
+#endif
+
+    return closestPointK<16>(valid, scene, (PointQuery16*)query, results);
+    RTC_CATCH_END2_FALSE(scene);
+  }
+
+  RTC_API unsigned int rtcBoxQuery(RTCScene hscene, const RTCBoxQuery* query, RTCBoxQueryPrimitive* primitives, unsigned int capacity, RTCBoxQueryFunction func, void* userPtr)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcBoxQuery);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_HANDLE(query);
+    if (capacity > 0 && primitives == nullptr) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"no output buffer specified");
+#if defined(DEBUG)
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");
+#endif
+
+    const BBox3fa box(Vec3fa(query->lower_x,query->lower_y,query->lower_z),
+                      Vec3fa(query->upper_x,query->upper_y,query->upper_z));
+    if (box.empty()) return 0;
+
+    /* the box query is a point query at the box center that uses the AABB node tests with the box half extents */
+    RTCPointQueryContext userContext;
+    rtcInitPointQueryContext(&userContext);
+    PointQuery pquery(box.center(),inf,query->time);
+    PointQueryContext context(scene, &pquery, POINT_QUERY_TYPE_SPHERE, nullptr, &userContext, 1.f, nullptr);
+    context.query_type = POINT_QUERY_TYPE_AABB;
+    context.query_radius = 0.5f*box.size();
+
+    BoxQueryContext boxQuery(box,query->time,primitives,capacity,func,userPtr);
+    context.boxQuery = &boxQuery;
+    scene->intersectors.pointQuery(&pquery, &context);
+    return boxQuery.num;
+    RTC_CATCH_END2(scene);
+    return 0;
+  }
+
+  RTC_API void rtcFrustumQuery(RTCScene hscene, const RTCFrustumQuery* query, RTCFrustumQueryFunction func, void* userPtr)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcFrustumQuery);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_HANDLE(query);
+    if (func == nullptr) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"no callback function specified");
+#if defined(DEBUG)
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");
+#endif
+
+    FrustumQueryContext context(*query,func,userPtr);
+    scene->frustumQuery(&context);
+    RTC_CATCH_END2(scene);
+  }
+
   RTC_API void rtcIntersect1 (RTCScene hscene, RTCRayHit* rayhit, RTCIntersectArguments* args) 
   {
     Scene* scene = (Scene*) hscene;
@@ -545,6 +739,78 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(scene);
   }
 
+  RTC_API void rtcIntersect1M (RTCScene hscene, RTCRayHit* rayhits, unsigned int M, RTCIntersectArguments* args) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcIntersect1M);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (((size_t)rayhits) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 16 bytes");   
+#endif
+    STAT3(normal.travs,M,M,M);
+
+    RTCIntersectArguments defaultArgs;
+    if (unlikely(args == nullptr)) {
+      rtcInitIntersectArguments(&defaultArgs);
+      args = &defaultArgs;
+    }
+    RTCRayQueryContext* user_context = args->context;
+    
+    RTCRayQueryContext defaultContext;
+    if (unlikely(user_context == nullptr)) {
+      rtcInitRayQueryContext(&defaultContext);
+      user_context = &defaultContext;
+    }
+    RayQueryContext context(scene,user_context,args);
+    
+    scene->intersectors.intersectM(rayhits,M,&context);
+#if defined(DEBUG)
+    for (size_t i=0; i<M; i++)
+      ((RayHit*)&rayhits[i])->verifyHit();
+#endif
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcIntersectMultiHit1 (RTCScene hscene, const RTCRay* ray, RTCHitList* hits, RTCIntersectArguments* args) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcIntersectMultiHit1);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+#endif
+    if (hits == nullptr) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid hit list");
+    if (hits->maxHitCount && (hits->tfar == nullptr || hits->hits == nullptr)) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid hit list");
+    STAT3(normal.travs,1,1,1);
+
+    RTCIntersectArguments defaultArgs;
+    if (unlikely(args == nullptr)) {
+      rtcInitIntersectArguments(&defaultArgs);
+      args = &defaultArgs;
+    }
+    RTCRayQueryContext* user_context = args->context;
+    
+    RTCRayQueryContext defaultContext;
+    if (unlikely(user_context == nullptr)) {
+      rtcInitRayQueryContext(&defaultContext);
+      user_context = &defaultContext;
+    }
+    RayQueryContext context(scene,user_context,args);
+    hits->hitCount = 0;
+    if (hits->maxHitCount == 0) return;
+    context.hitList = hits;
+
+    /* all hits get recorded in the hit list and rejected, thus the ray only tracks the traversal distance */
+    RTCRayHit rayhit;
+    rayhit.ray = *ray;
+    rayhit.hit.geomID = RTC_INVALID_GEOMETRY_ID;
+    scene->intersectors.intersect(rayhit,&context);
+    RTC_CATCH_END2(scene);
+  }
+
   RTC_API void rtcForwardIntersect1 (const RTCIntersectFunctionNArguments* args, RTCScene hscene, RTCRay* iray_, unsigned int instID)
   {
     rtcForwardIntersect1Ex(args, hscene, iray_, instID, 0);
@@ -1173,6 +1439,19 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcSetGeometryInstanceLOD(RTCGeometry hgeometry, const float* distances, unsigned int numDistances, float transitionWidth)
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryInstanceLOD);
+    RTC_VERIFY_HANDLE(hgeometry);
+    if (numDistances && distances == nullptr) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid distances");
+    if (!(transitionWidth >= 0.0f)) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid transition width");
+    RTC_ENTER_DEVICE(hgeometry);
+    geometry->setInstanceLOD(distances, numDistances, transitionWidth);
+    RTC_CATCH_END2(geometry);
+  }
+
   AffineSpace3fa loadTransform(RTCFormat format, const float* xfm)
   {
     AffineSpace3fa space = one;
@@ -1735,6 +2014,34 @@ RTC_API void rtcSetGeometryTransform(RTCGeometry hgeometry, unsigned int timeSte
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcSetGeometryTessellationTolerance (RTCGeometry hgeometry, float tolerance)
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryTessellationTolerance);
+    RTC_VERIFY_HANDLE(hgeometry);
+    RTC_ENTER_DEVICE(hgeometry);
+    if (!(tolerance >= 0.0f)) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"tessellation tolerance has to be positive or zero");
+    geometry->setTessellationTolerance(tolerance);
+    RTC_CATCH_END2(geometry);
+  }
+
+  RTC_API void rtcSetGeometryViewDependentTessellation (RTCGeometry hgeometry, const float* points, unsigned int numPoints, float edgeLength)
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryViewDependentTessellation);
+    RTC_VERIFY_HANDLE(hgeometry);
+    RTC_ENTER_DEVICE(hgeometry);
+    if (numPoints && points == nullptr) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid reference points");
+    if (numPoints && !(edgeLength > 0.0f)) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"edge length has to be positive");
+    std::vector<Vec3fa> vpoints(numPoints);
+    for (unsigned int i=0; i<numPoints; i++)
+      vpoints[i] = Vec3fa(points[3*i+0],points[3*i+1],points[3*i+2]);
+    geometry->setViewDependentTessellation(vpoints.data(),numPoints,edgeLength);
+    RTC_CATCH_END2(geometry);
+  }
+
   RTC_API void rtcSetGeometryUserData (RTCGeometry hgeometry, void* ptr) 
   {
     Geometry* geometry = (Geometry*) hgeometry;
@@ -1795,6 +2102,29 @@ RTC_API void rtcSetGeometryTransform(RTCGeometry hgeometry, unsigned int timeSte
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcSetGeometryDisplacementTexture (RTCGeometry hgeometry, const float* texels, unsigned int width, unsigned int height, float scale)
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryDisplacementTexture);
+    RTC_VERIFY_HANDLE(hgeometry);
+    RTC_ENTER_DEVICE(hgeometry);
+    if (texels && (width == 0 || height == 0)) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid texture size");
+    geometry->setDisplacementTexture(texels,width,height,scale);
+    RTC_CATCH_END2(geometry);
+  }
+
+  RTC_API void rtcSetGeometryOpacityMicromap (RTCGeometry hgeometry, unsigned int subdivisionLevel, RTCOpacityFunction opacity)
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryOpacityMicromap);
+    RTC_VERIFY_HANDLE(hgeometry);
+    RTC_ENTER_DEVICE(hgeometry);
+    geometry->setOpacityMicromap(subdivisionLevel,opacity);
+    RTC_CATCH_END2(geometry);
+  }
+
   RTC_API void rtcSetGeometryIntersectFunction (RTCGeometry hgeometry, RTCIntersectFunctionN intersect) 
   {
     Geometry* geometry = (Geometry*) hgeometry;
@@ -1916,6 +2246,17 @@ RTC_API void rtcSetGeometryTransform(RTCGeometry hgeometry, unsigned int timeSte
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcSetGeometryEnableBackfaceCulling (RTCGeometry hgeometry, bool enable) 
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryEnableBackfaceCulling);
+    RTC_VERIFY_HANDLE(hgeometry);
+    RTC_ENTER_DEVICE(hgeometry);
+    geometry->enableBackfaceCulling(enable);
+    RTC_CATCH_END2(geometry);
+  }
+
   RTC_API void rtcInterpolate(const RTCInterpolateArguments* const args)
   {
     Geometry* geometry = (Geometry*) args->geometry;
@@ -394,6 +394,9 @@ namespace embree
 #if defined (EMBREE_TARGET_SIMD8)
     else if (device->hair_accel == "bvh8obb.virtualcurve8v" ) accels_add(device->bvh8_factory->BVH8OBBVirtualCurve8v(this,BVHFactory::IntersectVariant::FAST));
     else if (device->hair_accel == "bvh4obb.virtualcurve8i" ) accels_add(device->bvh4_factory->BVH4OBBVirtualCurve8i(this,BVHFactory::IntersectVariant::FAST));
+#endif
+#if defined (EMBREE_TARGET_SIMD16)
+    else if (device->hair_accel == "bvh8obb.virtualcurve16i") accels_add(device->bvh8_factory->BVH8OBBVirtualCurve16i(this,BVHFactory::IntersectVariant::FAST));
 #endif
     else throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"unknown hair acceleration structure "+device->hair_accel);
 #endif
@@ -796,6 +799,9 @@ namespace embree
 
   void Scene::commit_task ()
   {
+    /* grow the tessellation cache if it thrashed since the last commit */
+    device->adaptCacheSize();
+
     checkIfModifiedAndSet();
     if (!isModified()) return;
     
@@ -818,6 +824,8 @@ namespace embree
             geometries[i]->addElementsToCount (c);
             c.numFilterFunctions += (int) geometries[i]->hasArgumentFilterFunctions();
             c.numFilterFunctions += (int) geometries[i]->hasGeometryFilterFunctions();
+            c.numFilterFunctions += (int) geometries[i]->hasOpacityMicromap();
+            c.mask |= geometries[i]->mask;
           }
         }
         return c;
@@ -1014,6 +1022,20 @@ namespace embree
   }
 #endif
 
+  void Scene::frustumQuery(FrustumQueryContext* context, bool inside)
+  {
+    for (size_t i=0; i<accels.size(); i++)
+    {
+      AccelData* accel = accels[i]->intersectors.ptr;
+      if (accel->type == AccelData::TY_BVH4)
+        device->bvh4_factory->BVH4FrustumQuery()(accel,context,inside);
+#if defined(EMBREE_TARGET_SIMD8)
+      else if (accel->type == AccelData::TY_BVH8)
+        device->bvh8_factory->BVH8FrustumQuery()(accel,context,inside);
+#endif
+    }
+  }
+
   void Scene::setProgressMonitorFunction(RTCProgressMonitorFunction func, void* ptr) 
   {
     progress_monitor_function = func;
@@ -192,6 +192,9 @@ namespace embree
     void commit_task ();
     void build () {}
 
+    /* reports the primitives of the scene that are not outside the frustum of the query context, inside marks the scene as completely inside */
+    void frustumQuery(FrustumQueryContext* context, bool inside = false);
+
     /* return number of geometries */
     __forceinline size_t size() const { return geometries.size(); }
     
@@ -327,6 +330,11 @@ namespace embree
       return world.size();
     }
 
+    /* returns the union of the ray masks of all enabled geometries */
+    __forceinline unsigned int getGeometryMask() const {
+      return world.mask;
+    }
+
     __forceinline size_t getNumPrimitives(Geometry::GTypeMask mask, bool mblur) const
     {
       size_t count = 0;
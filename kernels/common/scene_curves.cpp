@@ -247,6 +247,10 @@ namespace embree
     tessellationRate = clamp((int)N,1,16);
   }
 
+  void CurveGeometry::setTessellationTolerance(float tolerance) {
+    tessellationTolerance = tolerance;
+  }
+
   void CurveGeometry::setMaxRadiusScale(float s) {
     maxRadiusScale = s;
   }
@@ -367,6 +371,12 @@ namespace embree
     if (getCurveBasis() == GTY_BASIS_HERMITE)
       tangents0 = tangents[0];
 
+    /* for high build quality or tessellation the builder splits static round curve segments into sub-segments */
+    const bool splittable = getCurveType() == GTY_SUBTYPE_ROUND_CURVE && getCurveBasis() != GTY_BASIS_HERMITE &&
+      numTimeSteps == 1 && size() < (1u << PRESPLIT_SHIFT);
+    tessellated = splittable && tessellationTolerance > 0.0f;
+    presplits = splittable && (quality == RTC_BUILD_QUALITY_HIGH || tessellated);
+
     Geometry::commit();
   }
 
@@ -379,6 +389,65 @@ namespace embree
       const float size = reduce_max(max(abs(bounds.lower),abs(bounds.upper)));
       return enlarge(bounds,Vec3fa(4.0f*float(ulp)*size));
     }   
+
+    /*! returns the parameter range u of a curve as bezier curve */
+    template<typename NativeCurve3ff>
+    __forceinline BezierCurveT<Vec3ff> subCurve(const NativeCurve3ff& curve, const BBox1f& u)
+    {
+      Vec3ff p0,dp0; curve.eval(u.lower,p0,dp0);
+      Vec3ff p3,dp3; curve.eval(u.upper,p3,dp3);
+      const float s = (u.upper-u.lower)*(1.0f/3.0f);
+      return BezierCurveT<Vec3ff>(p0,p0+s*dp0,p3-s*dp3,p3);
+    }
+
+    /*! calculates the bounds of the parameter range u of a round curve */
+    template<typename NativeCurve3ff>
+    __forceinline BBox3fa accurateRoundBounds(const NativeCurve3ff& curve, const BBox1f& u)
+    {
+      if (u.lower == 0.0f && u.upper == 1.0f) return curve.accurateRoundBounds();
+      return subCurve(curve,u).accurateRoundBounds();
+    }
+
+    /*! calculates the bounds of the round linear segment approximating the parameter range u of a curve */
+    template<typename NativeCurve3ff>
+    __forceinline BBox3fa roundLinearBounds(const NativeCurve3ff& curve, const BBox1f& u)
+    {
+      const Vec3ff p0 = curve.eval(u.lower);
+      const Vec3ff p1 = curve.eval(u.upper);
+      BBox3fa bounds(Vec3fa(p0)-Vec3fa(abs(p0.w)),Vec3fa(p0)+Vec3fa(abs(p0.w)));
+      bounds.extend(BBox3fa(Vec3fa(p1)-Vec3fa(abs(p1.w)),Vec3fa(p1)+Vec3fa(abs(p1.w))));
+      return bounds;
+    }
+
+    /*! calculates a space aligned to the direction of a curve */
+    template<typename Curve3ff>
+    __forceinline LinearSpace3fa alignedSpace(const Curve3ff& curve)
+    {
+      Vec3fa axisz(0,0,1);
+      Vec3fa axisy(0,1,0);
+
+      const Vec3fa p0 = curve.begin();
+      const Vec3fa p3 = curve.end();
+      const Vec3fa d0 = curve.eval_du(0.0f);
+      const Vec3fa axisz_ = normalize(p3 - p0);
+      const Vec3fa axisy_ = cross(axisz_,d0);
+      if (sqr_length(p3-p0) > 1E-18f) {
+        axisz = axisz_;
+        axisy = axisy_;
+      }
+
+      if (sqr_length(axisy) > 1E-18) {
+        axisy = normalize(axisy);
+        Vec3fa axisx = normalize(cross(axisy,axisz));
+        return LinearSpace3fa(axisx,axisy,axisz);
+      }
+      return frame(axisz);
+    }
+
+    /*! calculates the surface area of the bounds of a round curve in its aligned space */
+    __forceinline float alignedRoundArea(const BezierCurveT<Vec3ff>& curve) {
+      return halfArea(curve.xfm_pr(alignedSpace(curve).transposed(),Vec3fa(zero)).accurateRoundBounds());
+    }
     
     template<Geometry::GType ctype, template<template<typename Ty> class Curve> class CurveInterfaceT, template<typename Ty> class Curve>
       struct CurveGeometryISA : public CurveInterfaceT<Curve>
@@ -408,27 +477,11 @@ namespace embree
 
       LinearSpace3fa computeAlignedSpace(const size_t primID) const
       {
-        Vec3fa axisz(0,0,1);
-        Vec3fa axisy(0,1,0);
-        
-        const Curve3ff curve = getCurveScaledRadius(primID);
-        const Vec3fa p0 = curve.begin();
-        const Vec3fa p3 = curve.end();
-        const Vec3fa d0 = curve.eval_du(0.0f);
-        //const Vec3fa d1 = curve.eval_du(1.0f);
-        const Vec3fa axisz_ = normalize(p3 - p0);
-        const Vec3fa axisy_ = cross(axisz_,d0);
-        if (sqr_length(p3-p0) > 1E-18f) {
-          axisz = axisz_;
-          axisy = axisy_;
+        if (unlikely(this->hasPresplits())) {
+          const Curve3ff curve = getCurveScaledRadius(CurveGeometry::presplitPrimID(unsigned(primID)));
+          return alignedSpace(subCurve(curve,CurveGeometry::presplitRange(unsigned(primID))));
         }
-        
-        if (sqr_length(axisy) > 1E-18) {
-          axisy = normalize(axisy);
-          Vec3fa axisx = normalize(cross(axisy,axisz));
-          return LinearSpace3fa(axisx,axisy,axisz);
-        }
-        return frame(axisz);
+        return alignedSpace(getCurveScaledRadius(primID));
       }
 
       LinearSpace3fa computeAlignedSpaceMB(const size_t primID, const BBox1f time_range) const
@@ -462,6 +515,12 @@ namespace embree
       
       Vec3fa computeDirection(unsigned int primID) const
       {
+        if (unlikely(this->hasPresplits())) {
+          const Curve3ff c = getCurveScaledRadius(CurveGeometry::presplitPrimID(primID));
+          const BBox1f u = CurveGeometry::presplitRange(primID);
+          return Vec3fa(c.eval(u.upper)) - Vec3fa(c.eval(u.lower));
+        }
+        
         const Curve3ff c = getCurveScaledRadius(primID);
         const Vec3fa p0 = c.begin();
         const Vec3fa p3 = c.end();
@@ -572,15 +631,67 @@ namespace embree
         return pinfo;
       }
      
-      BBox3fa vbounds(size_t i) const {
+      /*! determines how often the i'th curve segment gets halved, which continues as long as this reduces the summed surface area of the aligned bounds of the sub-segments by at least a quarter */
+      unsigned int computePresplitLevel(unsigned int primID) const
+      {
+        const Curve3ff curve = getCurveScaledRadius(primID);
+
+        /* tessellated curves use enough round linear segments to stay within the tolerance, as the distance
+         * of n linear segments to a cubic bezier curve is bounded by 3/4*max(|p0-2*p1+p2|,|p1-2*p2+p3|)/n^2 */
+        if (this->isTessellated())
+        {
+          const BezierCurveT<Vec3ff> bezier = subCurve(curve,BBox1f(0.0f,1.0f));
+          const Vec3ff d0 = bezier.v0-2.0f*bezier.v1+bezier.v2;
+          const Vec3ff d1 = bezier.v1-2.0f*bezier.v2+bezier.v3;
+          const float d = 0.75f*sqrt(max(sqr_length(Vec3fa(d0))+sqr(d0.w),sqr_length(Vec3fa(d1))+sqr(d1.w)));
+          unsigned int level = 0;
+          while (level < CurveGeometry::MAX_PRESPLIT_LEVEL && d > this->tessellationTolerance*float(1u << (2*level)))
+            level++;
+          return level;
+        }
+        float parentArea = alignedRoundArea(subCurve(curve,BBox1f(0.0f,1.0f)));
+        
+        unsigned int level = 0;
+        for (; level<CurveGeometry::MAX_PRESPLIT_LEVEL; level++)
+        {
+          const unsigned int N = 2u << level;
+          float childArea = 0.0f;
+          for (unsigned int j=0; j<N; j++)
+            childArea += alignedRoundArea(subCurve(curve,BBox1f(float(j+0)/float(N),float(j+1)/float(N))));
+          
+          if (!(childArea < 0.75f*parentArea)) break;
+          parentArea = childArea;
+        }
+        return level;
+      }
+      
+      BBox3fa vbounds(size_t i) const
+      {
+        if (unlikely(this->hasPresplits())) {
+          const Curve3ff curve = getCurveScaledRadius(CurveGeometry::presplitPrimID(unsigned(i)));
+          if (this->isTessellated()) return enlarge_bounds(roundLinearBounds(curve,CurveGeometry::presplitRange(unsigned(i))));
+          return enlarge_bounds(accurateRoundBounds(curve,CurveGeometry::presplitRange(unsigned(i))));
+        }
         return bounds(i);
       }
       
-      BBox3fa vbounds(const LinearSpace3fa& space, size_t i) const {
+      BBox3fa vbounds(const LinearSpace3fa& space, size_t i) const
+      {
+        if (unlikely(this->hasPresplits())) {
+          const Curve3ff curve = getCurveScaledRadius(space,CurveGeometry::presplitPrimID(unsigned(i)));
+          if (this->isTessellated()) return enlarge_bounds(roundLinearBounds(curve,CurveGeometry::presplitRange(unsigned(i))));
+          return enlarge_bounds(accurateRoundBounds(curve,CurveGeometry::presplitRange(unsigned(i))));
+        }
         return bounds(space,i);
       }
 
-      BBox3fa vbounds(const Vec3fa& ofs, const float scale, const float r_scale0, const LinearSpace3fa& space, size_t i, size_t itime = 0) const {
+      BBox3fa vbounds(const Vec3fa& ofs, const float scale, const float r_scale0, const LinearSpace3fa& space, size_t i, size_t itime = 0) const
+      {
+        if (unlikely(this->hasPresplits())) {
+          const Curve3ff curve = getCurveScaledRadius(ofs,scale,r_scale0,space,CurveGeometry::presplitPrimID(unsigned(i)),itime);
+          if (this->isTessellated()) return enlarge_bounds(roundLinearBounds(curve,CurveGeometry::presplitRange(unsigned(i))));
+          return enlarge_bounds(accurateRoundBounds(curve,CurveGeometry::presplitRange(unsigned(i))));
+        }
         return bounds(ofs,scale,r_scale0,space,i,itime);
       }
 
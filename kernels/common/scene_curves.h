@@ -36,6 +36,7 @@ namespace embree
     void commit();
     bool verify();
     void setTessellationRate(float N);
+    void setTessellationTolerance(float tolerance);
     void setMaxRadiusScale(float s);
     void addElementsToCount (GeometryCounts & counts) const;
 
@@ -391,6 +392,37 @@ namespace embree
     __forceinline float projectedPrimitiveArea(const size_t i) const {
       return 1.0f;
     }
+
+    /*! returns true if the sub-segments of the curve segments get intersected as round linear segments */
+    __forceinline bool isTessellated() const {
+      return tessellated;
+    }
+
+    /*! returns true if the builder splits curve segments into sub-segments, encoded in the upper bits of the primitive ID */
+    __forceinline bool hasPresplits() const {
+      return presplits;
+    }
+
+    /*! returns the curve segment of a primitive ID stored in the BVH */
+    __forceinline unsigned int presplitPrimID(unsigned int primID) const {
+      return presplits ? primID & ((1u << PRESPLIT_SHIFT)-1) : primID;
+    }
+
+    /*! returns the parameter range of the sub-segment a primitive ID stored in the BVH refers to */
+    __forceinline BBox1f presplitRange(unsigned int primID) const
+    {
+      if (!presplits) return BBox1f(0.0f,1.0f);
+      const unsigned int code = primID >> PRESPLIT_SHIFT;
+      const float scale = 1.0f/float(1u << (code >> 4));
+      const float index = float(code & 15);
+      return BBox1f(index*scale,(index+1.0f)*scale);
+    }
+
+    /*! encodes the j'th of 2^level sub-segments of a curve segment into a primitive ID */
+    static __forceinline unsigned int encodePresplit(unsigned int primID, unsigned int level, unsigned int j) {
+      assert(level <= MAX_PRESPLIT_LEVEL && j < (1u << level));
+      return primID | (((level << 4) | j) << PRESPLIT_SHIFT);
+    }
   
   private:
     void resizeBuffers(unsigned int numSteps);
@@ -409,6 +441,12 @@ namespace embree
     Device::vector<BufferView<char>> vertexAttribs = device; //!< user buffers
     int tessellationRate;                   //!< tessellation rate for flat curve
     float maxRadiusScale = 1.0;             //!< maximal min-width scaling of curve radii
+    float tessellationTolerance = 0.0f;     //!< maximal distance of round linear segments to the curve, 0 disables tessellation
+    bool presplits = false;                 //!< curve segments get split into sub-segments by the builder
+    bool tessellated = false;               //!< sub-segments get intersected as round linear segments
+
+    static const unsigned int PRESPLIT_SHIFT = 24;   //!< primitive ID bit where the sub-segment encoding starts
+    static const unsigned int MAX_PRESPLIT_LEVEL = 4; //!< curve segments get split into at most 2^4 sub-segments
   };
 
   namespace isa
@@ -34,6 +34,7 @@ namespace embree
       BBox3fa const& bbox0, BBox3fa const& bbox1,
       float t_min, float t_max) const;
 
+  public:
     /* calculates the (correct) interpolated bounds */
     __forceinline BBox3fa bounds(size_t itime0, size_t itime1, float f) const
     {
@@ -4,6 +4,8 @@
 #include "scene_instance_array.h"
 #include "scene.h"
 #include "motion_derivative.h"
+#include "../../common/algorithms/parallel_for.h"
+
 namespace embree
 {
 #if defined(EMBREE_LOWEST_ISA)
@@ -14,6 +16,9 @@ namespace embree
     object = nullptr;
     objects = nullptr;
     numObjects = 0;
+    world2local0 = nullptr;
+    numWorld2Local0 = 0;
+    lodTransitionWidth = 0.0f;
     gsubtype = GTY_SUBTYPE_INSTANCE_LINEAR;
     l2w_buf.resize(numTimeSteps);
     device->memoryMonitor(sizeof(*this), false);
@@ -28,9 +33,19 @@ namespace embree
       }
       device->free(objects);
     }
+    freeWorld2Local();
     device->memoryMonitor(-sizeof(*this), false);
   }
 
+  void InstanceArray::freeWorld2Local()
+  {
+    if (!world2local0) return;
+    device->free(world2local0);
+    device->memoryMonitor(-ssize_t(numWorld2Local0*sizeof(AffineSpace3fa)), true);
+    world2local0 = nullptr;
+    numWorld2Local0 = 0;
+  }
+
   void InstanceArray::setNumTimeSteps (unsigned int numTimeSteps_in)
   {
     if (numTimeSteps_in == numTimeSteps)
@@ -68,6 +83,20 @@ namespace embree
     Geometry::update();
   }
 
+  void InstanceArray::setInstanceLOD(const float* distances, unsigned int numDistances, float transitionWidth)
+  {
+    for (unsigned int i=1; i<numDistances; i++) {
+      if (!(distances[i-1] <= distances[i]))
+        throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "LOD distances have to be sorted in ascending order");
+    }
+
+    lodDistances.resize(numDistances);
+    for (unsigned int i=0; i<numDistances; i++)
+      lodDistances[i] = distances[i];
+    lodTransitionWidth = transitionWidth;
+    Geometry::update();
+  }
+
   void InstanceArray::addElementsToCount (GeometryCounts & counts) const 
   {
     if (1 == numTimeSteps) {
@@ -182,11 +211,28 @@ namespace embree
         throw_RTCError(RTC_ERROR_INVALID_OPERATION, "if scene index buffer is set, it has to have the same size as the transform buffer.");
       }
     }
-    if (!object && objects && this->numPrimitives == 1) {
+    if (!object && objects && this->numPrimitives == 1 && !hasLOD()) {
       object = objects[0];
       if (object) object->refInc();
     }
 
+    /* precompute the inverse transformations, motion blurred instances invert the interpolated transformation during traversal */
+    if (numTimeSteps != 1 || numPrimitives != numWorld2Local0)
+      freeWorld2Local();
+
+    if (numTimeSteps == 1 && numPrimitives > 0)
+    {
+      if (!world2local0) {
+        device->memoryMonitor(numPrimitives*sizeof(AffineSpace3fa), false);
+        world2local0 = (AffineSpace3fa*) device->malloc(numPrimitives*sizeof(AffineSpace3fa),16);
+        numWorld2Local0 = numPrimitives;
+      }
+      parallel_for(size_t(0), size_t(numPrimitives), size_t(4096), [&](const range<size_t>& r) {
+        for (size_t i=r.begin(); i<r.end(); i++)
+          world2local0[i] = rcp(getLocal2World(i));
+      });
+    }
+
     Geometry::commit();
   }
 
@@ -25,6 +25,8 @@ namespace embree
     InstanceArray& operator= (const InstanceArray& other) DELETED; // do not implement
 
   private:
+    void freeWorld2Local();
+
     LBBox3fa nonlinearBounds(size_t i,
                              const BBox1f& time_range_in,
                              const BBox1f& geom_time_range,
@@ -35,6 +37,7 @@ namespace embree
       BBox3fa const& bbox0, BBox3fa const& bbox1,
       float t_min, float t_max) const;
 
+  public:
     /* calculates the (correct) interpolated bounds */
     __forceinline BBox3fa bounds(size_t i, size_t itime0, size_t itime1, float f) const
     {
@@ -54,6 +57,7 @@ namespace embree
     virtual void setNumTimeSteps (unsigned int numTimeSteps) override;
     virtual void setInstancedScene(const Ref<Scene>& scene) override;
     virtual void setInstancedScenes(const RTCScene* scenes, size_t numScenes) override;
+    virtual void setInstanceLOD(const float* distances, unsigned int numDistances, float transitionWidth) override;
     virtual AffineSpace3fa getTransform(size_t, float time) override;
     virtual void setMask (unsigned mask) override;
     virtual void build() {}
@@ -68,16 +72,28 @@ namespace embree
         return BBox3fa();
 
       if (unlikely(gsubtype == GTY_SUBTYPE_INSTANCE_QUATERNION))
-        return xfmBounds(quaternionDecompositionToAffineSpace(l2w(i, 0)),getObject(i)->bounds.bounds());
-      return xfmBounds(l2w(i, 0),getObject(i)->bounds.bounds());
+        return xfmBounds(quaternionDecompositionToAffineSpace(l2w(i, 0)),getObjectBounds(i));
+      return xfmBounds(l2w(i, 0),getObjectBounds(i));
+    }
+
+    /*! gets the bounds of the instanced scene, including all levels of detail */
+    __forceinline BBox3fa getObjectBounds(size_t i) const
+    {
+      BBox3fa b = getObject(i)->getBounds();
+      for (unsigned int level=1; level<=lodDistances.size(); level++)
+        b.extend(getObject(i,level)->getBounds());
+      return b;
     }
 
-    /*! gets the bounds of the instanced scene */
+    /*! gets the bounds of the instanced scene, including all levels of detail */
     __forceinline BBox3fa getObjectBounds(size_t i, size_t itime) const {
       if (!valid(i))
         return BBox3fa();
 
-      return getObject(i)->getBounds(timeStep(itime));
+      BBox3fa b = getObject(i)->getBounds(timeStep(itime));
+      for (unsigned int level=1; level<=lodDistances.size(); level++)
+        b.extend(getObject(i,level)->getBounds(timeStep(itime)));
+      return b;
     }
 
      /*! calculates the bounds of instance */
@@ -166,11 +182,14 @@ namespace embree
     }
 
     __forceinline AffineSpace3fa getWorld2Local(size_t i) const {
+      if (likely(world2local0)) return world2local0[i];
       return rcp(getLocal2World(i));
     }
 
     __forceinline AffineSpace3fa getWorld2Local(size_t i, float t) const {
-      return rcp(getLocal2World(i, t));
+      if (numTimeSegments() > 0)
+        return rcp(getLocal2World(i, t));
+      return getWorld2Local(i);
     }
 
     template<int K>
@@ -199,6 +218,54 @@ namespace embree
       return objects[object_ids[i]];
     }
 
+    /*! returns true if the instances select their scene by distance */
+    __forceinline bool hasLOD() const {
+      return lodDistances.size() != 0;
+    }
+
+    /*! returns the scene of the i'th instance at some level of detail, coarser levels follow the scene of the index buffer in the scene array */
+    inline Accel* getObject(size_t i, unsigned int level) const
+    {
+      if (!objects) return getObject(i);
+      const unsigned int base = object_ids ? object_ids[i] : 0;
+      if (base == (unsigned int)(-1))
+        return nullptr;
+
+      return objects[min(base+level, numObjects-1)];
+    }
+
+    /*! selects the level of detail of the i'th instance by the distance of the ray origin to the instance */
+    __forceinline unsigned int selectLOD(size_t i, const Vec3fa& org, const Vec3fa& dir, float t) const
+    {
+      const Vec3fa center = xfmPoint(getLocal2World(i, t), embree::center(getObject(i)->getBounds()));
+      const float d = distance(org, center);
+      const float halfWidth = 0.5f*lodTransitionWidth;
+
+      unsigned int level = 0;
+      for (; level<lodDistances.size(); level++)
+      {
+        const float d0 = lodDistances[level]-halfWidth;
+        if (d < d0) break;
+
+        /* inside the transition range the coarser level gets selected with a probability growing linearly with the distance */
+        if (d < lodDistances[level]+halfWidth && lodRandom(i, org, dir)*lodTransitionWidth >= d-d0) break;
+      }
+      return level;
+    }
+
+  private:
+
+    /*! hashes the ray to a random number in [0,1), the same ray always selects the same level of detail */
+    static __forceinline float lodRandom(size_t i, const Vec3fa& org, const Vec3fa& dir)
+    {
+      unsigned int h = unsigned(i) * 0x9E3779B9u;
+      const float v[6] = { org.x, org.y, org.z, dir.x, dir.y, dir.z };
+      for (size_t k=0; k<6; k++)
+        h = (h ^ unsigned(cast_f2i(v[k]))) * 0x01000193u;
+      h ^= h >> 16; h *= 0x85EBCA6Bu; h ^= h >> 13;
+      return float(h >> 8) * (1.0f/16777216.0f);
+    }
+
     private:
 
     template<int K>
@@ -308,6 +375,10 @@ namespace embree
     uint32_t numObjects;
     Device::vector<RawBufferView> l2w_buf = device; //!< transformation from local space to world space for each timestep (either normal matrix or quaternion decomposition)
     BufferView<uint32_t> object_ids; //!< array of scene ids per instance array primitive
+    AffineSpace3fa* world2local0;    //!< transformations from world space to local space for timestep 0, precomputed at commit
+    size_t numWorld2Local0;          //!< number of precomputed world to local transformations
+    Device::vector<float> lodDistances = device; //!< distances where the instances switch to the next coarser level of detail
+    float lodTransitionWidth;        //!< width of the distance range around each LOD distance where the levels get selected stochastically
   };
 
   namespace isa
@@ -20,6 +20,12 @@ namespace embree
     Geometry::update();
   }
 
+  void QuadMesh::enableBackfaceCulling (bool enable)
+  {
+    backfaceCullingEnabled = enable;
+    Geometry::update();
+  }
+
   void QuadMesh::setNumTimeSteps (unsigned int numTimeSteps)
   {
     vertices.resize(numTimeSteps);
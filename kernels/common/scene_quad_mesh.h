@@ -39,6 +39,7 @@ namespace embree
     /* geometry interface */
   public:
     void setMask(unsigned mask);
+    void enableBackfaceCulling(bool enable);
     void setNumTimeSteps (unsigned int numTimeSteps);
     void setVertexAttributeCount (unsigned int N);
     void setBuffer(RTCBufferType type, unsigned int slot, RTCFormat format, const Ref<Buffer>& buffer, size_t offset, size_t stride, unsigned int num);
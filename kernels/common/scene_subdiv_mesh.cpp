@@ -11,6 +11,7 @@
 #include "../../common/algorithms/parallel_sort.h"
 #include "../../common/algorithms/parallel_prefix_sum.h"
 #include "../../common/algorithms/parallel_for.h"
+#include "../../common/algorithms/parallel_reduce.h"
 
 /*! maximum number of user vertex buffers for subdivision surfaces */
 #define RTC_MAX_USER_VERTEX_BUFFERS 65536
@@ -32,10 +33,15 @@ namespace embree
   SubdivMesh::SubdivMesh (Device* device)
     : Geometry(device,GTY_SUBDIV_MESH,0,1), 
       displFunc(nullptr),
+      displTextureWidth(0),
+      displTextureHeight(0),
+      displScale(0.0f),
       tessellationRate(2.0f),
+      tessellationEdgeLength(0.0f),
       numHalfEdges(0),
       faceStartEdge(device,0),
       halfEdgeFace(device,0),
+      viewLevels(device,0),
       holeSet(new HoleSet),
       invalid_face(device,0),
       vertexCreaseMap(new VertexCreaseMap),
@@ -370,12 +376,30 @@ namespace embree
     this->displFunc = func;
   }
 
+  void SubdivMesh::setDisplacementTexture (const float* texels, unsigned int width, unsigned int height, float scale)
+  {
+    if (texels) displTexels.assign(texels,texels+size_t(width)*size_t(height));
+    else        displTexels.clear();
+    displTextureWidth = texels ? width : 0;
+    displTextureHeight = texels ? height : 0;
+    displScale = scale;
+    Geometry::update();
+  }
+
   void SubdivMesh::setTessellationRate(float N)
   {
     tessellationRate = N;
     levels.setModified();
   }
 
+  void SubdivMesh::setViewDependentTessellation(const Vec3fa* points, unsigned int numPoints, float edgeLength)
+  {
+    tessellationPoints.assign(points,points+numPoints);
+    tessellationEdgeLength = edgeLength;
+    levels.setModified();
+    Geometry::update();
+  }
+
   __forceinline uint64_t pair64(unsigned int x, unsigned int y) 
   {
     if (x<y) std::swap(x,y);
@@ -417,6 +441,118 @@ namespace embree
     return true;
   }
 
+  void SubdivMesh::Topology::initializeHalfEdges(size_t f, KeyHalfEdge* keys)
+  {
+    const unsigned N = mesh->faceVertices[f];
+    const unsigned e = mesh->faceStartEdge[f];
+    const bool hole = mesh->holeSet->holeSet.lookup(unsigned(f));
+
+    for (unsigned de=0; de<N; de++)
+    {
+      HalfEdge* edge = &halfEdges[e+de];
+      int nextOfs = (de == (N-1)) ? -int(N-1) : +1;
+      int prevOfs = (de ==     0) ? +int(N-1) : -1;
+      
+      const unsigned int startVertex = vertexIndices[e+de];
+      const unsigned int endVertex = vertexIndices[e+de+nextOfs]; 
+      const uint64_t key = SubdivMesh::Edge(startVertex,endVertex);
+
+      /* we always have to use the geometry topology to lookup creases */
+      const unsigned int startVertex0 = mesh->topology[0].vertexIndices[e+de];
+      const unsigned int endVertex0 = mesh->topology[0].vertexIndices[e+de+nextOfs]; 
+      const uint64_t key0 = SubdivMesh::Edge(startVertex0,endVertex0);
+      
+      edge->vtx_index              = startVertex;
+      edge->next_half_edge_ofs     = nextOfs;
+      edge->prev_half_edge_ofs     = prevOfs;
+      edge->opposite_half_edge_ofs = 0;
+      edge->edge_crease_weight     = mesh->edgeCreaseMap->edgeCreaseMap.lookup(key0,0.0f);
+      edge->vertex_crease_weight   = mesh->vertexCreaseMap->vertexCreaseMap.lookup(startVertex0,0.0f);
+      edge->edge_level             = mesh->getEdgeLevel(e+de);
+      edge->patch_type             = HalfEdge::COMPLEX_PATCH; // type gets updated below
+      edge->vertex_type            = HalfEdge::REGULAR_VERTEX;
+
+      if (keys == nullptr) continue;
+      if (unlikely(hole)) 
+        keys[de] = SubdivMesh::KeyHalfEdge(std::numeric_limits<uint64_t>::max(),edge);
+      else
+        keys[de] = SubdivMesh::KeyHalfEdge(key,edge);
+    }
+  }
+
+  void SubdivMesh::Topology::linkHalfEdges(size_t e, size_t N)
+  {
+    /* border edges are identified by not having an opposite edge set */
+    if (N == 1) {
+      halfEdges1[e].edge->edge_crease_weight = float(inf);
+    }
+
+    /* standard edge shared between two faces */
+    else if (N == 2)
+    {
+      /* create edge crease if winding order mismatches between neighboring patches */
+      if (halfEdges1[e+0].edge->next()->vtx_index != halfEdges1[e+1].edge->vtx_index)
+      {
+        halfEdges1[e+0].edge->edge_crease_weight = float(inf);
+        halfEdges1[e+1].edge->edge_crease_weight = float(inf);
+      }
+      /* otherwise mark edges as opposites of each other */
+      else {
+        halfEdges1[e+0].edge->setOpposite(halfEdges1[e+1].edge);
+        halfEdges1[e+1].edge->setOpposite(halfEdges1[e+0].edge);
+      }
+    }
+
+    /* non-manifold geometry is handled by keeping vertices fixed during subdivision */
+    else {
+      for (size_t i=0; i<N; i++) {
+        halfEdges1[e+i].edge->vertex_crease_weight = inf;
+        halfEdges1[e+i].edge->vertex_type = HalfEdge::NON_MANIFOLD_EDGE_VERTEX;
+        halfEdges1[e+i].edge->edge_crease_weight = inf;
+
+        halfEdges1[e+i].edge->next()->vertex_crease_weight = inf;
+        halfEdges1[e+i].edge->next()->vertex_type = HalfEdge::NON_MANIFOLD_EDGE_VERTEX;
+        halfEdges1[e+i].edge->next()->edge_crease_weight = inf;
+      }
+    }
+  }
+
+  void SubdivMesh::Topology::classifyFace(size_t f)
+  {
+    HalfEdge* edge = &halfEdges[mesh->faceStartEdge[f]];
+
+    /* for vertex topology we also test if vertices are valid */
+    if (this == &mesh->topology[0])
+    {
+      /* calculate if face is valid */
+      for (size_t t=0; t<mesh->numTimeSteps; t++)
+        mesh->invalidFace(f,t) = !edge->valid(mesh->vertices[t]) || mesh->holeSet->holeSet.lookup(unsigned(f));
+    }
+
+    /* pin some edges and vertices */
+    for (size_t i=0; i<mesh->faceVertices[f]; i++) 
+    {
+      /* pin corner vertices when requested by user */
+      if (subdiv_mode == RTC_SUBDIVISION_MODE_PIN_CORNERS && edge[i].isCorner())
+        edge[i].vertex_crease_weight = float(inf);
+      
+      /* pin all border vertices when requested by user */
+      else if (subdiv_mode == RTC_SUBDIVISION_MODE_PIN_BOUNDARY && edge[i].vertexHasBorder()) 
+        edge[i].vertex_crease_weight = float(inf);
+
+      /* pin all edges and vertices when requested by user */
+      else if (subdiv_mode == RTC_SUBDIVISION_MODE_PIN_ALL) {
+        edge[i].edge_crease_weight = float(inf);
+        edge[i].vertex_crease_weight = float(inf);
+      }
+    }
+
+    /* we have to calculate patch_type last! */
+    HalfEdge::PatchType patch_type = edge->patchType();
+    for (size_t i=0; i<mesh->faceVertices[f]; i++) 
+      edge[i].patch_type = patch_type;
+  }
+
   void SubdivMesh::Topology::calculateHalfEdges()
   {
     const size_t blockSize = 4096;
@@ -432,41 +568,7 @@ namespace embree
     parallel_for( size_t(0), numFaces, blockSize, [&](const range<size_t>& r) 
     {
       for (size_t f=r.begin(); f<r.end(); f++) 
-      {
-	const unsigned N = mesh->faceVertices[f];
-	const unsigned e = mesh->faceStartEdge[f];
-
-	for (unsigned de=0; de<N; de++)
-	{
-	  HalfEdge* edge = &halfEdges[e+de];
-          int nextOfs = (de == (N-1)) ? -int(N-1) : +1;
-          int prevOfs = (de ==     0) ? +int(N-1) : -1;
-	  
-	  const unsigned int startVertex = vertexIndices[e+de];
-          const unsigned int endVertex = vertexIndices[e+de+nextOfs]; 
-	  const uint64_t key = SubdivMesh::Edge(startVertex,endVertex);
-
-          /* we always have to use the geometry topology to lookup creases */
-          const unsigned int startVertex0 = mesh->topology[0].vertexIndices[e+de];
-          const unsigned int endVertex0 = mesh->topology[0].vertexIndices[e+de+nextOfs]; 
-	  const uint64_t key0 = SubdivMesh::Edge(startVertex0,endVertex0);
-	  
-	  edge->vtx_index              = startVertex;
-	  edge->next_half_edge_ofs     = nextOfs;
-	  edge->prev_half_edge_ofs     = prevOfs;
-	  edge->opposite_half_edge_ofs = 0;
-	  edge->edge_crease_weight     = mesh->edgeCreaseMap->edgeCreaseMap.lookup(key0,0.0f);
-	  edge->vertex_crease_weight   = mesh->vertexCreaseMap->vertexCreaseMap.lookup(startVertex0,0.0f);
-	  edge->edge_level             = mesh->getEdgeLevel(e+de);
-          edge->patch_type             = HalfEdge::COMPLEX_PATCH; // type gets updated below
-          edge->vertex_type            = HalfEdge::REGULAR_VERTEX;
-
-          if (unlikely(mesh->holeSet->holeSet.lookup(unsigned(f)))) 
-	    halfEdges1[e+de] = SubdivMesh::KeyHalfEdge(std::numeric_limits<uint64_t>::max(),edge);
-	  else
-	    halfEdges1[e+de] = SubdivMesh::KeyHalfEdge(key,edge);
-	}
-      }
+        initializeHalfEdges(f,&halfEdges1[mesh->faceStartEdge[f]]);
     });
 
     /* sort half edges to find adjacent edges */
@@ -488,40 +590,7 @@ namespace embree
 	const uint64_t key = halfEdges1[e].key;
 	if (key == std::numeric_limits<uint64_t>::max()) break;
 	size_t N=1; while (e+N<numHalfEdges && halfEdges1[e+N].key == key) N++;
-
-        /* border edges are identified by not having an opposite edge set */
-	if (N == 1) {
-          halfEdges1[e].edge->edge_crease_weight = float(inf);
-	}
-
-        /* standard edge shared between two faces */
-        else if (N == 2)
-        {
-          /* create edge crease if winding order mismatches between neighboring patches */
-          if (halfEdges1[e+0].edge->next()->vtx_index != halfEdges1[e+1].edge->vtx_index)
-          {
-            halfEdges1[e+0].edge->edge_crease_weight = float(inf);
-            halfEdges1[e+1].edge->edge_crease_weight = float(inf);
-          }
-          /* otherwise mark edges as opposites of each other */
-          else {
-            halfEdges1[e+0].edge->setOpposite(halfEdges1[e+1].edge);
-            halfEdges1[e+1].edge->setOpposite(halfEdges1[e+0].edge);
-          }
-	}
-
-        /* non-manifold geometry is handled by keeping vertices fixed during subdivision */
-        else {
-	  for (size_t i=0; i<N; i++) {
-	    halfEdges1[e+i].edge->vertex_crease_weight = inf;
-            halfEdges1[e+i].edge->vertex_type = HalfEdge::NON_MANIFOLD_EDGE_VERTEX;
-            halfEdges1[e+i].edge->edge_crease_weight = inf;
-
-	    halfEdges1[e+i].edge->next()->vertex_crease_weight = inf;
-            halfEdges1[e+i].edge->next()->vertex_type = HalfEdge::NON_MANIFOLD_EDGE_VERTEX;
-            halfEdges1[e+i].edge->next()->edge_crease_weight = inf;
-	  }
-	}
+        linkHalfEdges(e,N);
 	e+=N;
       }
     });
@@ -530,41 +599,189 @@ namespace embree
     parallel_for( size_t(0), numFaces, blockSize, [&](const range<size_t>& r) 
     {
       for (size_t f=r.begin(); f<r.end(); f++) 
-      {
-        HalfEdge* edge = &halfEdges[mesh->faceStartEdge[f]];
+        classifyFace(f);
+    });
+  }
 
-        /* for vertex topology we also test if vertices are valid */
-        if (this == &mesh->topology[0])
-        {
-          /* calculate if face is valid */
-          for (size_t t=0; t<mesh->numTimeSteps; t++)
-            mesh->invalidFace(f,t) = !edge->valid(mesh->vertices[t]) || mesh->holeSet->holeSet.lookup(unsigned(f));
+  bool SubdivMesh::Topology::updateChangedFaces(size_t numOldEdges)
+  {
+    const size_t numEdges = mesh->numEdges();
+    const size_t numFaces = mesh->numFaces();
+    const uint64_t holeKey = std::numeric_limits<uint64_t>::max();
+
+    /* we need the sorted half edges of the last recalculation and the same faces, holes, and creases */
+    if (numOldEdges != numEdges || halfEdges1.size() != numEdges) return false;
+    if (mesh->faceVertices.isLocalModified() || mesh->holes.isLocalModified()) return false;
+    if (mesh->edge_creases.isLocalModified() || mesh->edge_crease_weights.isLocalModified()) return false;
+    if (mesh->vertex_creases.isLocalModified() || mesh->vertex_crease_weights.isLocalModified()) return false;
+    if (this != &mesh->topology[0] && mesh->topology[0].vertexIndices.isLocalModified()) return false;
+
+    /* find faces whose vertex indices differ from the current half edges */
+    enum { CHANGED = 1, DIRTY = 2 };
+    std::vector<unsigned char> faceState(numFaces,0);
+    const size_t numChanged = parallel_reduce(size_t(0), numFaces, size_t(4096), size_t(0), [&](const range<size_t>& r) -> size_t
+    {
+      size_t n = 0;
+      for (size_t f=r.begin(); f<r.end(); f++) 
+      {
+        const unsigned e = mesh->faceStartEdge[f];
+        for (unsigned de=0; de<mesh->faceVertices[f]; de++) {
+          if (halfEdges[e+de].vtx_index != vertexIndices[e+de]) {
+            faceState[f] = CHANGED; n++;
+            break;
+          }
         }
+      }
+      return n;
+    }, std::plus<size_t>());
 
-        /* pin some edges and vertices */
-        for (size_t i=0; i<mesh->faceVertices[f]; i++) 
-        {
-          /* pin corner vertices when requested by user */
-          if (subdiv_mode == RTC_SUBDIVISION_MODE_PIN_CORNERS && edge[i].isCorner())
-            edge[i].vertex_crease_weight = float(inf);
-          
-          /* pin all border vertices when requested by user */
-          else if (subdiv_mode == RTC_SUBDIVISION_MODE_PIN_BOUNDARY && edge[i].vertexHasBorder()) 
-            edge[i].vertex_crease_weight = float(inf);
+    /* recalculating all half edges is faster for large changes */
+    if (16*numChanged > numFaces) return false;
 
-          /* pin all edges and vertices when requested by user */
-          else if (subdiv_mode == RTC_SUBDIVISION_MODE_PIN_ALL) {
-            edge[i].edge_crease_weight = float(inf);
-            edge[i].vertex_crease_weight = float(inf);
+    std::vector<size_t> changedFaces;
+    changedFaces.reserve(numChanged);
+    for (size_t f=0; f<numFaces && changedFaces.size()<numChanged; f++)
+      if (faceState[f] == CHANGED) changedFaces.push_back(f);
+
+    /* faces that have to get their half edges re-initialized, linked and classified */
+    std::vector<size_t> dirtyFaces;
+    auto markFace = [&] (const HalfEdge* edge) 
+    {
+      const size_t f = mesh->halfEdgeFace[edge-halfEdges.data()];
+      if (faceState[f] & DIRTY) return;
+      faceState[f] |= DIRTY;
+      dirtyFaces.push_back(f);
+    };
+
+    /* marks all faces around the start vertex of an edge */
+    auto markRing = [&] (const HalfEdge* edge)
+    {
+      const HalfEdge* p = edge;
+      do {
+        markFace(p);
+        
+        /* if there is no opposite go the other way around the vertex */
+        if (!p->hasOpposite()) {
+          for (p = edge; p->prev()->hasOpposite() && p->prev()->opposite() != edge; ) {
+            p = p->prev()->opposite();
+            markFace(p);
           }
+          return;
         }
+        p = p->rotate();
+      } while (p != edge);
+    };
 
-        /* we have to calculate patch_type last! */
-        HalfEdge::PatchType patch_type = edge->patchType();
-        for (size_t i=0; i<mesh->faceVertices[f]; i++) 
-          edge[i].patch_type = patch_type;
+    /* marks all faces sharing an edge with the specified key */
+    auto markEdges = [&] (uint64_t key)
+    {
+      if (key == holeKey) return;
+      auto edges = std::equal_range(halfEdges1.begin(),halfEdges1.end(),KeyHalfEdge(key,nullptr));
+      for (auto i=edges.first; i!=edges.second; i++)
+        markFace(i->edge);
+    };
+
+    /* collect neighborhood of changed faces before the half edges get modified */
+    std::vector<KeyHalfEdge> oldKeys, newKeys;
+    for (size_t f : changedFaces)
+    {
+      if (mesh->holeSet->holeSet.lookup(unsigned(f))) {
+        markFace(&halfEdges[mesh->faceStartEdge[f]]);
+        continue;
       }
-    });
+      for (unsigned de=0; de<mesh->faceVertices[f]; de++) {
+        HalfEdge* edge = &halfEdges[mesh->faceStartEdge[f]+de];
+        oldKeys.push_back(KeyHalfEdge(edge->getEdge(),edge));
+        markRing(edge);
+        markEdges(oldKeys.back().key);
+      }
+    }
+
+    /* create new half edges of changed faces, the sorted entries of holes are unaffected */
+    for (size_t f : changedFaces)
+    {
+      if (mesh->holeSet->holeSet.lookup(unsigned(f))) {
+        initializeHalfEdges(f,nullptr);
+        continue;
+      }
+      const size_t N = mesh->faceVertices[f];
+      newKeys.resize(newKeys.size()+N);
+      initializeHalfEdges(f,&newKeys[newKeys.size()-N]);
+    }
+
+    /* replace the old entries of the sorted half edges by the new ones, this only moves entries between the first and last modified location */
+    if (oldKeys.size())
+    {
+      std::vector<size_t> removed;
+      for (const KeyHalfEdge& key : oldKeys) {
+        size_t i = std::lower_bound(halfEdges1.begin(),halfEdges1.end(),key) - halfEdges1.begin();
+        while (halfEdges1[i].edge != key.edge) i++;
+        removed.push_back(i);
+      }
+      std::sort(removed.begin(),removed.end());
+      std::sort(newKeys.begin(),newKeys.end());
+
+      const size_t begin = min(removed.front(),size_t(std::lower_bound(halfEdges1.begin(),halfEdges1.end(),newKeys.front())-halfEdges1.begin()));
+      const size_t end   = max(removed.back()+1,size_t(std::upper_bound(halfEdges1.begin(),halfEdges1.end(),newKeys.back())-halfEdges1.begin()));
+
+      std::vector<KeyHalfEdge> kept;
+      kept.reserve(end-begin-removed.size());
+      for (size_t i=begin, j=0; i<end; i++) {
+        if (j < removed.size() && removed[j] == i) j++;
+        else kept.push_back(halfEdges1[i]);
+      }
+      std::merge(kept.begin(),kept.end(),newKeys.begin(),newKeys.end(),halfEdges1.begin()+begin);
+    }
+
+    for (const KeyHalfEdge& key : newKeys)
+      markEdges(key.key);
+
+    /* re-initialize and link the half edges of dirty faces, the links of other faces are unchanged */
+    auto relinkFaces = [&] (size_t begin, size_t end)
+    {
+      for (size_t i=begin; i<end; i++)
+        initializeHalfEdges(dirtyFaces[i],nullptr);
+
+      std::vector<std::pair<size_t,size_t>> groups;
+      for (size_t i=begin; i<end; i++)
+      {
+        const size_t f = dirtyFaces[i];
+        if (mesh->holeSet->holeSet.lookup(unsigned(f))) continue;
+        for (unsigned de=0; de<mesh->faceVertices[f]; de++) {
+          const uint64_t key = halfEdges[mesh->faceStartEdge[f]+de].getEdge();
+          auto edges = std::equal_range(halfEdges1.begin(),halfEdges1.end(),KeyHalfEdge(key,nullptr));
+          groups.push_back(std::make_pair(size_t(edges.first-halfEdges1.begin()),size_t(edges.second-edges.first)));
+        }
+      }
+      std::sort(groups.begin(),groups.end());
+      groups.erase(std::unique(groups.begin(),groups.end()),groups.end());
+      for (auto& group : groups)
+        linkHalfEdges(group.first,group.second);
+    };
+    const size_t numDirtyFaces = dirtyFaces.size();
+    relinkFaces(0,numDirtyFaces);
+
+    /* the patch type of a face depends on the faces around its vertices */
+    for (size_t i=0; i<numDirtyFaces; i++) 
+    {
+      const size_t f = dirtyFaces[i];
+      for (unsigned de=0; de<mesh->faceVertices[f]; de++)
+        markRing(&halfEdges[mesh->faceStartEdge[f]+de]);
+    }
+    relinkFaces(numDirtyFaces,dirtyFaces.size());
+
+    for (size_t f : dirtyFaces)
+      classifyFace(f);
+
+    /* edge levels may have changed for all faces */
+    if (mesh->levels.isLocalModified())
+    {
+      parallel_for( size_t(0), numEdges, size_t(4096), [&](const range<size_t>& r) {
+        for (size_t i=r.begin(); i!=r.end(); i++)
+          halfEdges[i].edge_level = mesh->getEdgeLevel(i);
+      });
+    }
+    return true;
   }
 
   void SubdivMesh::Topology::updateHalfEdges()
@@ -631,6 +848,7 @@ namespace embree
       return;
 
     /* allocate half edge array */
+    const size_t numOldEdges = halfEdges.size();
     halfEdges.resize(mesh->numEdges());
 
     /* check if we have to recalculate the half edges */
@@ -648,8 +866,11 @@ namespace embree
     update |= mesh->vertex_crease_weights.isLocalModified(); 
     update |= mesh->levels.isLocalModified();
 
-    /* now either recalculate or update the half edges */
-    if (recalculate) calculateHalfEdges();
+    /* now either recalculate or update the half edges, small changes of the vertex indices only update the affected faces */
+    if (recalculate) {
+      if (!updateChangedFaces(numOldEdges))
+        calculateHalfEdges();
+    }
     else if (update) updateHalfEdges();
    
     /* cleanup some state for static scenes */
@@ -708,6 +929,13 @@ namespace embree
           halfEdgeFace[h++] = (unsigned int) f;
     }
     
+    /* levels depend on the vertex positions in view dependent mode */
+    if (tessellationPoints.size() && vertices[0].isLocalModified())
+      levels.setModified();
+
+    if (levels.isLocalModified())
+      calculateViewDependentLevels();
+
     /* create set with all vertex creases */
     if (vertex_creases.isLocalModified() || vertex_crease_weights.isLocalModified())
       vertexCreaseMap->vertexCreaseMap.init(vertex_creases,vertex_crease_weights);
@@ -756,6 +984,47 @@ namespace embree
     }
   }
 
+  void SubdivMesh::calculateViewDependentLevels()
+  {
+    if (tessellationPoints.size() == 0) {
+      viewLevels.clear();
+      return;
+    }
+
+    viewLevels.resize(numEdges());
+    const BufferView<unsigned int>& indices = topology[0].vertexIndices;
+    const size_t numVerts = numVertices();
+    const float rcpEdgeLength = rcp(tessellationEdgeLength);
+
+    parallel_for( size_t(0), numFaces(), size_t(1024), [&](const range<size_t>& r) 
+    {
+      for (size_t f=r.begin(); f!=r.end(); f++) 
+      {
+        const size_t e = faceStartEdge[f];
+        const size_t N = faceVertices[f];
+        for (size_t de=0; de<N; de++)
+        {
+          /* invalid indices are detected later when verifying the geometry */
+          const unsigned int i0 = indices[e+de];
+          const unsigned int i1 = indices[e+(de+1)%N];
+          if (i0 >= numVerts || i1 >= numVerts) {
+            viewLevels[e+de] = 1.0f;
+            continue;
+          }
+
+          /* both half edges of an edge get the same level as the calculation is symmetric */
+          const Vec3fa v0 = vertices[0][i0];
+          const Vec3fa v1 = vertices[0][i1];
+          const Vec3fa center = 0.5f*(v0+v1);
+          float dist = inf;
+          for (const Vec3fa& p : tessellationPoints)
+            dist = min(dist,length(center-p));
+          viewLevels[e+de] = length(v1-v0)*rcpEdgeLength*rcp(max(dist,float(ulp)));
+        }
+      }
+    });
+  }
+
   bool SubdivMesh::verify () 
   {
     /*! verify consistent size of vertex arrays */
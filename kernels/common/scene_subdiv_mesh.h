@@ -64,10 +64,12 @@ namespace embree
     void* getBuffer(RTCBufferType type, unsigned int slot);
     void updateBuffer(RTCBufferType type, unsigned int slot);
     void setTessellationRate(float N);
+    void setViewDependentTessellation(const Vec3fa* points, unsigned int numPoints, float edgeLength);
     bool verify();
     void commit();
     void addElementsToCount (GeometryCounts & counts) const;
     void setDisplacementFunction (RTCDisplacementFunctionN func);
+    void setDisplacementTexture (const float* texels, unsigned int width, unsigned int height, float scale);
     unsigned int getFirstHalfEdge(unsigned int faceID);
     unsigned int getFace(unsigned int edgeID);
     unsigned int getNextHalfEdge(unsigned int edgeID);
@@ -111,6 +113,9 @@ namespace embree
 
     /*! initializes the half edge data structure */
     void initializeHalfEdgeStructures ();
+
+    /*! calculates edge levels from the distance to the tessellation reference points */
+    void calculateViewDependentLevels ();
  
   public:
 
@@ -122,13 +127,24 @@ namespace embree
     /* returns tessellation level of edge */
     __forceinline float getEdgeLevel(const size_t i) const
     {
+      if (viewLevels.size()) return clamp(viewLevels[i],1.0f,4096.0f);
       if (levels) return clamp(levels[i],1.0f,4096.0f); // FIXME: do we want to limit edge level?
       else return clamp(tessellationRate,1.0f,4096.0f); // FIXME: do we want to limit edge level?
     }
 
+    /* returns true if the surface gets displaced */
+    __forceinline bool hasDisplacement() const {
+      return displFunc || displTexels.size();
+    }
+
   public:
     RTCDisplacementFunctionN displFunc;    //!< displacement function
 
+    std::vector<float> displTexels;        //!< tiled height texture used for displacement
+    unsigned int displTextureWidth;        //!< width of height texture
+    unsigned int displTextureHeight;       //!< height of height texture
+    float displScale;                      //!< scale applied to height texture
+
     /*! all buffers in this section are provided by the application */
   public:
     
@@ -191,6 +207,18 @@ namespace embree
       
       /*! recalculates the half edges */
       void calculateHalfEdges();
+
+      /*! recalculates the half edges of faces with changed vertex indices and their neighborhood only */
+      bool updateChangedFaces(size_t numOldEdges);
+
+      /*! initializes the half edges of face f and optionally returns their sort keys */
+      void initializeHalfEdges(size_t f, KeyHalfEdge* keys);
+
+      /*! links the N half edges with the same key starting at entry e of the sorted half edges */
+      void linkHalfEdges(size_t e, size_t N);
+
+      /*! pins edges and vertices of face f and calculates its patch type */
+      void classifyFace(size_t f);
       
       /*! updates half edges when recalculation is not necessary */
       void updateHalfEdges();
@@ -259,6 +287,10 @@ namespace embree
     BufferView<float> levels;
     float tessellationRate;  // constant rate that is used when levels is not set
 
+    /*! reference points and target edge length for view dependent tessellation */
+    std::vector<Vec3fa> tessellationPoints;
+    float tessellationEdgeLength;
+
     /*! buffer that marks specific faces as holes */
     BufferView<unsigned> holes;
 
@@ -274,6 +306,9 @@ namespace embree
     /*! fast lookup table to find the face for some half edge */
     mvector<uint32_t> halfEdgeFace;
 
+    /*! view dependent level for each half edge */
+    mvector<float> viewLevels;
+
     /*! set with all holes */
     std::unique_ptr<HoleSet> holeSet;
 
@@ -3,13 +3,15 @@
 
 #include "scene_triangle_mesh.h"
 #include "scene.h"
+#include "../../common/algorithms/parallel_for.h"
 
 namespace embree
 {
 #if defined(EMBREE_LOWEST_ISA)
 
   TriangleMesh::TriangleMesh (Device* device)
-    : Geometry(device,GTY_TRIANGLE_MESH,0,1)
+    : Geometry(device,GTY_TRIANGLE_MESH,0,1),
+      opacityFunc(nullptr), opacityMicromapLevel(0), opacityMicromap(device,0)
   {
     vertices.resize(numTimeSteps);
   }
@@ -20,6 +22,12 @@ namespace embree
     Geometry::update();
   }
 
+  void TriangleMesh::enableBackfaceCulling (bool enable)
+  {
+    backfaceCullingEnabled = enable;
+    Geometry::update();
+  }
+
   void TriangleMesh::setNumTimeSteps (unsigned int numTimeSteps)
   {
     vertices.resize(numTimeSteps);
@@ -134,6 +142,58 @@ namespace embree
     Geometry::update();
   }
 
+  void TriangleMesh::setOpacityMicromap (unsigned int level, RTCOpacityFunction opacity)
+  {
+    if (level > 6)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "opacity micromap subdivision level can be at most 6");
+
+    opacityFunc = opacity;
+    opacityMicromapLevel = level;
+    Geometry::update();
+  }
+
+  void TriangleMesh::buildOpacityMicromap()
+  {
+    const unsigned int n = 1 << opacityMicromapLevel;
+    const size_t numMicroTriangles = size_t(n*n);
+
+    /* each byte stores the states of 4 micro triangles, we process 4 triangles per task to never write the same byte twice */
+    opacityMicromap.resize((numPrimitives*numMicroTriangles+3)/4);
+    parallel_for(size_t(0), size_t(numPrimitives+3)/4, size_t(256), [&](const range<size_t>& r)
+    {
+      RTCOpacityFunctionArguments args;
+      args.geometryUserPtr = userPtr;
+      
+      for (size_t i=4*r.begin(); i<min(4*r.end(),size_t(numPrimitives)); i++)
+      {
+        args.primID = (unsigned int) i;
+        args.microTriangleID = 0;
+
+        /* micro triangles are enumerated row by row along v, each row alternating between lower and upper triangles */
+        for (unsigned int y=0; y<n; y++)
+        {
+          for (unsigned int x=0; x<2*(n-y)-1; x++, args.microTriangleID++)
+          {
+            const unsigned int x0 = x/2;
+            if (x%2 == 0) {
+              args.u[0] = float(x0+0)/n; args.v[0] = float(y+0)/n;
+              args.u[1] = float(x0+1)/n; args.v[1] = float(y+0)/n;
+              args.u[2] = float(x0+0)/n; args.v[2] = float(y+1)/n;
+            } else {
+              args.u[0] = float(x0+1)/n; args.v[0] = float(y+0)/n;
+              args.u[1] = float(x0+1)/n; args.v[1] = float(y+1)/n;
+              args.u[2] = float(x0+0)/n; args.v[2] = float(y+1)/n;
+            }
+            const unsigned char state = (unsigned char) opacityFunc(&args) & 3;
+            const size_t bit = 2*(i*numMicroTriangles + args.microTriangleID);
+            opacityMicromap[bit >> 3] &= ~(3 << (bit & 7));
+            opacityMicromap[bit >> 3] |= state << (bit & 7);
+          }
+        }
+      }
+    });
+  }
+
   void TriangleMesh::commit()
   {
     /* verify that stride of all time steps are identical */
@@ -141,6 +201,11 @@ namespace embree
       if (vertices[t].getStride() != vertices[0].getStride())
         throw_RTCError(RTC_ERROR_INVALID_OPERATION,"stride of vertex buffers have to be identical for each time step");
 
+    /* evaluate opacity of all micro triangles */
+    if (opacityFunc) buildOpacityMicromap();
+    else opacityMicromap.clear();
+    opacityMicromapEnabled = opacityFunc != nullptr;
+
     Geometry::commit();
   }
 
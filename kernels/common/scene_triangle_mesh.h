@@ -33,16 +33,21 @@ namespace embree
     /* geometry interface */
   public:
     void setMask(unsigned mask);
+    void enableBackfaceCulling(bool enable);
     void setNumTimeSteps (unsigned int numTimeSteps);
     void setVertexAttributeCount (unsigned int N);
     void setBuffer(RTCBufferType type, unsigned int slot, RTCFormat format, const Ref<Buffer>& buffer, size_t offset, size_t stride, unsigned int num);
     void* getBuffer(RTCBufferType type, unsigned int slot);
     void updateBuffer(RTCBufferType type, unsigned int slot);
+    void setOpacityMicromap (unsigned int level, RTCOpacityFunction opacity);
     void commit();
     bool verify();
     void interpolate(const RTCInterpolateArguments* const args);
     void addElementsToCount (GeometryCounts & counts) const;
 
+  private:
+    void buildOpacityMicromap();
+
     template<int N>
     void interpolate_impl(const RTCInterpolateArguments* const args)
     {
@@ -260,6 +265,18 @@ namespace embree
       return triangles.isModified(otherVersion); // || numPrimitivesChanged;
     }
 
+    /*! returns the opacity micromap state of the micro triangle of the i'th triangle containing the hit u/v */
+    __forceinline RTCOpacityMicromapState opacityMicromapState(size_t i, float u, float v) const
+    {
+      const int n = 1 << opacityMicromapLevel;
+      const float fu = u*float(n), fv = v*float(n);
+      const int y = clamp(int(fv),0,n-1);
+      const int x = clamp(int(fu),0,n-1-y);
+      const int upper = (x+y < n-1) && (fu-float(x)) + (fv-float(y)) > 1.0f;
+      const size_t bit = 2*(i*size_t(n*n) + size_t(2*n*y - y*y + 2*x + upper));
+      return (RTCOpacityMicromapState) ((opacityMicromap[bit >> 3] >> (bit & 7)) & 3);
+    }
+
     /* returns the projected area */
     __forceinline float projectedPrimitiveArea(const size_t i) const {
       const Triangle& tri = triangle(i);
@@ -274,6 +291,10 @@ namespace embree
     BufferView<Vec3fa> vertices0;        //!< fast access to first vertex buffer
     Device::vector<BufferView<Vec3fa>> vertices = device; //!< vertex array for each timestep
     Device::vector<RawBufferView> vertexAttribs = device; //!< vertex attributes
+
+    RTCOpacityFunction opacityFunc;      //!< callback evaluating the opacity of micro triangles
+    unsigned int opacityMicromapLevel;   //!< the triangles get subdivided into 4^level micro triangles
+    mvector<unsigned char> opacityMicromap; //!< 2 bit opacity state of each micro triangle
   };
 
   namespace isa
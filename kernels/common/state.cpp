@@ -85,6 +85,7 @@ namespace embree
     useSpatialPreSplits = false;
 
     tessellation_cache_size = 128*1024*1024;
+    tessellation_cache_max_size = 1024*1024*1024;
 
     subdiv_accel = "default";
     subdiv_accel_mb = "default";
@@ -435,6 +436,8 @@ namespace embree
         tessellation_cache_size = size_t(cin->get().Float()*1024.0f*1024.0f);
       else if (tok == Token::Id("cache_size") && cin->trySymbol("="))
         tessellation_cache_size = size_t(cin->get().Float()*1024.0f*1024.0f);
+      else if (tok == Token::Id("tessellation_cache_max_size") && cin->trySymbol("="))
+        tessellation_cache_max_size = size_t(cin->get().Float()*1024.0f*1024.0f);
 
       else if (tok == Token::Id("alloc_main_block_size") && cin->trySymbol("="))
         alloc_main_block_size = cin->get().Int();
@@ -475,6 +478,7 @@ namespace embree
 
     std::cout << "  verbosity          = " << verbose << std::endl;
     std::cout << "  cache_size         = " << float(tessellation_cache_size)*1E-6 << " MB" << std::endl;
+    std::cout << "  cache_max_size     = " << float(tessellation_cache_max_size)*1E-6 << " MB" << std::endl;
     std::cout << "  max_spatial_split_replications = " << max_spatial_split_replications << std::endl;
     
     std::cout << "triangles:" << std::endl;
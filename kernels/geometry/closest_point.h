@@ -0,0 +1,273 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "triangle.h"
+#include "trianglev.h"
+#include "trianglev_mb.h"
+#include "trianglei.h"
+#include "quadv.h"
+#include "quadi.h"
+#include "subgrid.h"
+#include "../common/context.h"
+#include "../common/point_query.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! Computes the closest points of M triangles to the point p and
+     *  returns their barycentric coordinates u and v. This is a
+     *  branchless version of the Voronoi region test from Ericson,
+     *  Real-Time Collision Detection, where later regions override
+     *  earlier ones. */
+    template<int M>
+    __forceinline Vec3vf<M> closestPointTriangle(const Vec3vf<M>& p, const Vec3vf<M>& a, const Vec3vf<M>& b, const Vec3vf<M>& c,
+                                                 vfloat<M>& u, vfloat<M>& v)
+    {
+      const vfloat<M> zero_(zero), one_(one);
+      const Vec3vf<M> ab = b-a;
+      const Vec3vf<M> ac = c-a;
+      const vfloat<M> d1 = dot(ab,p-a), d2 = dot(ac,p-a);
+      const vfloat<M> d3 = dot(ab,p-b), d4 = dot(ac,p-b);
+      const vfloat<M> d5 = dot(ab,p-c), d6 = dot(ac,p-c);
+      const vfloat<M> va = d3*d6 - d5*d4;
+      const vfloat<M> vb = d5*d2 - d1*d6;
+      const vfloat<M> vc = d1*d4 - d3*d2;
+
+      /* interior of the triangle */
+      const vfloat<M> denom = one_/(va+vb+vc);
+      u = vb*denom;
+      v = vc*denom;
+
+      /* edge bc */
+      const vfloat<M> d43 = d4-d3, d56 = d5-d6;
+      const vbool<M> edge_bc = (va <= 0.0f) & (d43 >= 0.0f) & (d56 >= 0.0f);
+      const vfloat<M> w_bc = d43/(d43+d56);
+      u = select(edge_bc,one_-w_bc,u);
+      v = select(edge_bc,w_bc,v);
+
+      /* edge ac */
+      const vbool<M> edge_ac = (vb <= 0.0f) & (d2 >= 0.0f) & (d6 <= 0.0f);
+      u = select(edge_ac,zero_,u);
+      v = select(edge_ac,d2/(d2-d6),v);
+
+      /* edge ab */
+      const vbool<M> edge_ab = (vc <= 0.0f) & (d1 >= 0.0f) & (d3 <= 0.0f);
+      u = select(edge_ab,d1/(d1-d3),u);
+      v = select(edge_ab,zero_,v);
+
+      /* vertex c */
+      const vbool<M> vertex_c = (d6 >= 0.0f) & (d5 <= d6);
+      u = select(vertex_c,zero_,u);
+      v = select(vertex_c,one_,v);
+
+      /* vertex b */
+      const vbool<M> vertex_b = (d3 >= 0.0f) & (d4 <= d3);
+      u = select(vertex_b,one_,u);
+      v = select(vertex_b,zero_,v);
+
+      /* vertex a */
+      const vbool<M> vertex_a = (d1 <= 0.0f) & (d2 <= 0.0f);
+      u = select(vertex_a,zero_,u);
+      v = select(vertex_a,zero_,v);
+
+      return a + u*ab + v*ac;
+    }
+
+    /*! Closest points of M triangles to a point query. Distances are
+     *  measured in world space, thus triangles of instanced geometries
+     *  get transformed to world space first, which keeps the result
+     *  exact for non-similarity instance transformations. */
+    template<int M>
+    struct ClosestPointHitM
+    {
+      __forceinline ClosestPointHitM() {}
+
+      __forceinline ClosestPointHitM(const vbool<M>& valid_i, PointQuery* query, PointQueryContext* context,
+                                     Vec3vf<M> v0, Vec3vf<M> v1, Vec3vf<M> v2)
+      {
+        const PointQuery* query_ws = context->query_ws;
+        if (unlikely(context->userContext->instStackSize > 0))
+        {
+          const RTCPointQueryContext* user = context->userContext;
+          const AffineSpace3vf<M> local2world = AffineSpace3fa_load_unaligned((AffineSpace3fa*)user->inst2world[user->instStackSize-1]);
+          v0 = xfmPoint(local2world,v0);
+          v1 = xfmPoint(local2world,v1);
+          v2 = xfmPoint(local2world,v2);
+        }
+        const Vec3vf<M> q(query_ws->p.x,query_ws->p.y,query_ws->p.z);
+        p = closestPointTriangle<M>(q,v0,v1,v2,u,v);
+        dist2 = dot(p-q,p-q);
+        valid = valid_i & (dist2 < vfloat<M>(sqr(query_ws->radius)));
+      }
+
+      /* keeps the closer of both hits per lane */
+      __forceinline void merge(const ClosestPointHitM& other)
+      {
+        const vbool<M> m = other.valid & (!valid | (other.dist2 < dist2));
+        valid |= other.valid;
+        p.x = select(m,other.p.x,p.x);
+        p.y = select(m,other.p.y,p.y);
+        p.z = select(m,other.p.z,p.z);
+        u = select(m,other.u,u);
+        v = select(m,other.v,v);
+        dist2 = select(m,other.dist2,dist2);
+      }
+
+      /* hits on the second triangle (v2,v3,v1) of a quad use the quad parametrization */
+      __forceinline void flipUV()
+      {
+        u = vfloat<M>(one)-u;
+        v = vfloat<M>(one)-v;
+      }
+
+      /* writes the closest hit into the query result and shrinks the query radius */
+      __forceinline bool commit(PointQuery* query, PointQueryContext* context, const vuint<M>& geomIDs, const vuint<M>& primIDs) const
+      {
+        if (none(valid)) return false;
+        const size_t i = select_min(valid,dist2);
+
+        RTCClosestPointResult* result = context->closestPoint;
+        RTCPointQueryContext* user = context->userContext;
+        result->p_x = p.x[i];
+        result->p_y = p.y[i];
+        result->p_z = p.z[i];
+        result->u = u[i];
+        result->v = v[i];
+        result->primID = primIDs[i];
+        result->geomID = geomIDs[i];
+        for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; ++l) {
+          result->instID[l] = user->instID[l];
+#if defined(RTC_GEOMETRY_INSTANCE_ARRAY)
+          result->instPrimID[l] = user->instPrimID[l];
+#endif
+        }
+
+        /* update point query */
+        context->query_ws->radius = sqrt(dist2[i]);
+        if (user->instStackSize > 0)
+        {
+          if (context->query_type == POINT_QUERY_TYPE_AABB) {
+            context->updateAABB();
+          } else {
+            assert(context->similarityScale > 0.f);
+            query->radius = context->query_ws->radius * context->similarityScale;
+          }
+        }
+        return true;
+      }
+
+      vbool<M> valid;
+      Vec3vf<M> p;
+      vfloat<M> u;
+      vfloat<M> v;
+      vfloat<M> dist2;
+    };
+
+    /*! Built-in closest point queries against triangle, quad, and grid
+     *  leaves. These run instead of the point query callbacks when
+     *  context->closestPoint is set. */
+    struct ClosestPointQuery
+    {
+      template<int M>
+      static __forceinline bool triangles(PointQuery* query, PointQueryContext* context, const vbool<M>& valid,
+                                          const Vec3vf<M>& v0, const Vec3vf<M>& v1, const Vec3vf<M>& v2,
+                                          const vuint<M>& geomIDs, const vuint<M>& primIDs)
+      {
+        STAT3(point_query.trav_prims,popcnt(valid),popcnt(valid),popcnt(valid));
+        const ClosestPointHitM<M> hit(valid,query,context,v0,v1,v2);
+        return hit.commit(query,context,geomIDs,primIDs);
+      }
+
+      template<int M>
+      static __forceinline ClosestPointHitM<M> quads(PointQuery* query, PointQueryContext* context, const vbool<M>& valid,
+                                                     const Vec3vf<M>& v0, const Vec3vf<M>& v1, const Vec3vf<M>& v2, const Vec3vf<M>& v3)
+      {
+        STAT3(point_query.trav_prims,popcnt(valid),popcnt(valid),popcnt(valid));
+        ClosestPointHitM<M> hit0(valid,query,context,v0,v1,v3);
+        ClosestPointHitM<M> hit1(valid,query,context,v2,v3,v1);
+        hit1.flipUV();
+        hit0.merge(hit1);
+        return hit0;
+      }
+
+      template<int M>
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const TriangleM<M>& tri)
+      {
+        const Vec3vf<M> v0 = tri.v0;
+        const Vec3vf<M> v1 = tri.v0-tri.e1;
+        const Vec3vf<M> v2 = tri.v0+tri.e2;
+        return triangles<M>(query,context,tri.valid(),v0,v1,v2,tri.geomID(),tri.primID());
+      }
+
+      template<int M>
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const TriangleMv<M>& tri) {
+        return triangles<M>(query,context,tri.valid(),tri.v0,tri.v1,tri.v2,tri.geomID(),tri.primID());
+      }
+
+      template<int M>
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const TriangleMvMB<M>& tri)
+      {
+        const Vec3vf<M> time(query->time);
+        const Vec3vf<M> v0 = madd(time,Vec3vf<M>(tri.dv0),Vec3vf<M>(tri.v0));
+        const Vec3vf<M> v1 = madd(time,Vec3vf<M>(tri.dv1),Vec3vf<M>(tri.v1));
+        const Vec3vf<M> v2 = madd(time,Vec3vf<M>(tri.dv2),Vec3vf<M>(tri.v2));
+        return triangles<M>(query,context,tri.valid(),v0,v1,v2,tri.geomID(),tri.primID());
+      }
+
+      template<int M>
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const TriangleMi<M>& tri)
+      {
+        Vec3vf<M> v0, v1, v2; tri.gather(v0,v1,v2,context->scene);
+        return triangles<M>(query,context,tri.valid(),v0,v1,v2,tri.geomID(),tri.primID());
+      }
+
+      template<int M>
+      static __forceinline bool pointQueryMB(PointQuery* query, PointQueryContext* context, const TriangleMi<M>& tri)
+      {
+        Vec3vf<M> v0, v1, v2; tri.gather(v0,v1,v2,context->scene,query->time);
+        return triangles<M>(query,context,tri.valid(),v0,v1,v2,tri.geomID(),tri.primID());
+      }
+
+      template<int M>
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const QuadMv<M>& quad)
+      {
+        const ClosestPointHitM<M> hit = quads<M>(query,context,quad.valid(),quad.v0,quad.v1,quad.v2,quad.v3);
+        return hit.commit(query,context,quad.geomID(),quad.primID());
+      }
+
+      template<int M>
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const QuadMi<M>& quad)
+      {
+        Vec3vf<M> v0, v1, v2, v3; quad.gather(v0,v1,v2,v3,context->scene);
+        const ClosestPointHitM<M> hit = quads<M>(query,context,quad.valid(),v0,v1,v2,v3);
+        return hit.commit(query,context,quad.geomID(),quad.primID());
+      }
+
+      template<int M>
+      static __forceinline bool pointQueryMB(PointQuery* query, PointQueryContext* context, const QuadMi<M>& quad)
+      {
+        Vec3vf<M> v0, v1, v2, v3; quad.gather(v0,v1,v2,v3,context->scene,query->time);
+        const ClosestPointHitM<M> hit = quads<M>(query,context,quad.valid(),v0,v1,v2,v3);
+        return hit.commit(query,context,quad.geomID(),quad.primID());
+      }
+
+      static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const SubGrid& subgrid)
+      {
+        const GridMesh* mesh    = context->scene->get<GridMesh>(subgrid.geomID());
+        const GridMesh::Grid &g = mesh->grid(subgrid.primID());
+        Vec3vf4 v0,v1,v2,v3; subgrid.gather(v0,v1,v2,v3,mesh,g);
+        ClosestPointHitM<4> hit = quads<4>(query,context,vbool4(true),v0,v1,v2,v3);
+
+        /* map the quad coordinates to u/v across the entire grid */
+        const vfloat4 sx = vfloat4(vint4(subgrid.x()) + vint4(0,1,1,0));
+        const vfloat4 sy = vfloat4(vint4(subgrid.y()) + vint4(0,0,1,1));
+        hit.u = (hit.u + sx) * rcp((float)((int)g.resX-1));
+        hit.v = (hit.v + sy) * rcp((float)((int)g.resY-1));
+        return hit.commit(query,context,vuint4(subgrid.geomID()),vuint4(subgrid.primID()));
+      }
+    };
+  }
+}
@@ -219,4 +219,5 @@ namespace embree
 
   typedef CurveNi<4> Curve4i;
   typedef CurveNi<8> Curve8i;
+  typedef CurveNi<16> Curve16i;
 }
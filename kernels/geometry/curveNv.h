@@ -53,7 +53,7 @@ namespace embree
         const unsigned int geomID = prim.geomID();
         const unsigned int primID = prim.primID();
         CurveGeometry* mesh = (CurveGeometry*) scene->get(geomID);
-        const unsigned vtxID = mesh->curve(primID);
+        const unsigned vtxID = mesh->curve(mesh->presplitPrimID(primID));
         Vec3fa::storeu(&this->vertices(i,N)[0],mesh->vertex(vtxID+0));
         Vec3fa::storeu(&this->vertices(i,N)[1],mesh->vertex(vtxID+1));
         Vec3fa::storeu(&this->vertices(i,N)[2],mesh->vertex(vtxID+2));
@@ -196,6 +196,17 @@ namespace embree
                                                 curve,N,
                                                 epilog);
       }
+
+      /* flat curves never get pre-split, thus the parameter range always covers the entire curve */
+      template<typename Ray, typename Epilog>
+      __forceinline bool intersect(const CurvePrecalculations1& pre, Ray& ray,
+                                   RayQueryContext* context,
+                                   const CurveGeometry* geom, const unsigned int primID,
+                                   const Vec3ff& v0, const Vec3ff& v1, const Vec3ff& v2, const Vec3ff& v3,
+                                   const BBox1f& u, const Epilog& epilog)
+      {
+        return intersect(pre,ray,context,geom,primID,v0,v1,v2,v3,epilog);
+      }
     };
     
     template<template<typename Ty> class NativeCurve, int K, int M = VSIZEX>
@@ -220,6 +231,17 @@ namespace embree
                                                 curve,N,
                                                 epilog);
       }
+
+      /* flat curves never get pre-split, thus the parameter range always covers the entire curve */
+      template<typename Epilog>
+      __forceinline bool intersect(const CurvePrecalculationsK<K>& pre, RayK<K>& ray, size_t k,
+                                   RayQueryContext* context,
+                                   const CurveGeometry* geom, const unsigned int primID,
+                                   const Vec3ff& v0, const Vec3ff& v1, const Vec3ff& v2, const Vec3ff& v3,
+                                   const BBox1f& u, const Epilog& epilog)
+      {
+        return intersect(pre,ray,k,context,geom,primID,v0,v1,v2,v3,epilog);
+      }
     };
   }
 }
@@ -7,6 +7,7 @@
 #include "cylinder.h"
 #include "plane.h"
 #include "line_intersector.h"
+#include "roundline_intersector.h"
 #include "curve_intersector_precalculations.h"
 
 namespace embree
@@ -137,10 +138,10 @@ namespace embree
 #if !defined(__SYCL_DEVICE_ONLY__)
     
     template<typename NativeCurve3ff, typename Ray, typename Epilog>
-    __forceinline bool intersect_bezier_recursive_jacobian(const Ray& ray, const float dt, const NativeCurve3ff& curve, const Epilog& epilog)
+    __forceinline bool intersect_bezier_recursive_jacobian(const Ray& ray, const float dt, const NativeCurve3ff& curve, const BBox1f& u, const Epilog& epilog)
     {
-      float u0 = 0.0f;
-      float u1 = 1.0f;
+      float u0 = u.lower;
+      float u1 = u.upper;
       unsigned int depth = 1;
         
 #if defined(__AVX__)
@@ -303,7 +304,7 @@ namespace embree
 #else
     
      template<typename NativeCurve3ff, typename Ray, typename Epilog>
-     __forceinline bool intersect_bezier_recursive_jacobian(const Ray& ray, const float dt, const NativeCurve3ff& curve, const Epilog& epilog)
+     __forceinline bool intersect_bezier_recursive_jacobian(const Ray& ray, const float dt, const NativeCurve3ff& curve, const BBox1f& u, const Epilog& epilog)
     {
       const Vec3fa org = zero;
       const Vec3fa dir = ray.dir;
@@ -332,8 +333,8 @@ namespace embree
 
       do
       {
-        const float u0 = (stack.short_stack+0*(1<<(31-stack.depth)))/float(0x80000000);
-        const float u1 = (stack.short_stack+1*(1<<(31-stack.depth)))/float(0x80000000);
+        const float u0 = lerp(u.lower,u.upper,(stack.short_stack+0*(1<<(31-stack.depth)))/float(0x80000000));
+        const float u1 = lerp(u.lower,u.upper,(stack.short_stack+1*(1<<(31-stack.depth)))/float(0x80000000));
       
         /* subdivide bezier curve */
         Vec3ff P0, dP0du; curve.eval(u0,P0,dP0du); dP0du = dP0du * (u1-u0);
@@ -442,6 +443,30 @@ namespace embree
 
 #endif
     
+    /* intersects the parameter range u of a tessellated curve as round linear segment, the neighboring
+     * segments of the same curve are used to cut away hits inside the curve as for round linear curves */
+    template<typename NativeCurve3ff, typename Ray, typename Epilog>
+    __forceinline bool intersect_tessellated_segment(Ray& ray, const NativeCurve3ff& curve, const BBox1f& u, const Epilog& epilog)
+    {
+      const float du = u.size();
+      const Vec3ff p0 = curve.eval(u.lower);
+      const Vec3ff p1 = curve.eval(u.upper);
+      const Vec3ff pL = u.lower > 0.0f ? curve.eval(u.lower-du) : Vec3ff(pos_inf);
+      const Vec3ff pR = u.upper < 1.0f ? curve.eval(u.upper+du) : Vec3ff(pos_inf);
+
+      const vbool4 valid(true,false,false,false);
+      const Vec3vf4 ray_org(ray.org.x,ray.org.y,ray.org.z);
+      const Vec3vf4 ray_dir(ray.dir.x,ray.dir.y,ray.dir.z);
+      auto ray_tfar = [&] () { return vfloat4(ray.tfar); };
+      auto lineEpilog = [&] (const vbool4& valid, RoundLineIntersectorHitM<4>& hit) {
+        BezierCurveHit h(hit.t(0),lerp(u.lower,u.upper,hit.uv(0).x),hit.Ng(0));
+        return epilog(h);
+      };
+      return __roundline_internal::intersectConeSphere<4>(valid,ray_org,ray_dir,vfloat4(ray.tnear()),ray_tfar,
+                                                          Vec4vf4(p0.x,p0.y,p0.z,p0.w),Vec4vf4(p1.x,p1.y,p1.z,p1.w),
+                                                          Vec4vf4(pL.x,pL.y,pL.z,pL.w),Vec4vf4(pR.x,pR.y,pR.z,pR.w),lineEpilog);
+    }
+
     template<template<typename Ty> class NativeCurve>
     struct SweepCurve1Intersector1
     {
@@ -453,16 +478,31 @@ namespace embree
                                 const CurveGeometry* geom, const unsigned int primID,
                                 const Vec3ff& v0, const Vec3ff& v1, const Vec3ff& v2, const Vec3ff& v3,
                                 const Epilog& epilog)
+      {
+        return intersect(pre,ray,context,geom,primID,v0,v1,v2,v3,BBox1f(0.0f,1.0f),epilog);
+      }
+
+      /* intersects the parameter range u of the curve only, e.g. a sub-segment of a pre-split curve */
+      template<typename Ray, typename Epilog>
+      __forceinline bool intersect(const CurvePrecalculations1& pre, Ray& ray,
+                                RayQueryContext* context,
+                                const CurveGeometry* geom, const unsigned int primID,
+                                const Vec3ff& v0, const Vec3ff& v1, const Vec3ff& v2, const Vec3ff& v3,
+                                const BBox1f& u, const Epilog& epilog)
       {
         STAT3(normal.trav_prims,1,1,1);
 
         /* move ray closer to make intersection stable */
         NativeCurve3ff curve0(v0,v1,v2,v3);
         curve0 = enlargeRadiusToMinWidth(context,geom,ray.org,curve0);
+#if !defined(__SYCL_DEVICE_ONLY__)
+        if (unlikely(geom->isTessellated()))
+          return intersect_tessellated_segment(ray,curve0,u,epilog);
+#endif
         const float dt = dot(curve0.center()-ray.org,ray.dir)*rcp(dot(ray.dir,ray.dir));
         const Vec3ff ref(madd(Vec3fa(dt),ray.dir,ray.org),0.0f);
         const NativeCurve3ff curve1 = curve0-ref;
-        return intersect_bezier_recursive_jacobian(ray,dt,curve1,epilog);
+        return intersect_bezier_recursive_jacobian(ray,dt,curve1,u,epilog);
       }
     };
 
@@ -494,6 +534,17 @@ namespace embree
                                    const CurveGeometry* geom, const unsigned int primID,
                                    const Vec3ff& v0, const Vec3ff& v1, const Vec3ff& v2, const Vec3ff& v3,
                                    const Epilog& epilog)
+      {
+        return intersect(pre,vray,k,context,geom,primID,v0,v1,v2,v3,BBox1f(0.0f,1.0f),epilog);
+      }
+
+      /* intersects the parameter range u of the curve only, e.g. a sub-segment of a pre-split curve */
+      template<typename Epilog>
+      __forceinline bool intersect(const CurvePrecalculationsK<K>& pre, RayK<K>& vray, size_t k,
+                                   RayQueryContext* context,
+                                   const CurveGeometry* geom, const unsigned int primID,
+                                   const Vec3ff& v0, const Vec3ff& v1, const Vec3ff& v2, const Vec3ff& v3,
+                                   const BBox1f& u, const Epilog& epilog)
       {
         STAT3(normal.trav_prims,1,1,1);
         Ray1 ray(vray,k);
@@ -501,10 +552,14 @@ namespace embree
         /* move ray closer to make intersection stable */
         NativeCurve3ff curve0(v0,v1,v2,v3);
         curve0 = enlargeRadiusToMinWidth(context,geom,ray.org,curve0);
+#if !defined(__SYCL_DEVICE_ONLY__)
+        if (unlikely(geom->isTessellated()))
+          return intersect_tessellated_segment(ray,curve0,u,epilog);
+#endif
         const float dt = dot(curve0.center()-ray.org,ray.dir)*rcp(dot(ray.dir,ray.dir));
         const Vec3ff ref(madd(Vec3fa(dt),ray.dir,ray.org),0.0f);
         const NativeCurve3ff curve1 = curve0-ref;
-        return intersect_bezier_recursive_jacobian(ray,dt,curve1,epilog);
+        return intersect_bezier_recursive_jacobian(ray,dt,curve1,u,epilog);
       }
     };
   }
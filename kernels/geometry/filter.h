@@ -12,6 +12,47 @@ namespace embree
 {
   namespace isa
   {
+    /* inserts a hit into the distance sorted hit list of a multi-hit query */
+    __forceinline void insertIntoHitList(RTCHitList* list, float t, const Hit& hit)
+    {
+      /* spatial splits can report the same primitive multiple times */
+      for (unsigned int i=0; i<list->hitCount; i++)
+      {
+        bool same = list->tfar[i] == t && list->hits[i].geomID == hit.geomID && list->hits[i].primID == hit.primID;
+        for (unsigned int l=0; same && l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++) {
+          same = list->hits[i].instID[l] == hit.instID[l];
+          if (hit.instID[l] == RTC_INVALID_GEOMETRY_ID) break;
+        }
+        if (same) return;
+      }
+
+      /* drop the farthest hit if the list is full */
+      if (list->hitCount == list->maxHitCount) {
+        if (list->hitCount == 0 || t >= list->tfar[list->hitCount-1]) return;
+        list->hitCount--;
+      }
+
+      unsigned int i = list->hitCount++;
+      for (; i>0 && list->tfar[i-1] > t; i--) {
+        list->tfar[i] = list->tfar[i-1];
+        list->hits[i] = list->hits[i-1];
+      }
+
+      RTCHit& h = list->hits[i];
+      list->tfar[i] = t;
+      h.Ng_x = hit.Ng.x;
+      h.Ng_y = hit.Ng.y;
+      h.Ng_z = hit.Ng.z;
+      h.u = hit.u;
+      h.v = hit.v;
+      h.primID = hit.primID;
+      h.geomID = hit.geomID;
+      instance_id_stack::copy_UU(hit.instID, h.instID);
+#if defined(RTC_GEOMETRY_INSTANCE_ARRAY)
+      instance_id_stack::copy_UU(hit.instPrimID, h.instPrimID);
+#endif
+    }
+
     __forceinline bool runIntersectionFilter1Helper(RTCFilterFunctionNArguments* args, const Geometry* const geometry, RayQueryContext* context)
     {
       if (geometry->intersectionFilterN)
@@ -30,6 +71,12 @@ namespace embree
         if (args->valid[0] == 0)
           return false;
       }
+
+      /* multi-hit queries record the hit and reject it to continue traversal */
+      if (unlikely(context->hitList)) {
+        insertIntoHitList(context->hitList,((RayHit*)args->ray)->tfar,*(Hit*)args->hit);
+        return false;
+      }
       
       copyHitToRay(*(RayHit*)args->ray,*(Hit*)args->hit);
       return true;
@@ -11,15 +11,49 @@ namespace embree
 {
   namespace isa
   {
+    /* returns the scene to traverse, instances with levels of detail select their scene by the distance to the ray origin */
+    __forceinline Accel* getObject(const InstanceArray* instance, unsigned int primID, const Vec3fa& org, const Vec3fa& dir, float time)
+    {
+      if (likely(!instance->hasLOD())) return instance->getObject(primID);
+      if (!instance->valid(primID)) return nullptr;
+      return instance->getObject(primID, instance->selectLOD(primID, org, dir, time));
+    }
+
+    /* invokes the closure for each scene to traverse by the packet, rays may select different levels of detail */
+    template<int K, typename Closure>
+    __forceinline void foreachLOD(const vbool<K>& valid, const RayK<K>& ray, const InstanceArray* instance, unsigned int primID, const Closure& closure)
+    {
+      if (likely(!instance->hasLOD())) {
+        Accel* object = instance->getObject(primID);
+        if (object) closure(valid, object);
+        return;
+      }
+      if (!instance->valid(primID)) return;
+
+      vint<K> levels(zero);
+      const vfloat<K> time = ray.time();
+      for (size_t bits = movemask(valid); bits != 0; ) {
+        const size_t k = bscf(bits);
+        levels[k] = instance->selectLOD(primID, Vec3fa(ray.org.x[k], ray.org.y[k], ray.org.z[k]), Vec3fa(ray.dir.x[k], ray.dir.y[k], ray.dir.z[k]), time[k]);
+      }
+
+      vbool<K> valid1 = valid;
+      while (any(valid1)) {
+        vbool<K> valid2;
+        const int level = next_unique(valid1, levels, valid2);
+        closure(valid2, instance->getObject(primID, level));
+      }
+    }
+
     void InstanceArrayIntersector1::intersect(const Precalculations& pre, RayHit& ray, RayQueryContext* context, const Primitive& prim)
     {
       InstanceArray* instance = context->scene->get<InstanceArray>(prim.instID_);
-      Accel* object = instance->getObject(prim.primID_);
+      Accel* object = getObject(instance, prim.primID_, ray.org, ray.dir, ray.time());
       if (!object) return;
 
       /* perform ray mask test */
 #if defined(EMBREE_RAY_MASK)
-      if ((ray.mask & instance->mask) == 0) 
+      if ((ray.mask & instance->mask) == 0 || (ray.mask & ((Scene*)object)->getGeometryMask()) == 0)
         return;
 #endif
 
@@ -42,12 +76,12 @@ namespace embree
     bool InstanceArrayIntersector1::occluded(const Precalculations& pre, Ray& ray, RayQueryContext* context, const Primitive& prim)
     {
       const InstanceArray* instance = context->scene->get<InstanceArray>(prim.instID_);
-      Accel* object = instance->getObject(prim.primID_);
+      Accel* object = getObject(instance, prim.primID_, ray.org, ray.dir, ray.time());
       if (!object) return false;
       
       /* perform ray mask test */
 #if defined(EMBREE_RAY_MASK)
-      if ((ray.mask & instance->mask) == 0) 
+      if ((ray.mask & instance->mask) == 0 || (ray.mask & ((Scene*)object)->getGeometryMask()) == 0)
         return false;
 #endif
       
@@ -56,7 +90,6 @@ namespace embree
       if (likely(instance_id_stack::push(user_context, prim.instID_, prim.primID_)))
       {
         const AffineSpace3fa world2local = instance->getWorld2Local(prim.primID_);
-        Accel* object = instance->getObject(prim.primID_);
         const Vec3ff ray_org = ray.org;
         const Vec3ff ray_dir = ray.dir;
         ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
@@ -74,8 +107,10 @@ namespace embree
     bool InstanceArrayIntersector1::pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& prim)
     {
       const InstanceArray* instance = context->scene->get<InstanceArray>(prim.instID_);
-      Accel* object = instance->getObject(prim.primID_);
+      Accel* object = getObject(instance, prim.primID_, query->p, Vec3fa(zero), query->time);
       if (!object) return false;
+      if (unlikely(context->boxQuery))
+        return context->addBoxQueryPrimitive(instance,prim.instID_,prim.primID_);
 
       const AffineSpace3fa local2world = instance->getLocal2World(prim.primID_);
       const AffineSpace3fa world2local = instance->getWorld2Local(prim.primID_);
@@ -100,6 +135,7 @@ namespace embree
           similarityScale,
           context->userPtr);
 
+        context_inst.closestPoint = context->closestPoint;
         bool changed = object->intersectors.pointQuery(&query_inst, &context_inst);
         instance_id_stack::pop(context->userContext);
         return changed;
@@ -110,12 +146,12 @@ namespace embree
     void InstanceArrayIntersector1MB::intersect(const Precalculations& pre, RayHit& ray, RayQueryContext* context, const Primitive& prim)
     {
       const InstanceArray* instance = context->scene->get<InstanceArray>(prim.instID_);
-      Accel* object = instance->getObject(prim.primID_);
+      Accel* object = getObject(instance, prim.primID_, ray.org, ray.dir, ray.time());
       if (!object) return;
 
       /* perform ray mask test */
 #if defined(EMBREE_RAY_MASK)
-      if ((ray.mask & instance->mask) == 0) 
+      if ((ray.mask & instance->mask) == 0 || (ray.mask & ((Scene*)object)->getGeometryMask()) == 0)
         return;
 #endif
       
@@ -138,12 +174,12 @@ namespace embree
     bool InstanceArrayIntersector1MB::occluded(const Precalculations& pre, Ray& ray, RayQueryContext* context, const Primitive& prim)
     {
       const InstanceArray* instance = context->scene->get<InstanceArray>(prim.instID_);
-      Accel* object = instance->getObject(prim.primID_);
+      Accel* object = getObject(instance, prim.primID_, ray.org, ray.dir, ray.time());
       if (!object) return false;
 
       /* perform ray mask test */
 #if defined(EMBREE_RAY_MASK)
-      if ((ray.mask & instance->mask) == 0) 
+      if ((ray.mask & instance->mask) == 0 || (ray.mask & ((Scene*)object)->getGeometryMask()) == 0)
         return false;
 #endif
       
@@ -169,8 +205,10 @@ namespace embree
     bool InstanceArrayIntersector1MB::pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& prim)
     {
       const InstanceArray* instance = context->scene->get<InstanceArray>(prim.instID_);
-      Accel* object = instance->getObject(prim.primID_);
+      Accel* object = getObject(instance, prim.primID_, query->p, Vec3fa(zero), query->time);
       if (!object) return false;
+      if (unlikely(context->boxQuery))
+        return context->addBoxQueryPrimitive(instance,prim.instID_,prim.primID_);
 
       const AffineSpace3fa local2world = instance->getLocal2World(prim.primID_, query->time);
       const AffineSpace3fa world2local = instance->getWorld2Local(prim.primID_, query->time);
@@ -194,6 +232,7 @@ namespace embree
           similarityScale,
           context->userPtr); 
 
+        context_inst.closestPoint = context->closestPoint;
         bool changed = object->intersectors.pointQuery(&query_inst, &context_inst);
         instance_id_stack::pop(context->userContext);
         return changed;
@@ -204,126 +243,126 @@ namespace embree
     template<int K>
     void InstanceArrayIntersectorK<K>::intersect(const vbool<K>& valid_i, const Precalculations& pre, RayHitK<K>& ray, RayQueryContext* context, const Primitive& prim)
     {
-      vbool<K> valid = valid_i;
       const InstanceArray* instance = context->scene->get<InstanceArray>(prim.instID_);
-      Accel* object = instance->getObject(prim.primID_);
-      if (!object) return;
-
-      /* perform ray mask test */
+      foreachLOD<K>(valid_i, ray, instance, prim.primID_, [&] (vbool<K> valid, Accel* object)
+      {
+        /* perform ray mask test */
 #if defined(EMBREE_RAY_MASK)
-      valid &= (ray.mask & instance->mask) != 0;
-      if (none(valid)) return;
+        valid &= (ray.mask & instance->mask) != 0;
+        valid &= (ray.mask & ((Scene*)object)->getGeometryMask()) != 0;
+        if (none(valid)) return;
 #endif
-        
-      RTCRayQueryContext* user_context = context->user;
-      if (likely(instance_id_stack::push(user_context, prim.instID_, prim.primID_)))
-      {
-        const AffineSpace3vf<K> world2local = instance->getWorld2Local(prim.primID_);
-        const Vec3vf<K> ray_org = ray.org;
-        const Vec3vf<K> ray_dir = ray.dir;
-        ray.org = xfmPoint(world2local, ray_org);
-        ray.dir = xfmVector(world2local, ray_dir);
-        RayQueryContext newcontext((Scene*)object, user_context, context->args);
-        object->intersectors.intersect(valid, ray, &newcontext);
-        ray.org = ray_org;
-        ray.dir = ray_dir;
-        instance_id_stack::pop(user_context);
-      }
+
+        RTCRayQueryContext* user_context = context->user;
+        if (likely(instance_id_stack::push(user_context, prim.instID_, prim.primID_)))
+        {
+          const AffineSpace3vf<K> world2local = instance->getWorld2Local(prim.primID_);
+          const Vec3vf<K> ray_org = ray.org;
+          const Vec3vf<K> ray_dir = ray.dir;
+          ray.org = xfmPoint(world2local, ray_org);
+          ray.dir = xfmVector(world2local, ray_dir);
+          RayQueryContext newcontext((Scene*)object, user_context, context->args);
+          object->intersectors.intersect(valid, ray, &newcontext);
+          ray.org = ray_org;
+          ray.dir = ray_dir;
+          instance_id_stack::pop(user_context);
+        }
+      });
     }
 
     template<int K>
     vbool<K> InstanceArrayIntersectorK<K>::occluded(const vbool<K>& valid_i, const Precalculations& pre, RayK<K>& ray, RayQueryContext* context, const Primitive& prim)
     {
-      vbool<K> valid = valid_i;
       const InstanceArray* instance = context->scene->get<InstanceArray>(prim.instID_);
-      Accel* object = instance->getObject(prim.primID_);
-      if (!object) return false;
-
-      /* perform ray mask test */
-#if defined(EMBREE_RAY_MASK)
-      valid &= (ray.mask & instance->mask) != 0;
-      if (none(valid)) return false;
-#endif
-        
-      RTCRayQueryContext* user_context = context->user;
       vbool<K> occluded = false;
-      if (likely(instance_id_stack::push(user_context, prim.instID_, prim.primID_)))
+      foreachLOD<K>(valid_i, ray, instance, prim.primID_, [&] (vbool<K> valid, Accel* object)
       {
-        const AffineSpace3vf<K> world2local = instance->getWorld2Local(prim.primID_);
-        const Vec3vf<K> ray_org = ray.org;
-        const Vec3vf<K> ray_dir = ray.dir;
-        ray.org = xfmPoint(world2local, ray_org);
-        ray.dir = xfmVector(world2local, ray_dir);
-        RayQueryContext newcontext((Scene*)object, user_context, context->args);
-        object->intersectors.occluded(valid, ray, &newcontext);
-        ray.org = ray_org;
-        ray.dir = ray_dir;
-        occluded = ray.tfar < 0.0f;
-        instance_id_stack::pop(user_context);
-      }
-      return occluded;    
+        /* perform ray mask test */
+#if defined(EMBREE_RAY_MASK)
+        valid &= (ray.mask & instance->mask) != 0;
+        valid &= (ray.mask & ((Scene*)object)->getGeometryMask()) != 0;
+        if (none(valid)) return;
+#endif
+
+        RTCRayQueryContext* user_context = context->user;
+        if (likely(instance_id_stack::push(user_context, prim.instID_, prim.primID_)))
+        {
+          const AffineSpace3vf<K> world2local = instance->getWorld2Local(prim.primID_);
+          const Vec3vf<K> ray_org = ray.org;
+          const Vec3vf<K> ray_dir = ray.dir;
+          ray.org = xfmPoint(world2local, ray_org);
+          ray.dir = xfmVector(world2local, ray_dir);
+          RayQueryContext newcontext((Scene*)object, user_context, context->args);
+          object->intersectors.occluded(valid, ray, &newcontext);
+          ray.org = ray_org;
+          ray.dir = ray_dir;
+          occluded |= ray.tfar < 0.0f;
+          instance_id_stack::pop(user_context);
+        }
+      });
+      return occluded;
     }
     
     template<int K>
     void InstanceArrayIntersectorKMB<K>::intersect(const vbool<K>& valid_i, const Precalculations& pre, RayHitK<K>& ray, RayQueryContext* context, const Primitive& prim)
     {
-      vbool<K> valid = valid_i;
       const InstanceArray* instance = context->scene->get<InstanceArray>(prim.instID_);
-      Accel* object = instance->getObject(prim.primID_);
-      if (!object) return;
-
-      /* perform ray mask test */
+      foreachLOD<K>(valid_i, ray, instance, prim.primID_, [&] (vbool<K> valid, Accel* object)
+      {
+        /* perform ray mask test */
 #if defined(EMBREE_RAY_MASK)
-      valid &= (ray.mask & instance->mask) != 0;
-      if (none(valid)) return;
+        valid &= (ray.mask & instance->mask) != 0;
+        valid &= (ray.mask & ((Scene*)object)->getGeometryMask()) != 0;
+        if (none(valid)) return;
 #endif
-        
-      RTCRayQueryContext* user_context = context->user;
-      if (likely(instance_id_stack::push(user_context, prim.instID_, prim.primID_)))
-      {
-        AffineSpace3vf<K> world2local = instance->getWorld2Local<K>(prim.primID_, valid, ray.time());
-        const Vec3vf<K> ray_org = ray.org;
-        const Vec3vf<K> ray_dir = ray.dir;
-        ray.org = xfmPoint(world2local, ray_org);
-        ray.dir = xfmVector(world2local, ray_dir);
-        RayQueryContext newcontext((Scene*)object, user_context, context->args);
-        object->intersectors.intersect(valid, ray, &newcontext);
-        ray.org = ray_org;
-        ray.dir = ray_dir;
-        instance_id_stack::pop(user_context);
-      }
+
+        RTCRayQueryContext* user_context = context->user;
+        if (likely(instance_id_stack::push(user_context, prim.instID_, prim.primID_)))
+        {
+          AffineSpace3vf<K> world2local = instance->getWorld2Local<K>(prim.primID_, valid, ray.time());
+          const Vec3vf<K> ray_org = ray.org;
+          const Vec3vf<K> ray_dir = ray.dir;
+          ray.org = xfmPoint(world2local, ray_org);
+          ray.dir = xfmVector(world2local, ray_dir);
+          RayQueryContext newcontext((Scene*)object, user_context, context->args);
+          object->intersectors.intersect(valid, ray, &newcontext);
+          ray.org = ray_org;
+          ray.dir = ray_dir;
+          instance_id_stack::pop(user_context);
+        }
+      });
     }
 
     template<int K>
     vbool<K> InstanceArrayIntersectorKMB<K>::occluded(const vbool<K>& valid_i, const Precalculations& pre, RayK<K>& ray, RayQueryContext* context, const Primitive& prim)
     {
-      vbool<K> valid = valid_i;
       const InstanceArray* instance = context->scene->get<InstanceArray>(prim.instID_);
-      Accel* object = instance->getObject(prim.primID_);
-      if (!object) return false;
-
-      /* perform ray mask test */
-#if defined(EMBREE_RAY_MASK)
-      valid &= (ray.mask & instance->mask) != 0;
-      if (none(valid)) return false;
-#endif
-        
-      RTCRayQueryContext* user_context = context->user;
       vbool<K> occluded = false;
-      if (likely(instance_id_stack::push(user_context, prim.instID_, prim.primID_)))
+      foreachLOD<K>(valid_i, ray, instance, prim.primID_, [&] (vbool<K> valid, Accel* object)
       {
-        AffineSpace3vf<K> world2local = instance->getWorld2Local<K>(prim.primID_, valid, ray.time());
-        const Vec3vf<K> ray_org = ray.org;
-        const Vec3vf<K> ray_dir = ray.dir;
-        ray.org = xfmPoint(world2local, ray_org);
-        ray.dir = xfmVector(world2local, ray_dir);
-        RayQueryContext newcontext((Scene*)object, user_context, context->args);
-        object->intersectors.occluded(valid, ray, &newcontext);
-        ray.org = ray_org;
-        ray.dir = ray_dir;
-        occluded = ray.tfar < 0.0f;
-        instance_id_stack::pop(user_context);
-      }
+        /* perform ray mask test */
+#if defined(EMBREE_RAY_MASK)
+        valid &= (ray.mask & instance->mask) != 0;
+        valid &= (ray.mask & ((Scene*)object)->getGeometryMask()) != 0;
+        if (none(valid)) return;
+#endif
+
+        RTCRayQueryContext* user_context = context->user;
+        if (likely(instance_id_stack::push(user_context, prim.instID_, prim.primID_)))
+        {
+          AffineSpace3vf<K> world2local = instance->getWorld2Local<K>(prim.primID_, valid, ray.time());
+          const Vec3vf<K> ray_org = ray.org;
+          const Vec3vf<K> ray_dir = ray.dir;
+          ray.org = xfmPoint(world2local, ray_org);
+          ray.dir = xfmVector(world2local, ray_dir);
+          RayQueryContext newcontext((Scene*)object, user_context, context->args);
+          object->intersectors.occluded(valid, ray, &newcontext);
+          ray.org = ray_org;
+          ray.dir = ray_dir;
+          occluded |= ray.tfar < 0.0f;
+          instance_id_stack::pop(user_context);
+        }
+      });
       return occluded;
     }
 
@@ -18,7 +18,7 @@ namespace embree
 
       /* perform ray mask test */
 #if defined(EMBREE_RAY_MASK)
-      if ((ray.mask & instance->mask) == 0) 
+      if ((ray.mask & instance->mask) == 0 || (ray.mask & ((Scene*)instance->object)->getGeometryMask()) == 0)
         return;
 #endif
       RTCRayQueryContext* user_context = context->user;
@@ -43,7 +43,7 @@ namespace embree
       
       /* perform ray mask test */
 #if defined(EMBREE_RAY_MASK)
-      if ((ray.mask & instance->mask) == 0) 
+      if ((ray.mask & instance->mask) == 0 || (ray.mask & ((Scene*)instance->object)->getGeometryMask()) == 0)
         return false;
 #endif
       
@@ -69,6 +69,8 @@ namespace embree
     bool InstanceIntersector1::pointQuery(PointQuery* query, PointQueryContext* context, const InstancePrimitive& prim)
     {
       const Instance* instance = prim.instance;
+      if (unlikely(context->boxQuery))
+        return context->addBoxQueryPrimitive(instance,prim.instID_,0);
 
       const AffineSpace3fa local2world = instance->getLocal2World();
       const AffineSpace3fa world2local = instance->getWorld2Local();
@@ -93,6 +95,7 @@ namespace embree
           similarityScale,
           context->userPtr);
 
+        context_inst.closestPoint = context->closestPoint;
         bool changed = instance->object->intersectors.pointQuery(&query_inst, &context_inst);
         instance_id_stack::pop(context->userContext);
         return changed;
@@ -106,7 +109,7 @@ namespace embree
       
       /* perform ray mask test */
 #if defined(EMBREE_RAY_MASK)
-      if ((ray.mask & instance->mask) == 0) 
+      if ((ray.mask & instance->mask) == 0 || (ray.mask & ((Scene*)instance->object)->getGeometryMask()) == 0)
         return;
 #endif
       
@@ -132,7 +135,7 @@ namespace embree
       
       /* perform ray mask test */
 #if defined(EMBREE_RAY_MASK)
-      if ((ray.mask & instance->mask) == 0) 
+      if ((ray.mask & instance->mask) == 0 || (ray.mask & ((Scene*)instance->object)->getGeometryMask()) == 0)
         return false;
 #endif
       
@@ -158,6 +161,8 @@ namespace embree
     bool InstanceIntersector1MB::pointQuery(PointQuery* query, PointQueryContext* context, const InstancePrimitive& prim)
     {
       const Instance* instance = prim.instance;
+      if (unlikely(context->boxQuery))
+        return context->addBoxQueryPrimitive(instance,prim.instID_,0);
 
       const AffineSpace3fa local2world = instance->getLocal2World(query->time);
       const AffineSpace3fa world2local = instance->getWorld2Local(query->time);
@@ -181,6 +186,7 @@ namespace embree
           similarityScale,
           context->userPtr); 
 
+        context_inst.closestPoint = context->closestPoint;
         bool changed = instance->object->intersectors.pointQuery(&query_inst, &context_inst);
         instance_id_stack::pop(context->userContext);
         return changed;
@@ -197,6 +203,7 @@ namespace embree
       /* perform ray mask test */
 #if defined(EMBREE_RAY_MASK)
       valid &= (ray.mask & instance->mask) != 0;
+      valid &= (ray.mask & ((Scene*)instance->object)->getGeometryMask()) != 0;
       if (none(valid)) return;
 #endif
         
@@ -225,6 +232,7 @@ namespace embree
       /* perform ray mask test */
 #if defined(EMBREE_RAY_MASK)
       valid &= (ray.mask & instance->mask) != 0;
+      valid &= (ray.mask & ((Scene*)instance->object)->getGeometryMask()) != 0;
       if (none(valid)) return false;
 #endif
         
@@ -256,6 +264,7 @@ namespace embree
       /* perform ray mask test */
 #if defined(EMBREE_RAY_MASK)
       valid &= (ray.mask & instance->mask) != 0;
+      valid &= (ray.mask & ((Scene*)instance->object)->getGeometryMask()) != 0;
       if (none(valid)) return;
 #endif
         
@@ -284,6 +293,7 @@ namespace embree
       /* perform ray mask test */
 #if defined(EMBREE_RAY_MASK)
       valid &= (ray.mask & instance->mask) != 0;
+      valid &= (ray.mask & ((Scene*)instance->object)->getGeometryMask()) != 0;
       if (none(valid)) return false;
 #endif
         
@@ -16,6 +16,23 @@ namespace embree
       __forceinline void operator() (vfloat<M>& u, vfloat<M>& v, Vec3vf<M>& Ng) const {}
     };
 
+    /* looks up the opacity micromap states of the hits of a ray packet */
+    template<int K>
+    __forceinline void opacityMicromapStates(const vbool<K>& valid, const Geometry* geometry, unsigned int primID,
+                                             const vfloat<K>& u, const vfloat<K>& v, vbool<K>& transparent, vbool<K>& opaque)
+    {
+      const TriangleMesh* mesh = (const TriangleMesh*) geometry;
+      int mtransparent = 0, mopaque = 0;
+      for (size_t m=movemask(valid), k=bsf(m); m!=0; m=btc(m,k), k=bsf(m))
+      {
+        const RTCOpacityMicromapState state = mesh->opacityMicromapState(primID,u[k],v[k]);
+        if      (state == RTC_OPACITY_MICROMAP_STATE_TRANSPARENT) mtransparent |= 1 << k;
+        else if (state == RTC_OPACITY_MICROMAP_STATE_OPAQUE     ) mopaque      |= 1 << k;
+      }
+      transparent = vbool<K>(mtransparent);
+      opaque = vbool<K>(mopaque);
+    }
+
 
     template<bool filter>
     struct Intersect1Epilog1
@@ -50,7 +67,7 @@ namespace embree
             const float old_t = ray.tfar;
             ray.tfar = hit.t;
             bool found = runIntersectionFilter1(geometry,ray,context,h);
-            if (!found) ray.tfar = old_t;
+            if (!found) ray.tfar = context->rejectedHitTfar(old_t);
             return found;
           }
         }
@@ -241,7 +258,6 @@ namespace embree
         unsigned int geomID = geomIDs[i];
 
         /* intersection filter test */
-#if defined(EMBREE_FILTER_FUNCTION) || defined(EMBREE_RAY_MASK)
         bool foundhit = false;
         goto entry;
         while (true)
@@ -261,16 +277,42 @@ namespace embree
           }
 #endif
 
+          /* goto next hit if the back side got hit and backface culling is enabled */
+          if (unlikely(geometry->hasBackfaceCulling()) && dot(hit.Ng(i),Vec3fa(ray.dir)) >= 0.0f) {
+            clear(valid,i);
+            continue;
+          }
+
 #if defined(EMBREE_FILTER_FUNCTION) 
           /* call intersection filter function */
           if (filter) {
+            /* ignore transparent and accept opaque micro triangles without calling the filter */
+            if (unlikely(geometry->hasOpacityMicromap())) {
+              const Vec2f uv = hit.uv(i);
+              const RTCOpacityMicromapState state = ((TriangleMesh*)geometry)->opacityMicromapState(primIDs[i],uv.x,uv.y);
+              if (state == RTC_OPACITY_MICROMAP_STATE_TRANSPARENT) {
+                clear(valid,i);
+                continue;
+              }
+              if (state == RTC_OPACITY_MICROMAP_STATE_OPAQUE)
+              {
+                if (likely(context->hitList == nullptr)) break;
+
+                /* multi-hit queries record opaque hits without calling the filter */
+                insertIntoHitList(context->hitList,hit.t(i),HitK<1>(context->user,geomID,primIDs[i],uv.x,uv.y,hit.Ng(i)));
+                ray.tfar = context->rejectedHitTfar(ray.tfar);
+                clear(valid,i);
+                valid &= hit.vt <= ray.tfar;
+                continue;
+              }
+            }
             if (unlikely(context->hasContextFilter() || geometry->hasIntersectionFilter())) {
               const Vec2f uv = hit.uv(i);
               HitK<1> h(context->user,geomID,primIDs[i],uv.x,uv.y,hit.Ng(i));
               const float old_t = ray.tfar;
               ray.tfar = hit.t(i);
               const bool found = runIntersectionFilter1(geometry,ray,context,h);
-              if (!found) ray.tfar = old_t;
+              if (!found) ray.tfar = context->rejectedHitTfar(old_t);
               foundhit |= found;
               clear(valid,i);
               valid &= hit.vt <= ray.tfar; // intersection filters may modify tfar value
@@ -280,7 +322,6 @@ namespace embree
 #endif
           break;
         }
-#endif
 
         /* update hit information */
         const Vec2f uv = hit.uv(i);
@@ -320,9 +361,11 @@ namespace embree
       {
         Scene* scene MAYBE_UNUSED = context->scene;
         /* intersection filter test */
-#if defined(EMBREE_FILTER_FUNCTION) || defined(EMBREE_RAY_MASK)
-        if (unlikely(filter))
+        bool finalized = false;
+        if (unlikely(filter)) {
           hit.finalize(); /* called only once */
+          finalized = true;
+        }
 
         vbool<M> valid = valid_i;
         size_t m=movemask(valid);
@@ -344,9 +387,28 @@ namespace embree
           }
 #endif
 
+          /* goto next hit if the back side got hit and backface culling is enabled */
+          if (unlikely(geometry->hasBackfaceCulling())) {
+            if (!finalized) { hit.finalize(); finalized = true; }
+            if (dot(hit.Ng(i),Vec3fa(ray.dir)) >= 0.0f) {
+              m=btc(m,i);
+              continue;
+            }
+          }
+
 #if defined(EMBREE_FILTER_FUNCTION)
           /* if we have no filter then the test passed */
           if (filter) {
+            /* ignore transparent and accept opaque micro triangles without calling the filter */
+            if (unlikely(geometry->hasOpacityMicromap())) {
+              const Vec2f uv = hit.uv(i);
+              const RTCOpacityMicromapState state = ((TriangleMesh*)geometry)->opacityMicromapState(primIDs[i],uv.x,uv.y);
+              if (state == RTC_OPACITY_MICROMAP_STATE_TRANSPARENT) {
+                m=btc(m,i);
+                continue;
+              }
+              if (state == RTC_OPACITY_MICROMAP_STATE_OPAQUE) break;
+            }
             if (unlikely(context->hasContextFilter() || geometry->hasOcclusionFilter()))
             {
               const Vec2f uv = hit.uv(i);
@@ -362,7 +424,6 @@ namespace embree
 #endif
           break;
         }
-#endif
 
         return true;
       }
@@ -410,7 +471,7 @@ namespace embree
             ray.tfar = hit.t(i);
             HitK<1> h(context->user,geomID,primID,uv.x,uv.y,hit.Ng(i));
             const bool found = runIntersectionFilter1(geometry,ray,context,h);
-            if (!found) ray.tfar = old_t;
+            if (!found) ray.tfar = context->rejectedHitTfar(old_t);
             foundhit |= found;
             clear(valid,i);
             valid &= hit.vt <= ray.tfar; // intersection filters may modify tfar value
@@ -522,16 +583,35 @@ namespace embree
         if (unlikely(none(valid))) return false;
 #endif
 
+        /* backface culling test */
+        if (unlikely(geometry->hasBackfaceCulling())) {
+          valid &= dot(Ng,ray.dir) < 0.0f;
+          if (unlikely(none(valid))) return false;
+        }
+
         /* occlusion filter test */
+        vbool<K> m_filtered(false);
 #if defined(EMBREE_FILTER_FUNCTION)
         if (filter) {
+          /* ignore transparent and accept opaque micro triangles without calling the filter */
+          vbool<K> opaque(false);
+          if (unlikely(geometry->hasOpacityMicromap())) {
+            vbool<K> transparent;
+            opacityMicromapStates<K>(valid,geometry,primID,u,v,transparent,opaque);
+            valid &= !transparent;
+            if (unlikely(none(valid))) return valid;
+          }
           if (unlikely(context->hasContextFilter() || geometry->hasIntersectionFilter())) {
-            HitK<K> h(context->user,geomID,primID,u,v,Ng);
-            const vfloat<K> old_t = ray.tfar;
-            ray.tfar = select(valid,t,ray.tfar);
-            const vbool<K> m_accept = runIntersectionFilter(valid,geometry,ray,context,h);
-            ray.tfar = select(m_accept,ray.tfar,old_t);
-            return m_accept;
+            const vbool<K> valid_filter = valid & !opaque;
+            if (any(valid_filter)) {
+              HitK<K> h(context->user,geomID,primID,u,v,Ng);
+              const vfloat<K> old_t = ray.tfar;
+              ray.tfar = select(valid_filter,t,ray.tfar);
+              m_filtered = runIntersectionFilter(valid_filter,geometry,ray,context,h);
+              ray.tfar = select(m_filtered,ray.tfar,old_t);
+            }
+            if (likely(none(opaque))) return m_filtered;
+            valid = opaque;
           }
         }
 #endif
@@ -549,7 +629,7 @@ namespace embree
 #if defined(RTC_GEOMETRY_INSTANCE_ARRAY)
         instance_id_stack::copy_UV<K>(context->user->instPrimID, ray.instPrimID, valid);
 #endif
-        return valid;
+        return valid | m_filtered;
       }
     };
     
@@ -586,19 +666,44 @@ namespace embree
         if (unlikely(none(valid))) return valid;
 #endif
 
+        /* backface culling test */
+        if (unlikely(geometry->hasBackfaceCulling())) {
+          vfloat<K> u, v, t;
+          Vec3vf<K> Ng;
+          std::tie(u,v,t,Ng) = hit();
+          valid &= dot(Ng,ray.dir) < 0.0f;
+          if (unlikely(none(valid))) return valid;
+        }
+
         /* intersection filter test */
 #if defined(EMBREE_FILTER_FUNCTION)
         if (filter) {
-          if (unlikely(context->hasContextFilter() || geometry->hasOcclusionFilter()))
-          {
+          /* ignore transparent and accept opaque micro triangles without calling the filter */
+          vbool<K> opaque(false);
+          if (unlikely(geometry->hasOpacityMicromap())) {
             vfloat<K> u, v, t;
             Vec3vf<K> Ng;
             std::tie(u,v,t,Ng) = hit();
-            HitK<K> h(context->user,geomID,primID,u,v,Ng);
-            const vfloat<K> old_t = ray.tfar;
-            ray.tfar = select(valid,t,ray.tfar);
-            valid = runOcclusionFilter(valid,geometry,ray,context,h);
-            ray.tfar = select(valid,ray.tfar,old_t);
+            vbool<K> transparent;
+            opacityMicromapStates<K>(valid,geometry,primID,u,v,transparent,opaque);
+            valid &= !transparent;
+            if (unlikely(none(valid))) return valid;
+          }
+          if (unlikely(context->hasContextFilter() || geometry->hasOcclusionFilter()))
+          {
+            const vbool<K> valid_filter = valid & !opaque;
+            valid = opaque;
+            if (any(valid_filter)) {
+              vfloat<K> u, v, t;
+              Vec3vf<K> Ng;
+              std::tie(u,v,t,Ng) = hit();
+              HitK<K> h(context->user,geomID,primID,u,v,Ng);
+              const vfloat<K> old_t = ray.tfar;
+              ray.tfar = select(valid_filter,t,ray.tfar);
+              const vbool<K> m_accept = runOcclusionFilter(valid_filter,geometry,ray,context,h);
+              ray.tfar = select(m_accept,ray.tfar,old_t);
+              valid |= m_accept;
+            }
           }
         }
 #endif
@@ -748,7 +853,6 @@ namespace embree
         unsigned int geomID = geomIDs[i];
 
         /* intersection filter test */
-#if defined(EMBREE_FILTER_FUNCTION) || defined(EMBREE_RAY_MASK)
         bool foundhit = false;
         goto entry;
         while (true)
@@ -768,9 +872,25 @@ namespace embree
           }
 #endif
 
+          /* goto next hit if the back side got hit and backface culling is enabled */
+          if (unlikely(geometry->hasBackfaceCulling()) && dot(hit.Ng(i),Vec3fa(ray.dir.x[k],ray.dir.y[k],ray.dir.z[k])) >= 0.0f) {
+            clear(valid,i);
+            continue;
+          }
+
 #if defined(EMBREE_FILTER_FUNCTION) 
           /* call intersection filter function */
           if (filter) {
+            /* ignore transparent and accept opaque micro triangles without calling the filter */
+            if (unlikely(geometry->hasOpacityMicromap())) {
+              const Vec2f uv = hit.uv(i);
+              const RTCOpacityMicromapState state = ((TriangleMesh*)geometry)->opacityMicromapState(primIDs[i],uv.x,uv.y);
+              if (state == RTC_OPACITY_MICROMAP_STATE_TRANSPARENT) {
+                clear(valid,i);
+                continue;
+              }
+              if (state == RTC_OPACITY_MICROMAP_STATE_OPAQUE) break;
+            }
             if (unlikely(context->hasContextFilter() || geometry->hasIntersectionFilter())) {
               assert(i<M);
               const Vec2f uv = hit.uv(i);
@@ -788,7 +908,6 @@ namespace embree
 #endif
           break;
         }
-#endif
         assert(i<M);
         /* update hit information */
         const Vec2f uv = hit.uv(i);
@@ -829,9 +948,11 @@ namespace embree
         Scene* scene MAYBE_UNUSED = context->scene;
 
         /* intersection filter test */
-#if defined(EMBREE_FILTER_FUNCTION) || defined(EMBREE_RAY_MASK)
-        if (unlikely(filter))
+        bool finalized = false;
+        if (unlikely(filter)) {
           hit.finalize(); /* called only once */
+          finalized = true;
+        }
 
         vbool<M> valid = valid_i;
         size_t m=movemask(valid);
@@ -853,9 +974,28 @@ namespace embree
           }
 #endif
 
+          /* goto next hit if the back side got hit and backface culling is enabled */
+          if (unlikely(geometry->hasBackfaceCulling())) {
+            if (!finalized) { hit.finalize(); finalized = true; }
+            if (dot(hit.Ng(i),Vec3fa(ray.dir.x[k],ray.dir.y[k],ray.dir.z[k])) >= 0.0f) {
+              m=btc(m,i);
+              continue;
+            }
+          }
+
 #if defined(EMBREE_FILTER_FUNCTION)
           /* execute occlusion filer */
           if (filter) {
+            /* ignore transparent and accept opaque micro triangles without calling the filter */
+            if (unlikely(geometry->hasOpacityMicromap())) {
+              const Vec2f uv = hit.uv(i);
+              const RTCOpacityMicromapState state = ((TriangleMesh*)geometry)->opacityMicromapState(primIDs[i],uv.x,uv.y);
+              if (state == RTC_OPACITY_MICROMAP_STATE_TRANSPARENT) {
+                m=btc(m,i);
+                continue;
+              }
+              if (state == RTC_OPACITY_MICROMAP_STATE_OPAQUE) break;
+            }
             if (unlikely(context->hasContextFilter() || geometry->hasOcclusionFilter()))
             {
               const Vec2f uv = hit.uv(i);
@@ -871,7 +1011,6 @@ namespace embree
 #endif
           break;
         }
-#endif
         return true;
       }
     };
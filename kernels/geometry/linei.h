@@ -703,9 +703,175 @@ namespace embree
   
 #endif
   
+#if defined(__AVX512F__)
+
+  template<>
+    __forceinline void LineMi<16>::gather(Vec4vf16& p0,
+                                          Vec4vf16& p1,
+                                          const LineSegments* geom) const
+  {
+    vfloat4 a[16], b[16];
+    for (size_t i=0; i<16; i++) {
+      a[i] = vfloat4::loadu(geom->vertexPtr(v0[i]));
+      b[i] = vfloat4::loadu(geom->vertexPtr(v0[i]+1));
+    }
+    transpose(a[0],a[1],a[2],a[3],a[4],a[5],a[6],a[7],a[8],a[9],a[10],a[11],a[12],a[13],a[14],a[15],
+              p0.x,p0.y,p0.z,p0.w);
+    transpose(b[0],b[1],b[2],b[3],b[4],b[5],b[6],b[7],b[8],b[9],b[10],b[11],b[12],b[13],b[14],b[15],
+              p1.x,p1.y,p1.z,p1.w);
+  }
+
+  template<>
+  __forceinline void LineMi<16>::gatheri(Vec4vf16& p0,
+                                         Vec4vf16& p1,
+                                         const LineSegments* geom,
+                                         const int itime) const
+  {
+    vfloat4 a[16], b[16];
+    for (size_t i=0; i<16; i++) {
+      a[i] = vfloat4::loadu(geom->vertexPtr(v0[i],itime));
+      b[i] = vfloat4::loadu(geom->vertexPtr(v0[i]+1,itime));
+    }
+    transpose(a[0],a[1],a[2],a[3],a[4],a[5],a[6],a[7],a[8],a[9],a[10],a[11],a[12],a[13],a[14],a[15],
+              p0.x,p0.y,p0.z,p0.w);
+    transpose(b[0],b[1],b[2],b[3],b[4],b[5],b[6],b[7],b[8],b[9],b[10],b[11],b[12],b[13],b[14],b[15],
+              p1.x,p1.y,p1.z,p1.w);
+  }
+
+  template<>
+    __forceinline void LineMi<16>::gather(Vec4vf16& p0,
+                                          Vec4vf16& p1,
+                                          const LineSegments* geom,
+                                          float time) const
+  {
+    float ftime;
+    const int itime = geom->timeSegment(time, ftime);
+
+    Vec4vf16 a0,a1;
+    gatheri(a0,a1,geom,itime);
+    Vec4vf16 b0,b1;
+    gatheri(b0,b1,geom,itime+1);
+    p0 = lerp(a0,b0,vfloat16(ftime));
+    p1 = lerp(a1,b1,vfloat16(ftime));
+  }
+
+  template<>
+    __forceinline void LineMi<16>::gather(Vec4vf16& p0,
+                                          Vec4vf16& p1,
+                                          Vec4vf16& pL,
+                                          Vec4vf16& pR,
+                                          const LineSegments* geom) const
+  {
+    gather(p0,p1,geom);
+
+    vfloat4 l[16], r[16];
+    for (size_t i=0; i<16; i++) {
+      l[i] = (leftExists  & (1<<i)) ? vfloat4::loadu(geom->vertexPtr(v0[i]-1)) : vfloat4(inf);
+      r[i] = (rightExists & (1<<i)) ? vfloat4::loadu(geom->vertexPtr(v0[i]+2)) : vfloat4(inf);
+    }
+    transpose(l[0],l[1],l[2],l[3],l[4],l[5],l[6],l[7],l[8],l[9],l[10],l[11],l[12],l[13],l[14],l[15],
+              pL.x,pL.y,pL.z,pL.w);
+    transpose(r[0],r[1],r[2],r[3],r[4],r[5],r[6],r[7],r[8],r[9],r[10],r[11],r[12],r[13],r[14],r[15],
+              pR.x,pR.y,pR.z,pR.w);
+  }
+
+  template<>
+    __forceinline void LineMi<16>::gatheri(Vec4vf16& p0,
+                                           Vec4vf16& p1,
+                                           Vec4vf16& pL,
+                                           Vec4vf16& pR,
+                                           const LineSegments* geom,
+                                           const int itime) const
+  {
+    gatheri(p0,p1,geom,itime);
+
+    vfloat4 l[16], r[16];
+    for (size_t i=0; i<16; i++) {
+      l[i] = (leftExists  & (1<<i)) ? vfloat4::loadu(geom->vertexPtr(v0[i]-1,itime)) : vfloat4(inf);
+      r[i] = (rightExists & (1<<i)) ? vfloat4::loadu(geom->vertexPtr(v0[i]+2,itime)) : vfloat4(inf);
+    }
+    transpose(l[0],l[1],l[2],l[3],l[4],l[5],l[6],l[7],l[8],l[9],l[10],l[11],l[12],l[13],l[14],l[15],
+              pL.x,pL.y,pL.z,pL.w);
+    transpose(r[0],r[1],r[2],r[3],r[4],r[5],r[6],r[7],r[8],r[9],r[10],r[11],r[12],r[13],r[14],r[15],
+              pR.x,pR.y,pR.z,pR.w);
+  }
+
+  template<>
+    __forceinline void LineMi<16>::gather(Vec4vf16& p0,
+                                          Vec4vf16& p1,
+                                          Vec4vf16& pL,
+                                          Vec4vf16& pR,
+                                          const LineSegments* geom,
+                                          float time) const
+  {
+    float ftime;
+    const int itime = geom->timeSegment(time, ftime);
+
+    Vec4vf16 a0,a1,aL,aR;
+    gatheri(a0,a1,aL,aR,geom,itime);
+    Vec4vf16 b0,b1,bL,bR;
+    gatheri(b0,b1,bL,bR,geom,itime+1);
+    p0 = lerp(a0,b0,vfloat16(ftime));
+    p1 = lerp(a1,b1,vfloat16(ftime));
+    pL = lerp(aL,bL,vfloat16(ftime));
+    pR = lerp(aR,bR,vfloat16(ftime));
+
+    pL = select(vboolf16(leftExists), pL, Vec4vf16(inf));
+    pR = select(vboolf16(rightExists), pR, Vec4vf16(inf));
+  }
+
+  template<>
+    __forceinline void LineMi<16>::gather(Vec4vf16& p0,
+                                          Vec4vf16& p1,
+                                          vbool16& cL,
+                                          vbool16& cR,
+                                          const LineSegments* geom) const
+  {
+    gather(p0,p1,geom);
+    cL = !vbool16(leftExists);
+    cR = !vbool16(rightExists);
+  }
+
+  template<>
+    __forceinline void LineMi<16>::gatheri(Vec4vf16& p0,
+                                           Vec4vf16& p1,
+                                           vbool16& cL,
+                                           vbool16& cR,
+                                           const LineSegments* geom,
+                                           const int itime) const
+  {
+    gatheri(p0,p1,geom,itime);
+    cL = !vbool16(leftExists);
+    cR = !vbool16(rightExists);
+  }
+
+  template<>
+    __forceinline void LineMi<16>::gather(Vec4vf16& p0,
+                                          Vec4vf16& p1,
+                                          vbool16& cL,
+                                          vbool16& cR,
+                                          const LineSegments* geom,
+                                          float time) const
+  {
+    float ftime;
+    const int itime = geom->timeSegment(time, ftime);
+
+    Vec4vf16 a0,a1;
+    gatheri(a0,a1,geom,itime);
+    Vec4vf16 b0,b1;
+    gatheri(b0,b1,geom,itime+1);
+    p0 = lerp(a0,b0,vfloat16(ftime));
+    p1 = lerp(a1,b1,vfloat16(ftime));
+    cL = !vbool16(leftExists);
+    cR = !vbool16(rightExists);
+  }
+
+#endif
+
   template<int M>
   typename LineMi<M>::Type LineMi<M>::type;
 
   typedef LineMi<4> Line4i;
   typedef LineMi<8> Line8i;
+  typedef LineMi<16> Line16i;
 }
@@ -403,10 +403,85 @@ namespace embree
   }
 #endif
 
+#if defined(__AVX512F__)
+
+  template<>
+  __forceinline void PointMi<16>::gather(Vec4vf16& p0, const Points* geom) const
+  {
+    vfloat4 a[16];
+    for (size_t i = 0; i < 16; i++)
+      a[i] = vfloat4::loadu(geom->vertexPtr(primID(i)));
+    transpose(a[0],a[1],a[2],a[3],a[4],a[5],a[6],a[7],a[8],a[9],a[10],a[11],a[12],a[13],a[14],a[15],
+              p0.x, p0.y, p0.z, p0.w);
+  }
+
+  template<>
+  __forceinline void PointMi<16>::gather(Vec4vf16& p0, Vec3vf16& n0, const Points* geom) const
+  {
+    gather(p0, geom);
+    vfloat4 b[16];
+    for (size_t i = 0; i < 16; i++)
+      b[i] = vfloat4(geom->normal(primID(i)));
+    vfloat16 nw;
+    transpose(b[0],b[1],b[2],b[3],b[4],b[5],b[6],b[7],b[8],b[9],b[10],b[11],b[12],b[13],b[14],b[15],
+              n0.x, n0.y, n0.z, nw);
+  }
+
+  template<>
+  __forceinline void PointMi<16>::gatheri(Vec4vf16& p0, const Points* geom, const int itime) const
+  {
+    vfloat4 a[16];
+    for (size_t i = 0; i < 16; i++)
+      a[i] = vfloat4::loadu(geom->vertexPtr(primID(i), itime));
+    transpose(a[0],a[1],a[2],a[3],a[4],a[5],a[6],a[7],a[8],a[9],a[10],a[11],a[12],a[13],a[14],a[15],
+              p0.x, p0.y, p0.z, p0.w);
+  }
+
+  template<>
+  __forceinline void PointMi<16>::gatheri(Vec4vf16& p0, Vec3vf16& n0, const Points* geom, const int itime) const
+  {
+    gatheri(p0, geom, itime);
+    vfloat4 b[16];
+    for (size_t i = 0; i < 16; i++)
+      b[i] = vfloat4(geom->normal((size_t)primID(i), (size_t)itime));
+    vfloat16 nw;
+    transpose(b[0],b[1],b[2],b[3],b[4],b[5],b[6],b[7],b[8],b[9],b[10],b[11],b[12],b[13],b[14],b[15],
+              n0.x, n0.y, n0.z, nw);
+  }
+
+  template<>
+  __forceinline void PointMi<16>::gather(Vec4vf16& p0, const Points* geom, float time) const
+  {
+    float ftime;
+    const int itime = geom->timeSegment(time, ftime);
+
+    Vec4vf16 a0;
+    gatheri(a0, geom, itime);
+    Vec4vf16 b0;
+    gatheri(b0, geom, itime + 1);
+    p0 = lerp(a0, b0, vfloat16(ftime));
+  }
+
+  template<>
+  __forceinline void PointMi<16>::gather(Vec4vf16& p0, Vec3vf16& n0, const Points* geom, float time) const
+  {
+    float ftime;
+    const int itime = geom->timeSegment(time, ftime);
+
+    Vec4vf16 a0, b0;
+    Vec3vf16 norm0, norm1;
+    gatheri(a0, norm0, geom, itime);
+    gatheri(b0, norm1, geom, itime + 1);
+    p0 = lerp(a0, b0, vfloat16(ftime));
+    n0 = lerp(norm0, norm1, vfloat16(ftime));
+  }
+#endif
+
   template<int M>
   typename PointMi<M>::Type PointMi<M>::type;
 
   typedef PointMi<4> Point4i;
   typedef PointMi<8> Point8i;
+  typedef PointMi<16> Point16i;
   
 }  // namespace embree
@@ -0,0 +1,43 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "primitive.h"
+#include "curveNi.h"
+#include "linei.h"
+
+namespace embree
+{
+  /********************** Curve16i **************************/
+
+  template<>
+  const char* Curve16i::Type::name () const {
+    return "curve16i";
+  }
+
+  template<>
+  size_t Curve16i::Type::sizeActive(const char* This) const
+  {
+    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+      return ((Line16i*)This)->size();
+    else
+      return ((Curve16i*)This)->N;
+  }
+
+  template<>
+  size_t Curve16i::Type::sizeTotal(const char* This) const
+  {
+    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+      return 16;
+    else
+      return ((Curve16i*)This)->N;
+  }
+
+  template<>
+  size_t Curve16i::Type::getBytes(const char* This) const
+  {
+    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+       return Line16i::bytes(sizeActive(This));
+     else
+       return Curve16i::bytes(sizeActive(This));
+  }
+}
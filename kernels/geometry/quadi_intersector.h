@@ -6,6 +6,7 @@
 #include "quadi.h"
 #include "quad_intersector_moeller.h"
 #include "quad_intersector_pluecker.h"
+#include "closest_point.h"
 
 namespace embree
 {
@@ -36,6 +37,8 @@ namespace embree
 
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& quad)
       {
+        if (unlikely(context->closestPoint))
+          return ClosestPointQuery::pointQuery(query, context, quad);
         return PrimitivePointQuery1<Primitive>::pointQuery(query, context, quad);
       }
     };
@@ -124,6 +127,8 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& quad)
       {
+        if (unlikely(context->closestPoint))
+          return ClosestPointQuery::pointQuery(query, context, quad);
         return PrimitivePointQuery1<Primitive>::pointQuery(query, context, quad);
       }
     };
@@ -212,6 +217,8 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& quad)
       {
+        if (unlikely(context->closestPoint))
+          return ClosestPointQuery::pointQueryMB(query, context, quad);
         return PrimitivePointQuery1<Primitive>::pointQuery(query, context, quad);
       }
     };
@@ -292,6 +299,8 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& quad)
       {
+        if (unlikely(context->closestPoint))
+          return ClosestPointQuery::pointQueryMB(query, context, quad);
         return PrimitivePointQuery1<Primitive>::pointQuery(query, context, quad);
       }
     };
@@ -6,6 +6,7 @@
 #include "quadv.h"
 #include "quad_intersector_moeller.h"
 #include "quad_intersector_pluecker.h"
+#include "closest_point.h"
 
 namespace embree
 {
@@ -34,6 +35,8 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& quad)
       {
+        if (unlikely(context->closestPoint))
+          return ClosestPointQuery::pointQuery(query, context, quad);
         return PrimitivePointQuery1<Primitive>::pointQuery(query, context, quad);
       }
     };
@@ -117,6 +120,8 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& quad)
       {
+        if (unlikely(context->closestPoint))
+          return ClosestPointQuery::pointQuery(query, context, quad);
         return PrimitivePointQuery1<Primitive>::pointQuery(query, context, quad);
       }
     };
@@ -6,6 +6,7 @@
 #include "subgrid.h"
 #include "subgrid_intersector_moeller.h"
 #include "subgrid_intersector_pluecker.h"
+#include "closest_point.h"
 
 namespace embree
 {
@@ -45,6 +46,8 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const SubGrid& subgrid)
       {
+        if (unlikely(context->closestPoint))
+          return ClosestPointQuery::pointQuery(query, context, subgrid);
         STAT3(point_query.trav_prims,1,1,1);
         AccelSet* accel = (AccelSet*)context->scene->get(subgrid.geomID());
         assert(accel);
@@ -148,6 +151,8 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const SubGrid& subgrid)
       {
+        if (unlikely(context->closestPoint))
+          return ClosestPointQuery::pointQuery(query, context, subgrid);
         STAT3(point_query.trav_prims,1,1,1);
         AccelSet* accel = (AccelSet*)context->scene->get(subgrid.geomID());
         context->geomID = subgrid.geomID();
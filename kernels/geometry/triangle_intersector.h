@@ -5,6 +5,7 @@
 
 #include "triangle.h"
 #include "triangle_intersector_moeller.h"
+#include "closest_point.h"
 
 namespace embree
 {
@@ -33,6 +34,8 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& tri)
       {
+        if (unlikely(context->closestPoint))
+          return ClosestPointQuery::pointQuery(query, context, tri);
         return PrimitivePointQuery1<Primitive>::pointQuery(query, context, tri);
       }
       
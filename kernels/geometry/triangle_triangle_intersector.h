@@ -63,6 +63,36 @@ namespace embree
         return false;
       }
       
+      /* conservative test of one triangle against M triangles, rejects all triangle pairs
+       * that do not cross each others plane, the same way as intersect_triangle_triangle does */
+      template<int M>
+      __forceinline static vbool<M> cull_triangle_triangle (const Vec3fa& a0, const Vec3fa& a1, const Vec3fa& a2,
+                                                            const Vec3vf<M>& b0, const Vec3vf<M>& b1, const Vec3vf<M>& b2)
+      {
+        const float eps = 1E-5f;
+        const Vec3vf<M> A0(a0), A1(a1), A2(a2);
+
+        /* calculate triangle planes */
+        const Vec3fa Na = cross(a1-a0,a2-a0);
+        const Vec3vf<M> NA(Na);
+        const vfloat<M> Ca = dot(Na,a0);
+        const Vec3vf<M> Nb = cross(b1-b0,b2-b0);
+        const vfloat<M> Cb = dot(Nb,b0);
+
+        /* project triangle A onto plane B */
+        const vfloat<M> da0 = dot(Nb,A0)-Cb;
+        const vfloat<M> da1 = dot(Nb,A1)-Cb;
+        const vfloat<M> da2 = dot(Nb,A2)-Cb;
+        vbool<M> valid = (max(da0,da1,da2) >= -eps) & (min(da0,da1,da2) <= +eps);
+
+        /* project triangle B onto plane A */
+        const vfloat<M> db0 = dot(NA,b0)-Ca;
+        const vfloat<M> db1 = dot(NA,b1)-Ca;
+        const vfloat<M> db2 = dot(NA,b2)-Ca;
+        valid &= (max(db0,db1,db2) >= -eps) & (min(db0,db1,db2) <= +eps);
+        return valid;
+      }
+
       static bool intersect_triangle_triangle (const Vec3fa& a0, const Vec3fa& a1, const Vec3fa& a2,
                                                const Vec3fa& b0, const Vec3fa& b1, const Vec3fa& b2)
       {
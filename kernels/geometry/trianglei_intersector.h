@@ -6,6 +6,7 @@
 #include "trianglei.h"
 #include "triangle_intersector_moeller.h"
 #include "triangle_intersector_pluecker.h"
+#include "closest_point.h"
 
 namespace embree
 {
@@ -34,6 +35,8 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& tri)
       {
+        if (unlikely(context->closestPoint))
+          return ClosestPointQuery::pointQuery(query, context, tri);
         return PrimitivePointQuery1<Primitive>::pointQuery(query, context, tri);
       }
     };
@@ -115,6 +118,8 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& tri)
       {
+        if (unlikely(context->closestPoint))
+          return ClosestPointQuery::pointQuery(query, context, tri);
         return PrimitivePointQuery1<Primitive>::pointQuery(query, context, tri);
       }
     };
@@ -198,6 +203,8 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& tri)
       {
+        if (unlikely(context->closestPoint))
+          return ClosestPointQuery::pointQueryMB(query, context, tri);
         return PrimitivePointQuery1<Primitive>::pointQuery(query, context, tri);
       }
     };
@@ -278,6 +285,8 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& tri)
       {
+        if (unlikely(context->closestPoint))
+          return ClosestPointQuery::pointQueryMB(query, context, tri);
         return PrimitivePointQuery1<Primitive>::pointQuery(query, context, tri);
       }
     };
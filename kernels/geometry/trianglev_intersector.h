@@ -7,6 +7,7 @@
 #include "triangle_intersector_pluecker.h"
 #include "triangle_intersector_moeller.h"
 #include "triangle_intersector_woop.h"
+#include "closest_point.h"
 
 namespace embree
 {
@@ -35,6 +36,8 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& tri)
       {
+        if (unlikely(context->closestPoint))
+          return ClosestPointQuery::pointQuery(query, context, tri);
         return PrimitivePointQuery1<Primitive>::pointQuery(query, context, tri);
       }
     };
@@ -63,6 +66,8 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& tri)
       {
+        if (unlikely(context->closestPoint))
+          return ClosestPointQuery::pointQuery(query, context, tri);
         return PrimitivePointQuery1<Primitive>::pointQuery(query, context, tri);
       }
     };
@@ -145,6 +150,8 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& tri)
       {
+        if (unlikely(context->closestPoint))
+          return ClosestPointQuery::pointQuery(query, context, tri);
         return PrimitivePointQuery1<Primitive>::pointQuery(query, context, tri);
       }
     };
@@ -5,6 +5,7 @@
 
 #include "triangle.h"
 #include "intersector_epilog.h"
+#include "closest_point.h"
 
 namespace embree
 {
@@ -41,6 +42,8 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& tri)
       {
+        if (unlikely(context->closestPoint))
+          return ClosestPointQuery::pointQuery(query, context, tri);
         return PrimitivePointQuery1<Primitive>::pointQuery(query, context, tri);
       }
     };
@@ -140,6 +143,8 @@ namespace embree
       
       static __forceinline bool pointQuery(PointQuery* query, PointQueryContext* context, const Primitive& tri)
       {
+        if (unlikely(context->closestPoint))
+          return ClosestPointQuery::pointQuery(query, context, tri);
         return PrimitivePointQuery1<Primitive>::pointQuery(query, context, tri);
       }
     };
@@ -61,6 +61,111 @@ namespace embree
       return Vec3<simdf>( zero );
     }
 
+    /* bilinear lookup into the height texture that gets tiled over each patch */
+    static __forceinline vfloatx sampleDisplacementTexture(const SubdivMesh* const geom, const vfloatx& u, const vfloatx& v)
+    {
+      const int width  = (int) geom->displTextureWidth;
+      const int height = (int) geom->displTextureHeight;
+      const vfloatx x = u*float(width) -0.5f;
+      const vfloatx y = v*float(height)-0.5f;
+      const vfloatx fx = floor(x);
+      const vfloatx fy = floor(y);
+      const vfloatx tx = x-fx;
+      const vfloatx ty = y-fy;
+
+      /* wrap texel coordinates, clamping also protects against NaNs in the padding of the grid */
+      const vintx ix0 = clamp(vintx(fx-floor(fx/float(width)) *float(width)), vintx(0), vintx(width-1));
+      const vintx iy0 = clamp(vintx(fy-floor(fy/float(height))*float(height)),vintx(0), vintx(height-1));
+      const vintx ix1 = select(ix0 == vintx(width-1), vintx(0), ix0+1);
+      const vintx iy1 = select(iy0 == vintx(height-1),vintx(0), iy0+1);
+
+      const float* texels = geom->displTexels.data();
+      const vfloatx t00 = vfloatx::gather(texels,iy0*width+ix0);
+      const vfloatx t01 = vfloatx::gather(texels,iy0*width+ix1);
+      const vfloatx t10 = vfloatx::gather(texels,iy1*width+ix0);
+      const vfloatx t11 = vfloatx::gather(texels,iy1*width+ix1);
+      const vfloatx t0 = lerp(t00,t01,tx);
+      const vfloatx t1 = lerp(t10,t11,tx);
+      return geom->displScale*lerp(t0,t1,ty);
+    }
+
+    /* displaces all points of the grid at once, the arrays are padded to the SIMD width */
+    static void displaceGrid(const SubdivPatch1Base& patch, const SubdivMesh* const geom, const unsigned N,
+                             const float* const grid_u, const float* const grid_v,
+                             const float* const grid_Ng_x, const float* const grid_Ng_y, const float* const grid_Ng_z,
+                             float* const grid_x, float* const grid_y, float* const grid_z)
+    {
+      /* displace along the normal using the height texture */
+      if (geom->displTexels.size())
+      {
+        for (unsigned i=0; i<N; i+=VSIZEX)
+        {
+          const vfloatx h = sampleDisplacementTexture(geom,vfloatx::load(&grid_u[i]),vfloatx::load(&grid_v[i]));
+          vfloatx::store(&grid_x[i],madd(h,vfloatx::load(&grid_Ng_x[i]),vfloatx::load(&grid_x[i])));
+          vfloatx::store(&grid_y[i],madd(h,vfloatx::load(&grid_Ng_y[i]),vfloatx::load(&grid_y[i])));
+          vfloatx::store(&grid_z[i],madd(h,vfloatx::load(&grid_Ng_z[i]),vfloatx::load(&grid_z[i])));
+        }
+      }
+
+      /* call displacement shader */
+      if (geom->displFunc)
+      {
+        RTCDisplacementFunctionNArguments args;
+        args.geometryUserPtr = geom->userPtr;
+        args.geometry = (RTCGeometry)geom;
+        //args.geomID = patch.geomID();
+        args.primID = patch.primID();
+        args.timeStep = patch.time();
+        args.u = grid_u;
+        args.v = grid_v;
+        args.Ng_x = grid_Ng_x;
+        args.Ng_y = grid_Ng_y;
+        args.Ng_z = grid_Ng_z;
+        args.P_x = grid_x;
+        args.P_y = grid_y;
+        args.P_z = grid_z;
+        args.N = N;
+        geom->displFunc(&args);
+      }
+    }
+
+    /* calculates the bounds of all points of a padded grid */
+    static BBox3fa gridBounds(const unsigned grid_size_simd_blocks,
+                              const float* const grid_x, const float* const grid_y, const float* const grid_z)
+    {
+      vfloatx bounds_min_x = pos_inf;
+      vfloatx bounds_min_y = pos_inf;
+      vfloatx bounds_min_z = pos_inf;
+      vfloatx bounds_max_x = neg_inf;
+      vfloatx bounds_max_y = neg_inf;
+      vfloatx bounds_max_z = neg_inf;
+      for (unsigned i = 0; i<grid_size_simd_blocks; i++)
+      {
+        vfloatx x = vfloatx::loadu(&grid_x[i * VSIZEX]);
+        vfloatx y = vfloatx::loadu(&grid_y[i * VSIZEX]);
+        vfloatx z = vfloatx::loadu(&grid_z[i * VSIZEX]);
+
+        bounds_min_x = min(bounds_min_x,x);
+        bounds_min_y = min(bounds_min_y,y);
+        bounds_min_z = min(bounds_min_z,z);
+
+        bounds_max_x = max(bounds_max_x,x);
+        bounds_max_y = max(bounds_max_y,y);
+        bounds_max_z = max(bounds_max_z,z);
+      }
+
+      BBox3fa b;
+      b.lower.x = reduce_min(bounds_min_x);  
+      b.lower.y = reduce_min(bounds_min_y);
+      b.lower.z = reduce_min(bounds_min_z);
+      b.upper.x = reduce_max(bounds_max_x);
+      b.upper.y = reduce_max(bounds_max_y);
+      b.upper.z = reduce_max(bounds_max_z);
+      //b.lower.a = 0;
+      //b.upper.a = 0;
+      return b;
+    }
+
     /* eval grid over patch and stich edges when required */      
     void evalGrid(const SubdivPatch1Base& patch,
                   const unsigned x0, const unsigned x1,
@@ -80,7 +185,7 @@ namespace embree
 
       if (unlikely(patch.type == SubdivPatch1Base::EVAL_PATCH))
       {
-        const bool displ = geom->displFunc;
+        const bool displ = geom->hasDisplacement();
         const unsigned N = displ ? M : 0;
         dynamic_large_stack_array(float,grid_Ng_x,N,32*32*sizeof(float));
         dynamic_large_stack_array(float,grid_Ng_y,N,32*32*sizeof(float));
@@ -122,25 +227,9 @@ namespace embree
           vfloatx::store(&grid_v[i*VSIZEX],patch_v);
         }
 
-        /* call displacement shader */
-        if (unlikely(geom->displFunc)) {
-          RTCDisplacementFunctionNArguments args;
-          args.geometryUserPtr = geom->userPtr;
-          args.geometry = (RTCGeometry)geom;
-          //args.geomID = patch.geomID();
-          args.primID = patch.primID();
-          args.timeStep = patch.time();
-          args.u = grid_u;
-          args.v = grid_v;
-          args.Ng_x = grid_Ng_x;
-          args.Ng_y = grid_Ng_y;
-          args.Ng_z = grid_Ng_z;
-          args.P_x = grid_x;
-          args.P_y = grid_y;
-          args.P_z = grid_z;
-          args.N = dwidth*dheight;
-          geom->displFunc(&args);
-        }
+        /* displace the grid */
+        if (unlikely(displ))
+          displaceGrid(patch,geom,dwidth*dheight,grid_u,grid_v,grid_Ng_x,grid_Ng_y,grid_Ng_z,grid_x,grid_y,grid_z);
 
         /* set last elements in u,v array to 1.0f */
         const float last_u = grid_u[dwidth*dheight-1];
@@ -174,6 +263,12 @@ namespace embree
         if (unlikely(patch.needsStitching()))
           stitchUVGrid(patch.level,swidth,sheight,x0,y0,dwidth,dheight,grid_u,grid_v);
       
+        const bool displ = geom->hasDisplacement();
+        const unsigned N = displ ? M : 0;
+        dynamic_large_stack_array(float,grid_Ng_x,N,32*32*sizeof(float));
+        dynamic_large_stack_array(float,grid_Ng_y,N,32*32*sizeof(float));
+        dynamic_large_stack_array(float,grid_Ng_z,N,32*32*sizeof(float));
+
         /* iterates over all grid points */
         for (unsigned i=0; i<grid_size_simd_blocks; i++)
         {
@@ -181,32 +276,35 @@ namespace embree
           const vfloatx v = vfloatx::load(&grid_v[i*VSIZEX]);
           Vec3vfx vtx = patchEval(patch,u,v);
         
-          /* evaluate displacement function */
-          if (unlikely(geom->displFunc != nullptr))
+          /* store normals to displace the full grid at once */
+          if (unlikely(displ))
           {
             const Vec3vfx normal = normalize_safe(patchNormal(patch, u, v));
-            RTCDisplacementFunctionNArguments args;
-            args.geometryUserPtr = geom->userPtr;
-            args.geometry = (RTCGeometry)geom;
-            //args.geomID = patch.geomID();
-            args.primID = patch.primID();
-            args.timeStep = patch.time();
-            args.u = &u[0];
-            args.v = &v[0];
-            args.Ng_x = &normal.x[0];
-            args.Ng_y = &normal.y[0];
-            args.Ng_z = &normal.z[0];
-            args.P_x = &vtx.x[0];
-            args.P_y = &vtx.y[0];
-            args.P_z = &vtx.z[0];
-            args.N = VSIZEX;
-            geom->displFunc(&args);
+            vfloatx::store(&grid_Ng_x[i*VSIZEX],normal.x);
+            vfloatx::store(&grid_Ng_y[i*VSIZEX],normal.y);
+            vfloatx::store(&grid_Ng_z[i*VSIZEX],normal.z);
           }
 
           vfloatx::store(&grid_x[i*VSIZEX],vtx.x);
           vfloatx::store(&grid_y[i*VSIZEX],vtx.y);
           vfloatx::store(&grid_z[i*VSIZEX],vtx.z);
         }
+
+        /* displace the grid and set last elements to last valid point */
+        if (unlikely(displ))
+        {
+          displaceGrid(patch,geom,dwidth*dheight,grid_u,grid_v,grid_Ng_x,grid_Ng_y,grid_Ng_z,grid_x,grid_y,grid_z);
+
+          const float last_x = grid_x[dwidth*dheight-1];
+          const float last_y = grid_y[dwidth*dheight-1];
+          const float last_z = grid_z[dwidth*dheight-1];
+          for (unsigned i=dwidth*dheight;i<grid_size_simd_blocks*VSIZEX;i++)
+          {
+            grid_x[i] = last_x;
+            grid_y[i] = last_y;
+            grid_z[i] = last_z;
+          }
+        }
       }
     }
 
@@ -228,7 +326,7 @@ namespace embree
 
       if (unlikely(patch.type == SubdivPatch1Base::EVAL_PATCH))
       {
-        const bool displ = geom->displFunc;
+        const bool displ = geom->hasDisplacement();
         dynamic_large_stack_array(float,grid_x,M,64*64*sizeof(float));
         dynamic_large_stack_array(float,grid_y,M,64*64*sizeof(float));
         dynamic_large_stack_array(float,grid_z,M,64*64*sizeof(float));
@@ -257,26 +355,9 @@ namespace embree
             dwidth,dheight);
         }
 
-        /* call displacement shader */
-        if (unlikely(geom->displFunc))
-        {
-          RTCDisplacementFunctionNArguments args;
-          args.geometryUserPtr = geom->userPtr;
-          args.geometry = (RTCGeometry)geom;
-          //args.geomID = patch.geomID();
-          args.primID = patch.primID();
-          args.timeStep = patch.time();
-          args.u = grid_u;
-          args.v = grid_v;
-          args.Ng_x = grid_Ng_x;
-          args.Ng_y = grid_Ng_y;
-          args.Ng_z = grid_Ng_z;
-          args.P_x = grid_x;
-          args.P_y = grid_y;
-          args.P_z = grid_z;
-          args.N = dwidth*dheight;
-          geom->displFunc(&args);
-        }
+        /* displace the grid */
+        if (unlikely(displ))
+          displaceGrid(patch,geom,dwidth*dheight,grid_u,grid_v,grid_Ng_x,grid_Ng_y,grid_Ng_z,grid_x,grid_y,grid_z);
 
         /* set last elements in u,v array to 1.0f */
         const float last_u = grid_u[dwidth*dheight-1];
@@ -293,35 +374,16 @@ namespace embree
           grid_z[i] = last_z;
         }
 
-        vfloatx bounds_min_x = pos_inf;
-        vfloatx bounds_min_y = pos_inf;
-        vfloatx bounds_min_z = pos_inf;
-        vfloatx bounds_max_x = neg_inf;
-        vfloatx bounds_max_y = neg_inf;
-        vfloatx bounds_max_z = neg_inf;
-        for (unsigned i = 0; i<grid_size_simd_blocks; i++)
-        {
-          vfloatx x = vfloatx::loadu(&grid_x[i * VSIZEX]);
-          vfloatx y = vfloatx::loadu(&grid_y[i * VSIZEX]);
-          vfloatx z = vfloatx::loadu(&grid_z[i * VSIZEX]);
-
-	  bounds_min_x = min(bounds_min_x,x);
-	  bounds_min_y = min(bounds_min_y,y);
-	  bounds_min_z = min(bounds_min_z,z);
-
-	  bounds_max_x = max(bounds_max_x,x);
-	  bounds_max_y = max(bounds_max_y,y);
-	  bounds_max_z = max(bounds_max_z,z);
-        }
-
-        b.lower.x = reduce_min(bounds_min_x);  
-        b.lower.y = reduce_min(bounds_min_y);
-        b.lower.z = reduce_min(bounds_min_z);
-        b.upper.x = reduce_max(bounds_max_x);
-        b.upper.y = reduce_max(bounds_max_y);
-        b.upper.z = reduce_max(bounds_max_z);
-        //b.lower.a = 0;
-        //b.upper.a = 0;
+        b = gridBounds(grid_size_simd_blocks,grid_x,grid_y,grid_z);
+      }
+      else if (unlikely(geom->hasDisplacement()))
+      {
+        /* displacement requires the full grid */
+        dynamic_large_stack_array(float,grid_x,M,64*64*sizeof(float));
+        dynamic_large_stack_array(float,grid_y,M,64*64*sizeof(float));
+        dynamic_large_stack_array(float,grid_z,M,64*64*sizeof(float));
+        evalGrid(patch,x0,x1,y0,y1,swidth,sheight,grid_x,grid_y,grid_z,grid_u,grid_v,geom);
+        b = gridBounds(grid_size_simd_blocks,grid_x,grid_y,grid_z);
       }
       else
       {
@@ -356,28 +418,6 @@ namespace embree
           const vfloatx u = vfloatx::load(&grid_u[i*VSIZEX]);
           const vfloatx v = vfloatx::load(&grid_v[i*VSIZEX]);
           Vec3vfx vtx = patchEval(patch,u,v);
-        
-          /* evaluate displacement function */
-          if (unlikely(geom->displFunc != nullptr))
-          {
-            const Vec3vfx normal = normalize_safe(patchNormal(patch,u,v));
-            RTCDisplacementFunctionNArguments args;
-            args.geometryUserPtr = geom->userPtr;
-            args.geometry = (RTCGeometry)geom;
-            //args.geomID = patch.geomID();
-            args.primID = patch.primID();
-            args.timeStep = patch.time();
-            args.u = &u[0];
-            args.v = &v[0];
-            args.Ng_x = &normal.x[0];
-            args.Ng_y = &normal.y[0];
-            args.Ng_z = &normal.z[0];
-            args.P_x = &vtx.x[0];
-            args.P_y = &vtx.y[0];
-            args.P_z = &vtx.z[0];
-            args.N = VSIZEX;
-            geom->displFunc(&args);
-          }
 
           bounds_min[0] = min(bounds_min[0],vtx.x);
           bounds_max[0] = max(bounds_max[0],vtx.x);
@@ -25,6 +25,11 @@ namespace embree
     //SharedLazyTessellationCache::sharedLazyTessellationCache.addCurrentIndex(SharedLazyTessellationCache::NUM_CACHE_SEGMENTS);
     SharedLazyTessellationCache::sharedLazyTessellationCache.reset();
   }
+
+  bool checkTessellationCacheThrashing()
+  {
+    return SharedLazyTessellationCache::sharedLazyTessellationCache.checkThrashing();
+  }
   
   SharedLazyTessellationCache::SharedLazyTessellationCache()
   {
@@ -35,6 +40,9 @@ namespace embree
     localTime              = NUM_CACHE_SEGMENTS;
     next_block             = 0;
     numRenderThreads       = 0;
+    numFlushes             = 0;
+    numFlushesSinceCheck   = 0;
+    numFilledSegments      = 0;
 #if FORCE_SIMPLE_FLUSH == 1
     switch_block_threshold = maxBlocks;
 #else
@@ -100,7 +108,6 @@ namespace embree
         
         /* switch to the next segment */
         addCurrentIndex();
-        CACHE_STATS(PRINT("RESET TESS CACHE"));
         
 #if FORCE_SIMPLE_FLUSH == 1
         next_block = 0;
@@ -111,8 +118,10 @@ namespace embree
         switch_block_threshold = next_block + (maxBlocks/NUM_CACHE_SEGMENTS);
         assert( switch_block_threshold <= maxBlocks );
 #endif
-        
-        CACHE_STATS(SharedTessellationCacheStats::cache_flushes++);
+
+        numFlushes++;
+        numFlushesSinceCheck++;
+        numFilledSegments++;
         
         /* release all blocked threads */
         
@@ -155,6 +164,7 @@ namespace embree
 
     /* reset local time */
     localTime = NUM_CACHE_SEGMENTS;
+    numFilledSegments = 0;
 
     /* release all blocked threads */
     for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
@@ -189,6 +199,8 @@ namespace embree
 
     /* invalidate entire cache */
     localTime += NUM_CACHE_SEGMENTS; 
+    numFilledSegments = 0;
+    numFlushesSinceCheck = 0;
 
     /* reset to the first segment */
 #if FORCE_SIMPLE_FLUSH == 1
@@ -213,34 +225,78 @@ namespace embree
   }
 
 
+  size_t SharedLazyTessellationCache::getNumUsedBytes()
+  {
+    /* the current segment is filled up to next_block, the previous
+       segments stay valid until the cache wraps around */
+#if FORCE_SIMPLE_FLUSH == 1
+    const size_t usedBlocks = min(next_block.load(),switch_block_threshold.load());
+#else
+    const size_t segmentBlocks = maxBlocks/NUM_CACHE_SEGMENTS;
+    const size_t end = switch_block_threshold.load();
+    const size_t begin = end - min(end,segmentBlocks);
+    const size_t usedBlocks = min(numFilledSegments.load(),NUM_CACHE_SEGMENTS-1)*segmentBlocks + min(next_block.load(),end) - min(next_block.load(),begin);
+#endif
+    return usedBlocks*BLOCK_SIZE;
+  }
+
+  size_t SharedLazyTessellationCache::getNumHits()
+  {
+    size_t hits = 0;
+    linkedlist_mtx.lock();
+    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
+      hits += t->hits.load(std::memory_order_relaxed);
+    linkedlist_mtx.unlock();
+    return hits;
+  }
+
+  size_t SharedLazyTessellationCache::getNumMisses()
+  {
+    size_t misses = 0;
+    linkedlist_mtx.lock();
+    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
+      misses += t->misses.load(std::memory_order_relaxed);
+    linkedlist_mtx.unlock();
+    return misses;
+  }
+
+  void SharedLazyTessellationCache::clearStats()
+  {
+    linkedlist_mtx.lock();
+    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next) {
+      t->hits.store(0,std::memory_order_relaxed);
+      t->misses.store(0,std::memory_order_relaxed);
+    }
+    linkedlist_mtx.unlock();
+    numFlushes = 0;
+  }
+
+  bool SharedLazyTessellationCache::checkThrashing()
+  {
+    /* the cache thrashes if each segment got reused since the last check */
+    return numFlushesSinceCheck.exchange(0) >= NUM_CACHE_SEGMENTS;
+  }
+
   ////////////////////////////////////////////////////////////////////////////////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-  std::atomic<size_t> SharedTessellationCacheStats::cache_accesses(0);
-  std::atomic<size_t> SharedTessellationCacheStats::cache_hits(0);
-  std::atomic<size_t> SharedTessellationCacheStats::cache_misses(0);
-  std::atomic<size_t> SharedTessellationCacheStats::cache_flushes(0);  
-  SpinLock   SharedTessellationCacheStats::mtx;  
-  size_t SharedTessellationCacheStats::cache_num_patches(0);
-
   void SharedTessellationCacheStats::printStats()
   {
+    SharedLazyTessellationCache& cache = SharedLazyTessellationCache::sharedLazyTessellationCache;
+    const size_t cache_hits = cache.getNumHits();
+    const size_t cache_misses = cache.getNumMisses();
+    const size_t cache_accesses = cache_hits + cache_misses;
     PRINT(cache_accesses);
     PRINT(cache_misses);
     PRINT(cache_hits);
-    PRINT(cache_flushes);
+    PRINT(cache.getNumFlushes());
+    PRINT(cache.getNumUsedBytes());
     PRINT(100.0f * cache_hits / cache_accesses);
-    assert(cache_hits + cache_misses == cache_accesses);
-    PRINT(cache_num_patches);
   }
 
-  void SharedTessellationCacheStats::clearStats()
-  {
-    SharedTessellationCacheStats::cache_accesses  = 0;
-    SharedTessellationCacheStats::cache_hits      = 0;
-    SharedTessellationCacheStats::cache_misses    = 0;
-    SharedTessellationCacheStats::cache_flushes   = 0;
+  void SharedTessellationCacheStats::clearStats() {
+    SharedLazyTessellationCache::sharedLazyTessellationCache.clearStats();
   }
 
   struct cache_regression_test : public RegressionTest
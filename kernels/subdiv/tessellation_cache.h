@@ -10,25 +10,11 @@
 
 #define THREAD_BLOCK_ATOMIC_ADD 4
 
-#if defined(DEBUG)
-#define CACHE_STATS(x) 
-#else
-#define CACHE_STATS(x) 
-#endif
-
 namespace embree
 {
   class SharedTessellationCacheStats
   {
   public:
-    /* stats */
-    static std::atomic<size_t> cache_accesses;
-    static std::atomic<size_t> cache_hits;
-    static std::atomic<size_t> cache_misses;
-    static std::atomic<size_t> cache_flushes;                
-    static size_t        cache_num_patches;
-    __aligned(64) static SpinLock mtx;
-    
     /* print stats for debugging */                 
     static void printStats();
     static void clearStats();
@@ -36,6 +22,9 @@ namespace embree
   
   void resizeTessellationCache(size_t new_size);
   void resetTessellationCache();
+
+  /* returns true if the entire cache got recycled since the last invocation */
+  bool checkTessellationCacheThrashing();
   
  ////////////////////////////////////////////////////////////////////////////////
  ////////////////////////////////////////////////////////////////////////////////
@@ -49,11 +38,19 @@ namespace embree
    ThreadWorkState* next;
    bool allocated;
 
+   /* cache statistics, only written by the owning thread */
+   std::atomic<size_t> hits;
+   std::atomic<size_t> misses;
+
    __forceinline ThreadWorkState(bool allocated = false) 
-     : counter(0), next(nullptr), allocated(allocated) 
+     : counter(0), next(nullptr), allocated(allocated), hits(0), misses(0)
    {
      assert( ((size_t)this % 64) == 0 ); 
    }   
+
+   static __forceinline void increment(std::atomic<size_t>& stat) {
+     stat.store(stat.load(std::memory_order_relaxed)+1,std::memory_order_relaxed);
+   }
  };
 
  class __aligned(64) SharedLazyTessellationCache 
@@ -139,6 +136,9 @@ namespace embree
    __aligned(64) SpinLock   linkedlist_mtx;
    __aligned(64) std::atomic<size_t> switch_block_threshold;
    __aligned(64) std::atomic<size_t> numRenderThreads;
+   __aligned(64) std::atomic<size_t> numFlushes;
+   std::atomic<size_t> numFlushesSinceCheck;
+   std::atomic<size_t> numFilledSegments;
 
 
  public:
@@ -196,7 +196,6 @@ namespace embree
    static __forceinline void* lookup(CacheEntry& entry, size_t globalTime)
    {   
      const int64_t subdiv_patch_root_ref = entry.tag.get(); 
-     CACHE_STATS(SharedTessellationCacheStats::cache_accesses++);
      
      if (likely(subdiv_patch_root_ref != 0)) 
      {
@@ -204,12 +203,8 @@ namespace embree
        const size_t subdiv_patch_cache_index = extractCommitIndex(subdiv_patch_root_ref);
        
        if (likely( sharedLazyTessellationCache.validCacheIndex(subdiv_patch_cache_index,globalTime) ))
-       {
-         CACHE_STATS(SharedTessellationCacheStats::cache_hits++);
          return (void*) subdiv_patch_root;
-       }
      }
-     CACHE_STATS(SharedTessellationCacheStats::cache_misses++);
      return nullptr;
    }
 
@@ -222,12 +217,16 @@ namespace embree
      {
        sharedLazyTessellationCache.lockThreadLoop(t_state);
        void* patch = SharedLazyTessellationCache::lookup(entry,globalTime);
-       if (patch) return (decltype(constructor())) patch;
+       if (patch) {
+         ThreadWorkState::increment(t_state->hits);
+         return (decltype(constructor())) patch;
+       }
        
        if (entry.mutex.try_lock())
        {
          if (!validTag(entry.tag,globalTime)) 
          {
+           ThreadWorkState::increment(t_state->misses);
            auto timeBefore = sharedLazyTessellationCache.getTime(globalTime);
            auto ret = constructor(); // thread is locked here!
            assert(ret);
@@ -311,9 +310,15 @@ namespace embree
    }
 
    __forceinline void*  getDataPtr()      { return data; }
-   __forceinline size_t getNumUsedBytes() { return next_block * BLOCK_SIZE; }
    __forceinline size_t getMaxBlocks()    { return maxBlocks; }
    __forceinline size_t getSize()         { return size; }
+   __forceinline size_t getNumFlushes()   { return numFlushes.load(); }
+
+   size_t getNumUsedBytes();
+   size_t getNumHits();
+   size_t getNumMisses();
+   void clearStats();
+   bool checkThrashing();
 
    void allocNextSegment();
    void realloc(const size_t newSize);
@@ -308,8 +308,9 @@ void addCollisionConstraints (RTCScene scene)
   cloth.clearCollisionConstraints();
   
   for (auto const & coll : sim_collisions) {
-    auto & c0 = coll.first;
-    auto & c1 = coll.second;
+    // self collision queries report each pair once, so the cloth may be on either side
+    auto & c0 = clothID == coll.first.first ? coll.second : coll.first;
+    auto & c1 = clothID == coll.first.first ? coll.first : coll.second;
 
     // throw out self collisions for now
     if (clothID == c0.first && clothID == c1.first) continue;
@@ -343,7 +344,7 @@ void updateScene ()
 
   // sim_collisions.clear();
   double t0 = getSeconds();
-  rtcCollide(g_scene,g_scene,CollideFunc,&sim_collisions);
+  rtcCollideSelf(g_scene,RTC_COLLIDE_FLAG_NONE,CollideFunc,&sim_collisions);
   double t1 = getSeconds();
   total_collision_time += t1-t0;
   addCollisionConstraints (g_scene);
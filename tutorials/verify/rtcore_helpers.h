@@ -555,6 +555,7 @@ namespace embree
   {
     MODE_INTERSECT_NONE,
     MODE_INTERSECT1,
+    MODE_INTERSECT1M,
     MODE_INTERSECT4,
     MODE_INTERSECT8,
     MODE_INTERSECT16
@@ -565,6 +566,7 @@ namespace embree
     switch (imode) {
     case MODE_INTERSECT_NONE: return "None";
     case MODE_INTERSECT1: return "1";
+    case MODE_INTERSECT1M: return "1M";
     case MODE_INTERSECT4: return "4";
     case MODE_INTERSECT8: return "8";
     case MODE_INTERSECT16: return "16";
@@ -577,6 +579,7 @@ namespace embree
     switch (imode) {
     case MODE_INTERSECT_NONE: return 0;
     case MODE_INTERSECT1: return 16;
+    case MODE_INTERSECT1M: return 16;
     case MODE_INTERSECT4: return 16;
     case MODE_INTERSECT8: return 32;
     case MODE_INTERSECT16: return 64;
@@ -619,6 +622,12 @@ namespace embree
   inline bool has_variant(IntersectMode imode, IntersectVariant ivariant)
   {
     switch (imode) {
+    case MODE_INTERSECT1M:
+      switch (ivariant) {
+      case VARIANT_INTERSECT: return true;
+      case VARIANT_INTERSECT_OCCLUDED : return true; // occluded rays are traced using rtcOccluded1
+      default: return false;
+      }
     case MODE_INTERSECT1:
     case MODE_INTERSECT4:
     case MODE_INTERSECT8:
@@ -638,6 +647,7 @@ namespace embree
   {
     switch (imode) {
     case MODE_INTERSECT1:
+    case MODE_INTERSECT1M:
     case MODE_INTERSECT4:
     case MODE_INTERSECT8:
     case MODE_INTERSECT16:
@@ -723,6 +733,15 @@ namespace embree
       }
       break;
     }
+    case MODE_INTERSECT1M:
+    {
+      switch (ivariant & VARIANT_INTERSECT_OCCLUDED_MASK) {
+      case VARIANT_INTERSECT: rtcIntersect1M(scene,rays,N,args); break;
+      case VARIANT_OCCLUDED : for (size_t i=0; i<N; i++) rtcOccluded1 (scene,(RTCRay*)&rays[i],(RTCOccludedArguments*)args); break;
+      default: assert(false);
+      }
+      break;
+    }
 
     case MODE_INTERSECT4: 
     {
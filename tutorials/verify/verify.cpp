@@ -12,6 +12,7 @@
 #include "../../kernels/common/context.h"
 #include "../../kernels/common/geometry.h"
 #include "../../kernels/common/scene.h"
+#include "../../kernels/geometry/triangle_triangle_intersector.h"
 #include <regex>
 #include <stack>
 
@@ -2398,6 +2399,506 @@ namespace embree
     }
   };
 
+  struct CurvePresplitTest : public VerifyApplication::Test
+  {
+    CurvePresplitTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* high quality round curves get split into sub-segments, which must not change the hits */
+      Ref<SceneGraph::Node> hairs = SceneGraph::createHairyPlane(random_int(),Vec3fa(0.0f),Vec3fa(1,0,0),Vec3fa(0,1,0),0.2f,0.01f,256,SceneGraph::ROUND_CURVE);
+      VerifyScene scene0(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      scene0.addGeometry(RTC_BUILD_QUALITY_MEDIUM,hairs);
+      rtcCommitScene(scene0);
+      VerifyScene scene1(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      scene1.addGeometry(RTC_BUILD_QUALITY_HIGH,hairs);
+      rtcCommitScene(scene1);
+      AssertNoError(device);
+
+      size_t numHits = 0, numMismatches = 0;
+      for (size_t i=0; i<4096; i++)
+      {
+        const Vec3fa org(random_float(),-1.0f,0.2f*random_float());
+        RTCRayHit ray0 = makeRay(org,Vec3fa(0,1,0));
+        RTCRayHit ray1 = ray0;
+        rtcIntersect1(scene0,&ray0);
+        rtcIntersect1(scene1,&ray1);
+
+        /* grazing hits at the silhouette may differ slightly */
+        const bool hit0 = ray0.hit.geomID != RTC_INVALID_GEOMETRY_ID;
+        const bool hit1 = ray1.hit.geomID != RTC_INVALID_GEOMETRY_ID;
+        numHits += hit0;
+        if (hit0 != hit1) { numMismatches++; continue; }
+        if (!hit0) continue;
+        if (ray0.hit.primID != ray1.hit.primID || abs(ray0.ray.tfar-ray1.ray.tfar) > 1E-3f || abs(ray0.hit.u-ray1.hit.u) > 1E-2f)
+          numMismatches++;
+      }
+      AssertNoError(device);
+
+      return (VerifyApplication::TestReturnValue) (numHits > 100 && numMismatches < numHits/100);
+    }
+  };
+
+  struct CurveTessellationTest : public VerifyApplication::Test
+  {
+    CurveTessellationTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      RTCGeometry triangles = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_TRIANGLE);
+      rtcSetGeometryTessellationTolerance(triangles,0.1f);
+      AssertError(device,RTC_ERROR_INVALID_OPERATION);
+      rtcReleaseGeometry(triangles);
+
+      /* round curves tessellated into round linear segments have to stay within the tolerance of the curve */
+      const float tolerance = 0.002f;
+      Ref<SceneGraph::HairSetNode> hairs = SceneGraph::createHairyPlane(random_int(),Vec3fa(0.0f),Vec3fa(1,0,0),Vec3fa(0,1,0),0.2f,0.01f,32,SceneGraph::ROUND_CURVE).dynamicCast<SceneGraph::HairSetNode>();
+      VerifyScene scene0(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      scene0.addGeometry(RTC_BUILD_QUALITY_MEDIUM,hairs.dynamicCast<SceneGraph::Node>());
+      rtcCommitScene(scene0);
+
+      RTCSceneRef scene1 = rtcNewScene(device);
+      RTCGeometry geom = rtcNewGeometry(device, hairs->type);
+      rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,0,RTC_FORMAT_FLOAT4,hairs->positions[0].data(),0,sizeof(SceneGraph::HairSetNode::Vertex),hairs->positions[0].size());
+      rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_INDEX,0,RTC_FORMAT_UINT,hairs->hairs.data(),0,sizeof(SceneGraph::HairSetNode::Hair),hairs->hairs.size());
+      rtcSetGeometryTessellationTolerance(geom,-1.0f);
+      AssertError(device,RTC_ERROR_INVALID_ARGUMENT);
+      rtcSetGeometryTessellationTolerance(geom,tolerance);
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(scene1,geom);
+      rtcReleaseGeometry(geom);
+      rtcCommitScene(scene1);
+      AssertNoError(device);
+
+      size_t numHits = 0, numMismatches = 0;
+      for (size_t i=0; i<4096; i++)
+      {
+        const Vec3fa org(random_float(),-1.0f,0.2f*random_float());
+        RTCRayHit ray0 = makeRay(org,Vec3fa(0,1,0));
+        RTCRayHit ray1 = ray0;
+        rtcIntersect1(scene0,&ray0);
+        rtcIntersect1(scene1,&ray1);
+
+        /* hits close to the silhouette may differ, and the round linear segments close the open ends of the curve with spheres */
+        const bool hit0 = ray0.hit.geomID != RTC_INVALID_GEOMETRY_ID;
+        const bool hit1 = ray1.hit.geomID != RTC_INVALID_GEOMETRY_ID;
+        if (hit1 && (ray1.hit.u == 0.0f || ray1.hit.u == 1.0f)) continue;
+        numHits += hit0;
+        if (hit0 != hit1) { numMismatches++; continue; }
+        if (!hit0) continue;
+        if (ray0.hit.primID != ray1.hit.primID || abs(ray0.ray.tfar-ray1.ray.tfar) > 2.0f*tolerance || abs(ray0.hit.u-ray1.hit.u) > 0.05f)
+          numMismatches++;
+      }
+      AssertNoError(device);
+
+      return (VerifyApplication::TestReturnValue) (numHits > 100 && numMismatches < numHits/20);
+    }
+  };
+
+  unsigned int addSubdivMesh(RTCDevice device, RTCScene scene, Ref<SceneGraph::SubdivMeshNode> mesh, const float* levels)
+  {
+    RTCGeometry geom = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_SUBDIVISION);
+    rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_FACE, 0,RTC_FORMAT_UINT,mesh->verticesPerFace.data(),0,sizeof(int), mesh->verticesPerFace.size());
+    rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_INDEX,0,RTC_FORMAT_UINT,mesh->position_indices.data(),0,sizeof(int), mesh->position_indices.size());
+    rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,0,RTC_FORMAT_FLOAT3,mesh->positions[0].data(),0,sizeof(SceneGraph::SubdivMeshNode::Vertex), mesh->positions[0].size());
+    if (levels) rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_LEVEL,0,RTC_FORMAT_FLOAT,levels,0,sizeof(float),mesh->position_indices.size());
+    rtcCommitGeometry(geom);
+    unsigned int geomID = rtcAttachGeometry(scene,geom);
+    rtcReleaseGeometry(geom);
+    return geomID;
+  }
+
+  struct SubdivViewDependentTessellationTest : public VerifyApplication::Test
+  {
+    SubdivViewDependentTessellationTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      const Vec3fa camera(0.0f,0.0f,-4.0f);
+      const float edgeLength = 0.01f;
+
+      RTCGeometry triangles = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_TRIANGLE);
+      rtcSetGeometryViewDependentTessellation(triangles,&camera.x,1,edgeLength);
+      AssertError(device,RTC_ERROR_INVALID_OPERATION);
+      rtcReleaseGeometry(triangles);
+
+      /* levels calculated from the camera position have to match levels calculated by the application */
+      Ref<SceneGraph::SubdivMeshNode> mesh = SceneGraph::createSubdivSphere(Vec3fa(0.0f),1.0f,8,1.0f).dynamicCast<SceneGraph::SubdivMeshNode>();
+      std::vector<float> levels(mesh->position_indices.size());
+      for (size_t f=0, e=0; f<mesh->verticesPerFace.size(); e+=mesh->verticesPerFace[f++]) 
+      {
+        const size_t N = mesh->verticesPerFace[f];
+        for (size_t de=0; de<N; de++) {
+          const Vec3fa v0 = mesh->positions[0][mesh->position_indices[e+de]];
+          const Vec3fa v1 = mesh->positions[0][mesh->position_indices[e+(de+1)%N]];
+          levels[e+de] = length(v1-v0)/(edgeLength*length(0.5f*(v0+v1)-camera));
+        }
+      }
+
+      RTCSceneRef scene0 = rtcNewScene(device);
+      unsigned int geomID0 = addSubdivMesh(device,scene0,mesh,nullptr);
+      RTCGeometry geom0 = rtcGetGeometry(scene0,geomID0);
+      rtcSetGeometryViewDependentTessellation(geom0,&camera.x,1,0.0f);
+      AssertError(device,RTC_ERROR_INVALID_ARGUMENT);
+      rtcSetGeometryViewDependentTessellation(geom0,&camera.x,1,edgeLength);
+      rtcCommitGeometry(geom0);
+      rtcCommitScene(scene0);
+      AssertNoError(device);
+
+      RTCSceneRef scene1 = rtcNewScene(device);
+      addSubdivMesh(device,scene1,mesh,levels.data());
+      rtcCommitScene(scene1);
+      AssertNoError(device);
+
+      size_t numHits = 0, numMismatches = 0;
+      for (size_t i=0; i<4096; i++)
+      {
+        const Vec3fa dir = normalize(Vec3fa(2.0f*random_float()-1.0f,2.0f*random_float()-1.0f,4.0f));
+        RTCRayHit ray0 = makeRay(camera,dir);
+        RTCRayHit ray1 = ray0;
+        rtcIntersect1(scene0,&ray0);
+        rtcIntersect1(scene1,&ray1);
+
+        const bool hit0 = ray0.hit.geomID != RTC_INVALID_GEOMETRY_ID;
+        const bool hit1 = ray1.hit.geomID != RTC_INVALID_GEOMETRY_ID;
+        numHits += hit0;
+        if (hit0 != hit1) { numMismatches++; continue; }
+        if (!hit0) continue;
+        if (ray0.hit.primID != ray1.hit.primID || abs(ray0.ray.tfar-ray1.ray.tfar) > 1E-3f)
+          numMismatches++;
+      }
+      AssertNoError(device);
+
+      return (VerifyApplication::TestReturnValue) (numHits > 100 && numMismatches < numHits/100);
+    }
+  };
+
+  const int displacementTextureSize = 8;
+  const float displacementScale = 0.1f;
+
+  float displacementTexel(int x, int y) {
+    return float((5*x+3*y)%7)/7.0f;
+  }
+
+  /* reference implementation of the bilinear lookup into the tiled displacement texture */
+  float sampleDisplacementTexture(float u, float v)
+  {
+    const int N = displacementTextureSize;
+    const float x = u*float(N)-0.5f, fx = floorf(x), tx = x-fx;
+    const float y = v*float(N)-0.5f, fy = floorf(y), ty = y-fy;
+    const int ix0 = ((int(fx)%N)+N)%N, ix1 = (ix0+1)%N;
+    const int iy0 = ((int(fy)%N)+N)%N, iy1 = (iy0+1)%N;
+    const float t0 = lerp(displacementTexel(ix0,iy0),displacementTexel(ix1,iy0),tx);
+    const float t1 = lerp(displacementTexel(ix0,iy1),displacementTexel(ix1,iy1),tx);
+    return displacementScale*lerp(t0,t1,ty);
+  }
+
+  void displacementTextureFunction(const RTCDisplacementFunctionNArguments* args)
+  {
+    for (unsigned int i=0; i<args->N; i++) {
+      const float h = sampleDisplacementTexture(args->u[i],args->v[i]);
+      args->P_x[i] += h*args->Ng_x[i];
+      args->P_y[i] += h*args->Ng_y[i];
+      args->P_z[i] += h*args->Ng_z[i];
+    }
+  }
+
+  struct SubdivDisplacementTextureTest : public VerifyApplication::Test
+  {
+    SubdivDisplacementTextureTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      std::vector<float> texels(displacementTextureSize*displacementTextureSize);
+      for (int y=0; y<displacementTextureSize; y++)
+        for (int x=0; x<displacementTextureSize; x++)
+          texels[y*displacementTextureSize+x] = displacementTexel(x,y);
+
+      RTCGeometry triangles = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_TRIANGLE);
+      rtcSetGeometryDisplacementTexture(triangles,texels.data(),displacementTextureSize,displacementTextureSize,displacementScale);
+      AssertError(device,RTC_ERROR_INVALID_OPERATION);
+      rtcReleaseGeometry(triangles);
+
+      /* the built-in texture displacement has to match the same displacement implemented by a displacement function */
+      Ref<SceneGraph::SubdivMeshNode> mesh = SceneGraph::createSubdivSphere(Vec3fa(0.0f),1.0f,8,8.0f).dynamicCast<SceneGraph::SubdivMeshNode>();
+      RTCSceneRef scene0 = rtcNewScene(device);
+      RTCGeometry geom0 = rtcGetGeometry(scene0,addSubdivMesh(device,scene0,mesh,nullptr));
+      rtcSetGeometryTessellationRate(geom0,8.0f);
+      rtcSetGeometryDisplacementTexture(geom0,texels.data(),0,displacementTextureSize,displacementScale);
+      AssertError(device,RTC_ERROR_INVALID_ARGUMENT);
+      rtcSetGeometryDisplacementTexture(geom0,texels.data(),displacementTextureSize,displacementTextureSize,displacementScale);
+      rtcCommitGeometry(geom0);
+      rtcCommitScene(scene0);
+      AssertNoError(device);
+
+      RTCSceneRef scene1 = rtcNewScene(device);
+      RTCGeometry geom1 = rtcGetGeometry(scene1,addSubdivMesh(device,scene1,mesh,nullptr));
+      rtcSetGeometryTessellationRate(geom1,8.0f);
+      rtcSetGeometryDisplacementFunction(geom1,displacementTextureFunction);
+      rtcCommitGeometry(geom1);
+      rtcCommitScene(scene1);
+      AssertNoError(device);
+
+      RTCSceneRef scene2 = rtcNewScene(device);
+      RTCGeometry geom2 = rtcGetGeometry(scene2,addSubdivMesh(device,scene2,mesh,nullptr));
+      rtcSetGeometryTessellationRate(geom2,8.0f);
+      rtcCommitGeometry(geom2);
+      rtcCommitScene(scene2);
+      AssertNoError(device);
+
+      size_t numHits = 0, numMismatches = 0, numDisplaced = 0;
+      for (size_t i=0; i<4096; i++)
+      {
+        const Vec3fa dir = normalize(Vec3fa(2.0f*random_float()-1.0f,2.0f*random_float()-1.0f,4.0f));
+        RTCRayHit ray0 = makeRay(Vec3fa(0.0f,0.0f,-4.0f),dir);
+        RTCRayHit ray1 = ray0;
+        RTCRayHit ray2 = ray0;
+        rtcIntersect1(scene0,&ray0);
+        rtcIntersect1(scene1,&ray1);
+        rtcIntersect1(scene2,&ray2);
+
+        const bool hit0 = ray0.hit.geomID != RTC_INVALID_GEOMETRY_ID;
+        const bool hit1 = ray1.hit.geomID != RTC_INVALID_GEOMETRY_ID;
+        numHits += hit0;
+        if (hit0 != hit1) { numMismatches++; continue; }
+        if (!hit0) continue;
+        if (ray0.hit.primID != ray1.hit.primID || abs(ray0.ray.tfar-ray1.ray.tfar) > 1E-3f)
+          numMismatches++;
+        numDisplaced += abs(ray0.ray.tfar-ray2.ray.tfar) > 1E-3f;
+      }
+      AssertNoError(device);
+
+      return (VerifyApplication::TestReturnValue) (numHits > 100 && numMismatches < numHits/100 && numDisplaced > numHits/2);
+    }
+  };
+
+  struct SubdivTessellationReuseTest : public VerifyApplication::Test
+  {
+    SubdivTessellationReuseTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    size_t countMismatches(RTCScene scene0, RTCScene scene1, size_t& numHits)
+    {
+      size_t numMismatches = 0;
+      for (size_t i=0; i<1024; i++)
+      {
+        const Vec3fa dir = normalize(Vec3fa(2.0f*random_float()-1.0f,2.0f*random_float()-1.0f,4.0f));
+        RTCRayHit ray0 = makeRay(Vec3fa(0.0f,0.0f,-4.0f),dir);
+        RTCRayHit ray1 = ray0;
+        rtcIntersect1(scene0,&ray0);
+        rtcIntersect1(scene1,&ray1);
+        numHits += ray0.hit.geomID != RTC_INVALID_GEOMETRY_ID;
+        if (ray0.hit.geomID != ray1.hit.geomID || ray0.hit.primID != ray1.hit.primID || abs(ray0.ray.tfar-ray1.ray.tfar) > 1E-5f)
+          numMismatches++;
+      }
+      return numMismatches;
+    }
+
+    /* the scene has to find the same hits as a scene that got built from scratch */
+    bool matchesNewScene(RTCDevice device, RTCScene scene, Ref<SceneGraph::SubdivMeshNode> mesh, float tessellationRate)
+    {
+      RTCSceneRef reference = rtcNewScene(device);
+      RTCGeometry geom = rtcGetGeometry(reference,addSubdivMesh(device,reference,mesh,nullptr));
+      rtcSetGeometryTessellationRate(geom,tessellationRate);
+      rtcCommitGeometry(geom);
+      rtcCommitScene(reference);
+      AssertNoError(device);
+
+      size_t numHits = 0;
+      size_t numMismatches = countMismatches(scene,reference,numHits);
+      return numHits > 100 && numMismatches < numHits/100;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      Ref<SceneGraph::SubdivMeshNode> mesh = SceneGraph::createSubdivSphere(Vec3fa(0.0f),1.0f,8,4.0f).dynamicCast<SceneGraph::SubdivMeshNode>();
+      RTCSceneRef scene = rtcNewScene(device);
+      rtcSetSceneFlags(scene,RTC_SCENE_FLAG_DYNAMIC);
+      unsigned int geomID = addSubdivMesh(device,scene,mesh,nullptr);
+      RTCGeometry geom = rtcGetGeometry(scene,geomID);
+      rtcSetGeometryTessellationRate(geom,4.0f);
+      rtcCommitGeometry(geom);
+
+      /* unrelated triangle that no ray hits */
+      RTCGeometry triangle = rtcNewGeometry(device,RTC_GEOMETRY_TYPE_TRIANGLE);
+      Vec3f* vertices = (Vec3f*) rtcSetNewGeometryBuffer(triangle,RTC_BUFFER_TYPE_VERTEX,0,RTC_FORMAT_FLOAT3,sizeof(Vec3f),3);
+      unsigned int* indices = (unsigned int*) rtcSetNewGeometryBuffer(triangle,RTC_BUFFER_TYPE_INDEX,0,RTC_FORMAT_UINT3,3*sizeof(unsigned int),1);
+      vertices[0] = Vec3f(10,0,0); vertices[1] = Vec3f(11,0,0); vertices[2] = Vec3f(10,1,0);
+      indices[0] = 0; indices[1] = 1; indices[2] = 2;
+      rtcCommitGeometry(triangle);
+      rtcAttachGeometry(scene,triangle);
+      rtcReleaseGeometry(triangle);
+      rtcCommitScene(scene);
+      AssertNoError(device);
+      if (!matchesNewScene(device,scene,mesh,4.0f)) return VerifyApplication::FAILED;
+
+      /* modifying the triangle keeps the tessellation of the subdivision mesh */
+      for (size_t i=0; i<3; i++) vertices[i].y += 1.0f;
+      rtcUpdateGeometryBuffer(triangle,RTC_BUFFER_TYPE_VERTEX,0);
+      rtcCommitGeometry(triangle);
+      rtcCommitScene(scene);
+      AssertNoError(device);
+      if (!matchesNewScene(device,scene,mesh,4.0f)) return VerifyApplication::FAILED;
+
+      /* modified vertices, levels, and disabling the mesh have to update the tessellation */
+      for (auto& p : mesh->positions[0]) p = 1.5f*p;
+      rtcUpdateGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,0);
+      rtcCommitGeometry(geom);
+      rtcCommitScene(scene);
+      AssertNoError(device);
+      if (!matchesNewScene(device,scene,mesh,4.0f)) return VerifyApplication::FAILED;
+
+      rtcSetGeometryTessellationRate(geom,2.0f);
+      rtcCommitGeometry(geom);
+      rtcCommitScene(scene);
+      AssertNoError(device);
+      if (!matchesNewScene(device,scene,mesh,2.0f)) return VerifyApplication::FAILED;
+
+      rtcDisableGeometry(geom);
+      rtcCommitScene(scene);
+      RTCSceneRef empty = rtcNewScene(device);
+      rtcCommitScene(empty);
+      size_t numHits = 0;
+      if (countMismatches(scene,empty,numHits) != 0) return VerifyApplication::FAILED;
+      rtcEnableGeometry(geom);
+      rtcCommitScene(scene);
+      AssertNoError(device);
+      if (!matchesNewScene(device,scene,mesh,2.0f)) return VerifyApplication::FAILED;
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct SubdivTessellationCacheTest : public VerifyApplication::Test
+  {
+    SubdivTessellationCacheTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      /* use a cache that is too small to hold the patches of all faces */
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",tessellation_cache_size=0.25,tessellation_cache_max_size=1";
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      Ref<SceneGraph::SubdivMeshNode> mesh = SceneGraph::createSubdivPlane(Vec3fa(0.0f),Vec3fa(1,0,0),Vec3fa(0,1,0),64,64,1.0f).dynamicCast<SceneGraph::SubdivMeshNode>();
+      RTCSceneRef scene = rtcNewScene(device);
+      RTCGeometry geom = rtcGetGeometry(scene,addSubdivMesh(device,scene,mesh,nullptr));
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      const ssize_t size0    = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE);
+      const ssize_t hits0    = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS);
+      const ssize_t misses0  = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MISSES);
+      const ssize_t flushes0 = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_FLUSHES);
+
+      /* each face builds its patch once, re-evaluating the last face hits the cache */
+      const unsigned int numFaces = (unsigned int) mesh->verticesPerFace.size();
+      Vec3fa P;
+      for (unsigned int primID=0; primID<numFaces; primID++)
+        rtcInterpolate1(geom,primID,0.5f,0.5f,RTC_BUFFER_TYPE_VERTEX,0,&P.x,nullptr,nullptr,3);
+      rtcInterpolate1(geom,numFaces-1,0.25f,0.25f,RTC_BUFFER_TYPE_VERTEX,0,&P.x,nullptr,nullptr,3);
+      AssertNoError(device);
+
+      const ssize_t hits1     = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS);
+      const ssize_t misses1   = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MISSES);
+      const ssize_t flushes1  = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_FLUSHES);
+      const ssize_t usedBytes = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_USED_BYTES);
+      if (hits1-hits0 < 1 || misses1-misses0 != numFaces) return VerifyApplication::FAILED;
+      if (usedBytes <= 0 || usedBytes > size0) return VerifyApplication::FAILED;
+
+      /* the cache uses the largest size requested by any device, thus growth is only observable if no other device requests a larger cache */
+      if (size0 != 256*1024) return VerifyApplication::PASSED;
+
+      /* the cache got recycled entirely, thus the next commit has to grow it */
+      if (flushes1-flushes0 < 8) return VerifyApplication::FAILED;
+      rtcCommitScene(scene);
+      AssertNoError(device);
+      const ssize_t size1 = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_SIZE);
+      return (VerifyApplication::TestReturnValue) (size1 == 2*size0);
+    }
+  };
+
+  struct HairAccelTest : public VerifyApplication::Test
+  {
+    std::string hair_accel;
+
+    HairAccelTest (std::string name, int isa, std::string hair_accel)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), hair_accel(hair_accel) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device0 = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device0));
+      RTCDeviceRef device1 = rtcNewDevice((cfg+",hair_accel="+hair_accel).c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device1));
+
+      /* the hair acceleration structure has to find the same hits on curves, line segments, and points as the default one */
+      Ref<SceneGraph::Node> hairs  = SceneGraph::createHairyPlane(random_int(),Vec3fa(0.0f),Vec3fa(1,0,0),Vec3fa(0,1,0),0.2f,0.01f,256,SceneGraph::ROUND_CURVE);
+      Ref<SceneGraph::Node> lines  = SceneGraph::convert_bezier_to_lines(SceneGraph::createHairyPlane(random_int(),Vec3fa(0.0f),Vec3fa(1,0,0),Vec3fa(0,1,0),0.2f,0.01f,256,SceneGraph::ROUND_CURVE));
+      Ref<SceneGraph::Node> points = SceneGraph::createPointSphere(Vec3fa(0.5f,0.0f,0.1f),0.1f,0.005f,32,SceneGraph::SPHERE);
+
+      size_t numHits = 0, numMismatches = 0;
+      for (auto node : { hairs, lines, points })
+      {
+        VerifyScene scene0(device0,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+        scene0.addGeometry(RTC_BUILD_QUALITY_MEDIUM,node);
+        rtcCommitScene(scene0);
+        VerifyScene scene1(device1,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+        scene1.addGeometry(RTC_BUILD_QUALITY_MEDIUM,node);
+        rtcCommitScene(scene1);
+        AssertNoError(device0);
+        AssertNoError(device1);
+
+        for (size_t i=0; i<4096; i++)
+        {
+          const Vec3fa org(random_float(),-1.0f,0.2f*random_float());
+          RTCRayHit ray0 = makeRay(org,Vec3fa(0,1,0));
+          RTCRayHit ray1 = ray0;
+          rtcIntersect1(scene0,&ray0);
+          rtcIntersect1(scene1,&ray1);
+
+          const bool hit0 = ray0.hit.geomID != RTC_INVALID_GEOMETRY_ID;
+          const bool hit1 = ray1.hit.geomID != RTC_INVALID_GEOMETRY_ID;
+          numHits += hit0;
+          if (hit0 != hit1) { numMismatches++; continue; }
+          if (!hit0) continue;
+          if (ray0.hit.primID != ray1.hit.primID || abs(ray0.ray.tfar-ray1.ray.tfar) > 1E-4f)
+            numMismatches++;
+        }
+      }
+      AssertNoError(device0);
+      AssertNoError(device1);
+
+      return (VerifyApplication::TestReturnValue) (numHits > 100 && numMismatches < numHits/100);
+    }
+  };
+
   /////////////////////////////////////////////////////////////////////////////////
   /////////////////////////////////////////////////////////////////////////////////
   /////////////////////////////////////////////////////////////////////////////////
@@ -2635,6 +3136,67 @@ namespace embree
     }
   };
 
+  struct InstanceRayMasksTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags; 
+    RTCBuildQuality quality; 
+
+    InstanceRayMasksTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* the instance passes all rays, but the instanced scene only contains geometry of mask 2 and 4 */
+      VerifyScene child(device,sflags);
+      unsigned int geom0 = child.addSphere    (sampler,quality,Vec3fa(0,0,0),1.0f,50).first;
+      unsigned int geom1 = child.addQuadSphere(sampler,quality,Vec3fa(0,0,0),0.5f,50).first;
+      rtcSetGeometryMask(rtcGetGeometry(child,geom0),2);
+      rtcSetGeometryMask(rtcGetGeometry(child,geom1),4);
+      rtcCommitGeometry(rtcGetGeometry(child,geom0));
+      rtcCommitGeometry(rtcGetGeometry(child,geom1));
+      rtcCommitScene (child);
+
+      VerifyScene scene(device,sflags);
+      RTCGeometry instance = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_INSTANCE);
+      rtcSetGeometryInstancedScene(instance,child);
+      rtcSetGeometryMask(instance,0xFFFFFFFF);
+      AffineSpace3fa xfm = AffineSpace3fa::translate(Vec3fa(0,0,5));
+      rtcSetGeometryTransform(instance,0,RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR,(float*)&xfm);
+      rtcCommitGeometry(instance);
+      rtcAttachGeometry(scene,instance);
+      rtcReleaseGeometry(instance);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      bool passed = true;
+      for (unsigned i=0; i<16; i+=4) 
+      {
+        unsigned masks[4] = { i, i+1, i+2, i+3 };
+        RTCRayHit rays[4];
+        for (size_t j=0; j<4; j++) {
+          rays[j] = makeRay(Vec3fa(0,10,5),Vec3fa(0,-1,0));
+          rays[j].ray.mask = masks[j];
+        }
+        IntersectWithMode(imode,ivariant,scene,rays,4);
+
+        for (size_t j=0; j<4; j++)
+        {
+          if ((ivariant & VARIANT_INTERSECT) == VARIANT_INTERSECT)
+            passed &= (bool)(masks[j] & 6) == (rays[j].hit.geomID != RTC_INVALID_GEOMETRY_ID);
+          else
+            passed &= (bool)(masks[j] & 6) == (rays[j].ray.tfar == float(neg_inf));
+        }
+      }
+      AssertNoError(device);
+
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
   struct BackfaceCullingTest : public VerifyApplication::IntersectTest
   {
     SceneFlags sflags;
@@ -2703,28 +3265,23 @@ namespace embree
     }
   };
 
-  struct IntersectionFilterTest : public VerifyApplication::IntersectTest
+  struct GeometryBackfaceCullingTest : public VerifyApplication::IntersectTest
   {
     SceneFlags sflags;
     RTCBuildQuality quality;
-    bool subdiv;
+    GeometryType gtype;
 
-    IntersectionFilterTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality, bool subdiv, IntersectMode imode, IntersectVariant ivariant)
-      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality), subdiv(subdiv) {}
+    GeometryBackfaceCullingTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality, GeometryType gtype, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality), gtype(gtype) {}
     
-    static void intersectionFilterN(const RTCFilterFunctionNArguments* const args)
+    Ref<SceneGraph::Node> createPlane(const Vec3fa& p0, const Vec3fa& dx, const Vec3fa& dy)
     {
-      if ((size_t)args->geometryUserPtr != 123) 
-        return;
-
-      for (unsigned int i=0; i<args->N; i++)
-      {
-	if (args->valid[i] != -1) continue;
-
-        /* reject hit */
-        if (RTCHitN_primID(args->hit,args->N,i) & 2) {
-          args->valid[i] = 0;
-        }
+      switch (gtype) {
+      case TRIANGLE_MESH:    return SceneGraph::createTrianglePlane(p0,dx,dy,1,1);
+      case TRIANGLE_MESH_MB: return SceneGraph::createTrianglePlane(p0,dx,dy,1,1)->set_motion_vector(zero);
+      case QUAD_MESH:        return SceneGraph::createQuadPlane(p0,dx,dy,1,1);
+      case QUAD_MESH_MB:     return SceneGraph::createQuadPlane(p0,dx,dy,1,1)->set_motion_vector(zero);
+      default:               throw std::runtime_error("unsupported geometry type: "+to_string(gtype)); 
       }
     }
 
@@ -2733,20 +3290,105 @@ namespace embree
       std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
       RTCDeviceRef device = rtcNewDevice(cfg.c_str());
       errorHandler(nullptr,rtcGetDeviceError(device));
-
+       
+      /* create two planes that are front facing if looking along the
+         z direction, only the first plane gets culled */
       VerifyScene scene(device,sflags);
-      Vec3fa p0(-0.75f,-0.25f,-10.0f), dx(4,0,0), dy(0,4,0);
-      unsigned int geomID0 = 0;
-      if (subdiv) geomID0 = scene.addSubdivPlane (sampler,quality, 4, p0, dx, dy).first;
-      else        geomID0 = scene.addPlane       (sampler,quality, 4, p0, dx, dy).first;
-      RTCGeometry geom0 = rtcGetGeometry(scene,geomID0);
-      rtcSetGeometryUserData(geom0,(void*)123);
-      rtcSetGeometryIntersectFilterFunction (geom0,intersectionFilterN);
-      rtcSetGeometryOccludedFilterFunction (geom0,intersectionFilterN);
+      const Vec3fa dx = Vec3fa(0.0f,1.0f,0.0f);
+      const Vec3fa dy = Vec3fa(1.0f,0.0f,0.0f);
+      unsigned int geom0 = scene.addGeometry(quality,createPlane(Vec3fa(0.0f),dx,dy));
+      unsigned int geom1 = scene.addGeometry(quality,createPlane(Vec3fa(2.0f,0.0f,0.0f),dx,dy));
+      RTCGeometry hgeom0 = rtcGetGeometry(scene,geom0);
+      rtcSetGeometryEnableBackfaceCulling(hgeom0,true);
+      rtcCommitGeometry(hgeom0);
+      AssertNoError(device);
       rtcCommitScene (scene);
       AssertNoError(device);
-      
-      RTCRayHit rays[16];
+
+      /* backface culling is not supported for other geometry types */
+      RTCGeometry hgeom2 = rtcNewGeometry(device,RTC_GEOMETRY_TYPE_USER);
+      rtcSetGeometryEnableBackfaceCulling(hgeom2,true);
+      AssertError(device,RTC_ERROR_INVALID_OPERATION);
+      rtcReleaseGeometry(hgeom2);
+
+      const size_t numRays = 1000;
+      RTCRayHit rays[numRays];
+      bool passed = true;
+
+      for (size_t i=0; i<numRays; i++) {
+        const float rx = random_float() + ((i/2)%2 ? 2.0f : 0.0f);
+        const float ry = random_float();
+        if (i%2) rays[i] = makeRay(Vec3fa(rx,ry,+1),Vec3fa(0,0,-1)); 
+        else     rays[i] = makeRay(Vec3fa(rx,ry,-1),Vec3fa(0,0,+1)); 
+      }
+      
+      IntersectWithMode(imode,ivariant,scene,rays,numRays);
+      
+      for (size_t i=0; i<numRays; i++) 
+      {
+        const bool back = i%2;
+        const unsigned int geomID = (i/2)%2 ? geom1 : geom0;
+        if ((ivariant & VARIANT_INTERSECT) == VARIANT_INTERSECT)
+        {
+          if (back && geomID == geom0) passed &= rays[i].hit.geomID == RTC_INVALID_GEOMETRY_ID;
+          else                         passed &= rays[i].hit.geomID == geomID;
+        }
+        else
+        {
+          if (back && geomID == geom0) passed &= rays[i].ray.tfar != float(neg_inf);
+          else                         passed &= rays[i].ray.tfar == float(neg_inf);
+        }
+      }
+      AssertNoError(device);
+
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct IntersectionFilterTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+    bool subdiv;
+
+    IntersectionFilterTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality, bool subdiv, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality), subdiv(subdiv) {}
+    
+    static void intersectionFilterN(const RTCFilterFunctionNArguments* const args)
+    {
+      if ((size_t)args->geometryUserPtr != 123) 
+        return;
+
+      for (unsigned int i=0; i<args->N; i++)
+      {
+	if (args->valid[i] != -1) continue;
+
+        /* reject hit */
+        if (RTCHitN_primID(args->hit,args->N,i) & 2) {
+          args->valid[i] = 0;
+        }
+      }
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      VerifyScene scene(device,sflags);
+      Vec3fa p0(-0.75f,-0.25f,-10.0f), dx(4,0,0), dy(0,4,0);
+      unsigned int geomID0 = 0;
+      if (subdiv) geomID0 = scene.addSubdivPlane (sampler,quality, 4, p0, dx, dy).first;
+      else        geomID0 = scene.addPlane       (sampler,quality, 4, p0, dx, dy).first;
+      RTCGeometry geom0 = rtcGetGeometry(scene,geomID0);
+      rtcSetGeometryUserData(geom0,(void*)123);
+      rtcSetGeometryIntersectFilterFunction (geom0,intersectionFilterN);
+      rtcSetGeometryOccludedFilterFunction (geom0,intersectionFilterN);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+      
+      RTCRayHit rays[16];
       for (unsigned int iy=0; iy<4; iy++) 
       {
         for (unsigned int ix=0; ix<4; ix++) 
@@ -2780,6 +3422,303 @@ namespace embree
     }
   };
 
+  struct FeatureMaskFilterTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+
+    FeatureMaskFilterTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    static void rejectFilter(const RTCFilterFunctionNArguments* args)
+    {
+      for (unsigned int i=0; i<args->N; i++)
+        args->valid[i] = 0;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* a triangle at z=1 and a quad at z=2, both rejecting all hits through filter functions */
+      RTCSceneRef scene = rtcNewScene(device);
+      rtcSetSceneFlags(scene,sflags.sflags);
+      rtcSetSceneBuildQuality(scene,sflags.qflags);
+
+      RTCGeometry geom0 = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_TRIANGLE);
+      Vec3fa* vertices0 = (Vec3fa*) rtcSetNewGeometryBuffer(geom0, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, sizeof(Vec3fa), 3);
+      vertices0[0] = Vec3fa(-1,-1,1); vertices0[1] = Vec3fa(1,-1,1); vertices0[2] = Vec3fa(0,1,1);
+      unsigned int* indices0 = (unsigned int*) rtcSetNewGeometryBuffer(geom0, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT3, 3*sizeof(unsigned int), 1);
+      indices0[0] = 0; indices0[1] = 1; indices0[2] = 2;
+
+      RTCGeometry geom1 = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_QUAD);
+      Vec3fa* vertices1 = (Vec3fa*) rtcSetNewGeometryBuffer(geom1, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, sizeof(Vec3fa), 4);
+      vertices1[0] = Vec3fa(-1,-1,2); vertices1[1] = Vec3fa(1,-1,2); vertices1[2] = Vec3fa(1,1,2); vertices1[3] = Vec3fa(-1,1,2);
+      unsigned int* indices1 = (unsigned int*) rtcSetNewGeometryBuffer(geom1, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT4, 4*sizeof(unsigned int), 1);
+      indices1[0] = 0; indices1[1] = 1; indices1[2] = 2; indices1[3] = 3;
+
+      for (RTCGeometry geom : { geom0, geom1 })
+      {
+        rtcSetGeometryIntersectFilterFunction(geom,rejectFilter);
+        rtcSetGeometryOccludedFilterFunction(geom,rejectFilter);
+        rtcCommitGeometry(geom);
+        rtcAttachGeometry(scene,geom);
+        rtcReleaseGeometry(geom);
+      }
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      bool passed = true;
+      for (bool filter : { true, false })
+      {
+        RTCIntersectArguments iargs;
+        rtcInitIntersectArguments(&iargs);
+        RTCOccludedArguments oargs;
+        rtcInitOccludedArguments(&oargs);
+        if (!filter) {
+          iargs.feature_mask = (RTCFeatureFlags) (RTC_FEATURE_FLAG_TRIANGLE | RTC_FEATURE_FLAG_QUAD);
+          oargs.feature_mask = (RTCFeatureFlags) (RTC_FEATURE_FLAG_TRIANGLE | RTC_FEATURE_FLAG_QUAD);
+        }
+
+        /* the filter functions are only invoked if enabled in the feature mask */
+        RTCRayHit ray0 = makeRay(Vec3fa(0.0f,-0.5f,0.0f),Vec3fa(0,0,1));
+        rtcIntersect1(scene,&ray0,&iargs);
+        passed &= filter ? ray0.hit.geomID == RTC_INVALID_GEOMETRY_ID : ray0.hit.geomID == 0;
+
+        RTCRayHit ray1 = makeRay(Vec3fa(0.5f,0.5f,0.0f),Vec3fa(0,0,1));
+        rtcIntersect1(scene,&ray1,&iargs);
+        passed &= filter ? ray1.hit.geomID == RTC_INVALID_GEOMETRY_ID : ray1.hit.geomID == 1;
+
+        RTCRayHit ray2 = makeRay(Vec3fa(0.0f,-0.5f,0.0f),Vec3fa(0,0,1));
+        rtcOccluded1(scene,&ray2.ray,&oargs);
+        passed &= filter ? ray2.ray.tfar != float(neg_inf) : ray2.ray.tfar == float(neg_inf);
+      }
+      AssertNoError(device);
+
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct OpacityMicromapTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+
+    OpacityMicromapTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+
+    /* level 2 micromap, the state depends on the position of the micro triangle centroid */
+    static RTCOpacityMicromapState opacityState(float cu, float cv) {
+      return (RTCOpacityMicromapState) ((int(12.0f*cu+0.5f) + int(4.0f*cv)) % 3);
+    }
+
+    static RTCOpacityMicromapState opacityFunction(const RTCOpacityFunctionArguments* args)
+    {
+      const float cu = (args->u[0]+args->u[1]+args->u[2])/3.0f;
+      const float cv = (args->v[0]+args->v[1]+args->v[2])/3.0f;
+      return opacityState(cu,cv);
+    }
+
+    static void rejectFilter(const RTCFilterFunctionNArguments* args)
+    {
+      for (unsigned int i=0; i<args->N; i++)
+        args->valid[i] = 0;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      VerifyScene scene(device,sflags);
+      RTCGeometry geom = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_TRIANGLE);
+      rtcSetGeometryBuildQuality(geom, quality);
+      Vec3fa* vertices = (Vec3fa*) rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, sizeof(Vec3fa), 3);
+      vertices[0] = Vec3fa(0,0,0); vertices[1] = Vec3fa(1,0,0); vertices[2] = Vec3fa(0,1,0);
+      unsigned int* indices = (unsigned int*) rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT3, 3*sizeof(unsigned int), 1);
+      indices[0] = 0; indices[1] = 1; indices[2] = 2;
+      rtcSetGeometryIntersectFilterFunction(geom,rejectFilter);
+      rtcSetGeometryOccludedFilterFunction(geom,rejectFilter);
+      rtcSetGeometryOpacityMicromap(geom,2,opacityFunction);
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(scene,geom);
+      rtcReleaseGeometry(geom);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      /* shoot rays at points away from all micro triangle edges, only opaque micro triangles are hit */
+      std::vector<RTCRayHit> rays;
+      std::vector<bool> opaque;
+      for (unsigned int iy=0; iy<16; iy++)
+      {
+        for (unsigned int ix=0; ix<16; ix++)
+        {
+          const float u = (float(ix)+0.3f)/16.0f, v = (float(iy)+0.4f)/16.0f;
+          if (u+v > 0.95f) continue;
+          const float fu = 4.0f*u - floorf(4.0f*u), fv = 4.0f*v - floorf(4.0f*v);
+          const float ofs = fu+fv > 1.0f ? 2.0f/3.0f : 1.0f/3.0f;
+          const float cu = (floorf(4.0f*u)+ofs)/4.0f, cv = (floorf(4.0f*v)+ofs)/4.0f;
+          opaque.push_back(opacityState(cu,cv) == RTC_OPACITY_MICROMAP_STATE_OPAQUE);
+          rays.push_back(makeRay(Vec3fa(u,v,-1.0f),Vec3fa(0,0,1)));
+        }
+      }
+      IntersectWithMode(imode,ivariant,scene,rays.data(),(unsigned int)rays.size());
+
+      bool passed = true;
+      for (size_t i=0; i<rays.size(); i++)
+      {
+        if (ivariant & VARIANT_INTERSECT)
+          passed &= opaque[i] == (rays[i].hit.geomID != RTC_INVALID_GEOMETRY_ID);
+        else
+          passed &= opaque[i] == (rays[i].ray.tfar == float(neg_inf));
+      }
+      AssertNoError(device);
+
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct MultiHitTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+
+    MultiHitTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+
+    static void rejectFilter(const RTCFilterFunctionNArguments* args)
+    {
+      for (unsigned int i=0; i<args->N; i++)
+        args->valid[i] = 0;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* 8 layers of triangles at z=1..8, hits on layer 5 get rejected by a filter */
+      VerifyScene scene(device,sflags);
+      for (unsigned int i=0; i<8; i++)
+      {
+        RTCGeometry geom = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_TRIANGLE);
+        rtcSetGeometryBuildQuality(geom, quality);
+        Vec3fa* vertices = (Vec3fa*) rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, sizeof(Vec3fa), 3);
+        vertices[0] = Vec3fa(-1,-1,float(i+1)); vertices[1] = Vec3fa(1,-1,float(i+1)); vertices[2] = Vec3fa(0,1,float(i+1));
+        unsigned int* indices = (unsigned int*) rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT3, 3*sizeof(unsigned int), 1);
+        indices[0] = 0; indices[1] = 1; indices[2] = 2;
+        if (i == 5) rtcSetGeometryIntersectFilterFunction(geom,rejectFilter);
+        rtcCommitGeometry(geom);
+        rtcAttachGeometry(scene,geom);
+        rtcReleaseGeometry(geom);
+      }
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      RTCRayHit rayhit = makeRay(Vec3fa(0,0,0),Vec3fa(0,0,1));
+      float tfar[16];
+      RTCHit hits[16];
+      RTCHitList list;
+      list.tfar = tfar;
+      list.hits = hits;
+
+      bool passed = true;
+      for (unsigned int maxHitCount : { 0, 1, 3, 7, 16 })
+      {
+        list.maxHitCount = maxHitCount;
+        rtcIntersectMultiHit1(scene,&rayhit.ray,&list);
+        AssertNoError(device);
+
+        passed &= list.hitCount == std::min(maxHitCount,7u);
+        for (unsigned int i=0; i<list.hitCount; i++)
+        {
+          const unsigned int geomID = i < 5 ? i : i+1;
+          passed &= hits[i].geomID == geomID;
+          passed &= hits[i].primID == 0;
+          passed &= std::abs(tfar[i] - float(geomID+1)) < 1E-4f;
+        }
+      }
+
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct OccluderCacheTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+
+    OccluderCacheTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+
+    /* shadow rays with and without occluder cache have to give identical results */
+    bool compareOccluded(RTCScene scene, RandomSampler& sampler)
+    {
+      RTCOccludedArguments args0;
+      rtcInitOccludedArguments(&args0);
+      RTCOccludedArguments args1;
+      rtcInitOccludedArguments(&args1);
+      args1.flags = RTC_RAY_QUERY_FLAG_OCCLUDER_CACHE;
+
+      bool passed = true;
+      for (size_t i=0; i<1024; i++)
+      {
+        const Vec3fa org = 4.0f*RandomSampler_get3D(sampler) - Vec3fa(2.0f);
+        const Vec3fa dir = 4.0f*RandomSampler_get3D(sampler) - Vec3fa(2.0f) - org;
+        RTCRay ray0 = makeRay(org,dir,0.0f,1.0f).ray;
+        RTCRay ray1 = ray0;
+        rtcOccluded1(scene,&ray0,&args0);
+        rtcOccluded1(scene,&ray1,&args1);
+        passed &= (ray0.tfar == float(neg_inf)) == (ray1.tfar == float(neg_inf));
+      }
+      return passed;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      RandomSampler sampler;
+      RandomSampler_init(sampler, 0);
+
+      Ref<VerifyScene> scene0 = new VerifyScene(device,sflags);
+      scene0->addSphere(sampler,quality,Vec3fa(0.0f,0.0f,0.0f),0.5f,10);
+      rtcCommitScene(*scene0);
+
+      VerifyScene scene(device,sflags);
+      const unsigned int geom0 = scene.addSphere    (sampler,quality,Vec3fa(-1.0f,0.0f,0.0f),0.5f,20).first;
+      const unsigned int geom1 = scene.addQuadSphere(sampler,quality,Vec3fa(+1.0f,0.0f,0.0f),0.5f,20).first;
+      RTCGeometry instance = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_INSTANCE);
+      rtcSetGeometryInstancedScene(instance,*scene0);
+      const AffineSpace3fa xfm = AffineSpace3fa::translate(Vec3fa(0.0f,1.0f,0.0f));
+      rtcSetGeometryTransform(instance,0,RTC_FORMAT_FLOAT3X4_COLUMN_MAJOR,(float*)&xfm);
+      rtcCommitGeometry(instance);
+      rtcAttachGeometry(scene,instance);
+      rtcReleaseGeometry(instance);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      bool passed = compareOccluded(scene,sampler);
+
+      /* cached leaves of previous builds must not get used after the scene changed */
+      rtcDetachGeometry(scene,geom0);
+      rtcCommitScene (scene);
+      passed &= compareOccluded(scene,sampler);
+
+      rtcDetachGeometry(scene,geom1);
+      rtcCommitScene (scene);
+      passed &= compareOccluded(scene,sampler);
+      AssertNoError(device);
+
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
   struct InstancingTest : public VerifyApplication::IntersectTest
   {
     SceneFlags sflags;
@@ -3492,26 +4431,171 @@ namespace embree
     }
   };
 
-#endif
-
-  struct InactiveRaysTest : public VerifyApplication::IntersectTest
+  struct InstanceArrayUpdateTest : public VerifyApplication::Test
   {
     SceneFlags sflags;
-    RTCBuildQuality quality;
 
-    static const size_t N = 10;
-    static const size_t maxStreamSize = 100;
-    
-    InactiveRaysTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality, IntersectMode imode, IntersectVariant ivariant)
-      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
-   
+    InstanceArrayUpdateTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    /* shoots one ray at the center of each sphere and checks which instance got hit */
+    bool checkHits(RTCScene scene, const std::vector<AffineSpace3fa>& transforms)
+    {
+      bool passed = true;
+      for (size_t i=0; i<transforms.size(); i++)
+      {
+        RTCRayHit rayhit = makeRay(transforms[i].p - Vec3fa(0.f,0.f,4.f),Vec3fa(0,0,1));
+        rtcIntersect1(scene,&rayhit);
+        passed &= rayhit.hit.instID[0] == 0;
+        passed &= rayhit.hit.instPrimID[0] == i;
+        passed &= std::abs(rayhit.ray.tfar - (4.0f-transforms[i].l.vz.z)) < 1E-3f;
+      }
+      return passed;
+    }
+
     VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
     {
       std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
       RTCDeviceRef device = rtcNewDevice(cfg.c_str());
       errorHandler(nullptr,rtcGetDeviceError(device));
 
-      Vec3fa pos = zero;
+      Ref<SceneGraph::Node> sphere = SceneGraph::createQuadSphere(Vec3fa(0.f), 1.f, 32);
+      VerifyScene bl_scene(device, sflags);
+      bl_scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM, sphere);
+      rtcCommitScene(bl_scene);
+      AssertNoError(device);
+
+      std::vector<AffineSpace3fa> transforms;
+      for (int i=0; i<16; i++)
+        transforms.push_back(AffineSpace3fa::translate(Vec3fa(i*5.f,0.f,0.f)));
+
+      VerifyScene tl_scene(device, sflags);
+      RTCGeometry instance_array = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_INSTANCE_ARRAY);
+      rtcSetSharedGeometryBuffer(instance_array, RTC_BUFFER_TYPE_TRANSFORM, 0, RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR, (void*)transforms.data(), 0, sizeof(AffineSpace3fa), transforms.size());
+      rtcSetGeometryInstancedScene(instance_array, bl_scene);
+      rtcCommitGeometry(instance_array);
+      rtcAttachGeometry(tl_scene, instance_array);
+      rtcCommitScene(tl_scene);
+      AssertNoError(device);
+      bool passed = checkHits(tl_scene, transforms);
+
+      /* the precomputed inverse transformations have to follow updates of the transform buffer */
+      for (int i=0; i<16; i++)
+        transforms[i] = AffineSpace3fa::translate(Vec3fa(i*5.f,10.f,0.f)) * AffineSpace3fa::scale(Vec3fa(float(i%4+1)));
+      rtcUpdateGeometryBuffer(instance_array, RTC_BUFFER_TYPE_TRANSFORM, 0);
+      rtcCommitGeometry(instance_array);
+      rtcCommitScene(tl_scene);
+      AssertNoError(device);
+      passed &= checkHits(tl_scene, transforms);
+
+      rtcReleaseGeometry(instance_array);
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct InstanceArrayLODTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+
+    InstanceArrayLODTest (std::string name, int isa, SceneFlags sflags, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* the coarse level of detail is a smaller sphere, thus the hit distance tells which level got traversed */
+      VerifyScene lod0(device, sflags);
+      lod0.addGeometry(RTC_BUILD_QUALITY_MEDIUM, SceneGraph::createQuadSphere(Vec3fa(0.f), 1.f, 32));
+      rtcCommitScene(lod0);
+      VerifyScene lod1(device, sflags);
+      lod1.addGeometry(RTC_BUILD_QUALITY_MEDIUM, SceneGraph::createQuadSphere(Vec3fa(0.f), 0.5f, 8));
+      rtcCommitScene(lod1);
+      AssertNoError(device);
+
+      /* instance i is at distance 10*(i+1) in front of ray i */
+      std::vector<AffineSpace3fa> transforms;
+      for (int i=0; i<16; i++)
+        transforms.push_back(AffineSpace3fa::translate(Vec3fa(5.f*i,0.f,10.f*(i+1))));
+      std::vector<unsigned int> indices(16,0);
+
+      RTCScene scenes[2] = { lod0, lod1 };
+      VerifyScene tl_scene(device, sflags);
+      RTCGeometry instance_array = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_INSTANCE_ARRAY);
+      rtcSetSharedGeometryBuffer(instance_array, RTC_BUFFER_TYPE_TRANSFORM, 0, RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR, (void*)transforms.data(), 0, sizeof(AffineSpace3fa), transforms.size());
+      rtcSetSharedGeometryBuffer(instance_array, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT, (void*)indices.data(), 0, sizeof(unsigned int), indices.size());
+      rtcSetGeometryInstancedScenes(instance_array, scenes, 2);
+
+      const float unsorted[2] = { 2.0f, 1.0f };
+      rtcSetGeometryInstanceLOD(instance_array, unsorted, 2, 0.0f);
+      AssertError(device,RTC_ERROR_INVALID_ARGUMENT);
+
+      const float distance = 75.0f;
+      rtcSetGeometryInstanceLOD(instance_array, &distance, 1, 0.0f);
+      rtcCommitGeometry(instance_array);
+      rtcAttachGeometry(tl_scene, instance_array);
+      rtcReleaseGeometry(instance_array);
+      rtcCommitScene(tl_scene);
+      AssertNoError(device);
+
+      RTCRayHit rays[16];
+      for (int i=0; i<16; i++)
+        rays[i] = makeRay(Vec3fa(5.f*i,0.f,0.f),Vec3fa(0,0,1));
+      IntersectWithMode(imode,ivariant,tl_scene,rays,16);
+
+      bool passed = true;
+      for (int i=0; i<16; i++)
+      {
+        const float radius = 10.f*(i+1) < distance ? 1.0f : 0.5f;
+        passed &= rays[i].hit.instPrimID[0] == (unsigned int) i;
+        passed &= std::abs(rays[i].ray.tfar - (10.f*(i+1) - radius)) < 1E-3f;
+      }
+
+      /* rays close to the LOD distance select either level, but a ray always selects the same level */
+      rtcSetGeometryInstanceLOD(instance_array, &distance, 1, 40.0f);
+      rtcCommitGeometry(instance_array);
+      rtcCommitScene(tl_scene);
+      AssertNoError(device);
+
+      unsigned int numLevel[2] = { 0, 0 };
+      for (int j=0; j<64; j++)
+      {
+        const Vec3fa org(30.f + 0.002f*j,0.f,5.f);
+        RTCRayHit ray0 = makeRay(org,Vec3fa(0,0,1));
+        RTCRayHit ray1 = ray0;
+        IntersectWithMode(imode,ivariant,tl_scene,&ray0,1);
+        IntersectWithMode(imode,ivariant,tl_scene,&ray1,1);
+        passed &= ray0.ray.tfar == ray1.ray.tfar;
+        numLevel[ray0.ray.tfar > 65.f-0.75f]++;
+      }
+      passed &= numLevel[0] > 0 && numLevel[1] > 0;
+
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+#endif
+
+  struct InactiveRaysTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+
+    static const size_t N = 10;
+    static const size_t maxStreamSize = 100;
+    
+    InactiveRaysTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+   
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      Vec3fa pos = zero;
       VerifyScene scene(device,sflags);
       scene.addSphere(sampler,RTC_BUILD_QUALITY_MEDIUM,pos,2.0f,50); // FIXME: use different geometries too
       rtcCommitScene (scene);
@@ -4241,171 +5325,977 @@ namespace embree
           const Vec3f p = closestPointTriangle(q, v0, v1, v2);
           const float d = distance(q, p);
 
-          if (d < args->query->radius) {
-            args->query->radius = d;
-            data->result = p;
-            data->primID = args->primID;
-            return true;
-          }
-          return false; 
-        }, &data);
+          if (d < args->query->radius) {
+            args->query->radius = d;
+            data->result = p;
+            data->primID = args->primID;
+            return true;
+          }
+          return false; 
+        }, &data);
+
+        if ((int)data.primID != i/2) return VerifyApplication::FAILED;
+        if (abs(data.result.x- 0.25f) > 1e-4f)        return VerifyApplication::FAILED;
+        if (abs(data.result.y- 0.75f) > 1e-4f)        return VerifyApplication::FAILED;
+        if (abs(data.result.z- (float)(i/2)) > 1e-4f) return VerifyApplication::FAILED;
+        AssertNoError(device);
+      }
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct PointQueryMotionBlurTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags; 
+    std::string tri_accel;
+
+    PointQueryMotionBlurTest (std::string name, int isa, SceneFlags sflags, std::string tri_accel = "")
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), tri_accel(tri_accel) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa) + (tri_accel != "" ? ",tri_accel="+tri_accel : "");
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+     
+      Vec3f vertices_t0[4] = { 
+        Vec3f(-1.f, -1.f, -1.f), 
+        Vec3f( 1.f, -1.f, -1.f), 
+        Vec3f( 0.f,  1.f, -1.f), 
+        Vec3f(0.f) // 16 byte padding
+      };
+      Vec3f vertices_t1[4] = { 
+        Vec3f(-1.f, -1.f, 1.f), 
+        Vec3f( 1.f, -1.f, 1.f), 
+        Vec3f( 0.f,  1.f, 1.f), 
+        Vec3f(0.f) // 16 byte padding
+      };
+
+      // duplicate triangle to make sure the bvh is not only a leaf node
+      Triangle triangles[64];
+      for (int i = 0; i < 64; ++i)
+        triangles[i] = Triangle(0, 1, 2);
+
+      RTCSceneRef scene = rtcNewScene(device);
+      rtcSetSceneFlags(scene,sflags.sflags);
+      rtcSetSceneBuildQuality(scene,sflags.qflags);
+      
+      RTCGeometry geom = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_TRIANGLE);
+      rtcSetGeometryBuildQuality(geom,sflags.qflags);
+      rtcSetGeometryTimeStepCount(geom,2);
+      rtcSetGeometryPointQueryFunction(geom, [](RTCPointQueryFunctionArguments* args) -> bool
+      {
+        // set primID (userPtr) to something != RTC_INVALID_GEOMETRY_ID to signal that 
+        // the query overlapped some geometry
+        *((unsigned int*)args->userPtr) = 0;
+        return true;
+      });
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, vertices_t0, 0, sizeof(Vec3f),     3);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 1, RTC_FORMAT_FLOAT3, vertices_t1, 0, sizeof(Vec3f),     3);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX , 0, RTC_FORMAT_UINT3,  triangles,   0, sizeof(Triangle), 64);
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(scene,geom);
+      rtcReleaseGeometry(geom);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      RTCPointQuery query0;
+      query0.x      =  0.0f;
+      query0.y      =  0.0f;
+      query0.z      = -1.0f;
+      query0.radius =  0.1f;
+      
+      RTCPointQuery query1;
+      query1.x      =  0.0f;
+      query1.y      =  0.0f;
+      query1.z      =  0.0f;
+      query1.radius =  0.1f;
+      
+      RTCPointQuery query2;
+      query2.x      =  0.0f;
+      query2.y      =  0.0f;
+      query2.z      =  1.0f;
+      query2.radius =  0.1f;
+
+      // time t = 0, only query0 should overlap
+      query0.time = query1.time = query2.time = 0.f;
+      {
+        unsigned int primID = RTC_INVALID_GEOMETRY_ID;
+        RTCPointQueryContext context;
+        rtcInitPointQueryContext(&context);
+        rtcPointQuery(scene, &query0, &context, nullptr, &primID);
+        if (primID == RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+      }
+      {
+        unsigned int primID = RTC_INVALID_GEOMETRY_ID;
+        RTCPointQueryContext context;
+        rtcInitPointQueryContext(&context);
+        rtcPointQuery(scene, &query1, &context, nullptr, &primID);
+        if (primID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+      }
+      {
+        unsigned int primID = RTC_INVALID_GEOMETRY_ID;
+        RTCPointQueryContext context;
+        rtcInitPointQueryContext(&context);
+        rtcPointQuery(scene, &query2, &context, nullptr, &primID);
+        if (primID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+      }
+
+      // time t = 0.5, only query1 should overlap
+      query0.time = query1.time = query2.time = 0.5f;
+      {
+        unsigned int primID = RTC_INVALID_GEOMETRY_ID;
+        RTCPointQueryContext context;
+        rtcInitPointQueryContext(&context);
+        rtcPointQuery(scene, &query0, &context, nullptr, &primID);
+        if (primID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+      }
+      {
+        unsigned int primID = RTC_INVALID_GEOMETRY_ID;
+        RTCPointQueryContext context;
+        rtcInitPointQueryContext(&context);
+        rtcPointQuery(scene, &query1, &context, nullptr, &primID);
+        if (primID == RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+      }
+      {
+        unsigned int primID = RTC_INVALID_GEOMETRY_ID;
+        RTCPointQueryContext context;
+        rtcInitPointQueryContext(&context);
+        rtcPointQuery(scene, &query2, &context, nullptr, &primID);
+        if (primID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+      }
+      
+      // time t = 1.0, only query2 should overlap
+      query0.time = query1.time = query2.time = 1.f;
+      {
+        unsigned int primID = RTC_INVALID_GEOMETRY_ID;
+        RTCPointQueryContext context;
+        rtcInitPointQueryContext(&context);
+        rtcPointQuery(scene, &query0, &context, nullptr, &primID);
+        if (primID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+      }
+      {
+        unsigned int primID = RTC_INVALID_GEOMETRY_ID;
+        RTCPointQueryContext context;
+        rtcInitPointQueryContext(&context);
+        rtcPointQuery(scene, &query1, &context, nullptr, &primID);
+        if (primID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+      }
+      {
+        unsigned int primID = RTC_INVALID_GEOMETRY_ID;
+        RTCPointQueryContext context;
+        rtcInitPointQueryContext(&context);
+        rtcPointQuery(scene, &query2, &context, nullptr, &primID);
+        if (primID == RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+      }
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct ClosestPointTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCGeometryType gtype;
+    bool instanced;
+
+    ClosestPointTest (std::string name, int isa, SceneFlags sflags, RTCGeometryType gtype, bool instanced)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), gtype(gtype), instanced(instanced) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      const AffineSpace3fa xfm = instanced
+        ? AffineSpace3fa(LinearSpace3fa::rotate(Vec3fa(1,1,0),0.5f)*LinearSpace3fa::scale(Vec3fa(2.0f,1.0f,0.5f)),Vec3fa(1,2,3))
+        : AffineSpace3fa(one);
+
+      /* world space triangles of all primitives, quads and grid cells get split into two triangles */
+      std::vector<Vec3fa> tris;
+      std::vector<unsigned int> triPrimIDs;
+      auto addTriangle = [&] (const Vec3fa& v0, const Vec3fa& v1, const Vec3fa& v2, unsigned int primID) {
+        tris.push_back(xfmPoint(xfm,v0));
+        tris.push_back(xfmPoint(xfm,v1));
+        tris.push_back(xfmPoint(xfm,v2));
+        triPrimIDs.push_back(primID);
+      };
+
+      RTCSceneRef mesh_scene = rtcNewScene(device);
+      rtcSetSceneFlags(mesh_scene,sflags.sflags);
+      rtcSetSceneBuildQuality(mesh_scene,sflags.qflags);
+      RTCGeometry geom = rtcNewGeometry (device, gtype);
+      rtcSetGeometryBuildQuality(geom,sflags.qflags);
+
+      if (gtype == RTC_GEOMETRY_TYPE_TRIANGLE || gtype == RTC_GEOMETRY_TYPE_QUAD)
+      {
+        const unsigned int numVerts = gtype == RTC_GEOMETRY_TYPE_TRIANGLE ? 3 : 4;
+        const unsigned int numPrims = 64;
+        Vec3f* vertices = (Vec3f*)rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, sizeof(Vec3f), numVerts*numPrims);
+        unsigned int* indices = (unsigned int*)rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0, numVerts == 3 ? RTC_FORMAT_UINT3 : RTC_FORMAT_UINT4, numVerts*sizeof(unsigned int), numPrims);
+        for (unsigned int i=0; i<numPrims; i++)
+        {
+          const Vec3fa p(2.0f*random_float(),2.0f*random_float(),2.0f*random_float());
+          const Vec3fa dx(0.5f*random_float(),0.1f*random_float(),0.1f*random_float());
+          const Vec3fa dy(0.1f*random_float(),0.1f*random_float(),0.5f*random_float());
+          Vec3fa v[4] = { p, p+dx, p+dx+dy, p+dy };
+          for (unsigned int j=0; j<numVerts; j++) {
+            vertices[numVerts*i+j] = Vec3f(v[j].x,v[j].y,v[j].z);
+            indices[numVerts*i+j] = numVerts*i+j;
+          }
+          if (numVerts == 3) {
+            addTriangle(v[0],v[1],v[2],i);
+          } else {
+            addTriangle(v[0],v[1],v[3],i);
+            addTriangle(v[2],v[3],v[1],i);
+          }
+        }
+      }
+      else
+      {
+        const unsigned int res = 8;
+        RTCGrid* grid = (RTCGrid*)rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_GRID, 0, RTC_FORMAT_GRID, sizeof(RTCGrid), 1);
+        grid[0].startVertexID = 0;
+        grid[0].stride        = res;
+        grid[0].width         = res;
+        grid[0].height        = res;
+        Vec3f* vertices = (Vec3f*)rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, sizeof(Vec3f), res*res);
+        for (unsigned int y=0; y<res; y++)
+          for (unsigned int x=0; x<res; x++)
+            vertices[y*res+x] = Vec3f(0.3f*x,0.3f*random_float(),0.3f*y);
+        auto vtx = [&] (unsigned int x, unsigned int y) { return Vec3fa(vertices[y*res+x].x,vertices[y*res+x].y,vertices[y*res+x].z); };
+        for (unsigned int y=0; y<res-1; y++) {
+          for (unsigned int x=0; x<res-1; x++) {
+            addTriangle(vtx(x,y),vtx(x+1,y),vtx(x,y+1),0);
+            addTriangle(vtx(x+1,y+1),vtx(x,y+1),vtx(x+1,y),0);
+          }
+        }
+      }
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(mesh_scene,geom);
+      rtcReleaseGeometry(geom);
+      rtcCommitScene(mesh_scene);
+
+      RTCSceneRef instance_scene = nullptr;
+      if (instanced)
+      {
+        instance_scene = rtcNewScene(device);
+        rtcSetSceneFlags(instance_scene,sflags.sflags);
+        rtcSetSceneBuildQuality(instance_scene,sflags.qflags);
+        RTCGeometry instance = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_INSTANCE);
+        rtcSetGeometryInstancedScene(instance,mesh_scene);
+        rtcSetGeometryTransform(instance,0,RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR,(float*)&xfm);
+        rtcCommitGeometry(instance);
+        rtcAttachGeometry(instance_scene,instance);
+        rtcReleaseGeometry(instance);
+        rtcCommitScene(instance_scene);
+      }
+      RTCScene scene = instanced ? (RTCScene)instance_scene : (RTCScene)mesh_scene;
+      AssertNoError(device);
+
+      /* brute force distance to all triangles of one or all primitives */
+      auto distanceTo = [&] (const Vec3fa& q, unsigned int primID) {
+        float d = inf;
+        for (size_t i=0; i<triPrimIDs.size(); i++) {
+          if (primID != RTC_INVALID_GEOMETRY_ID && triPrimIDs[i] != primID) continue;
+          d = min(d,distance(q,closestPointTriangle(q,tris[3*i+0],tris[3*i+1],tris[3*i+2])));
+        }
+        return d;
+      };
+
+      const size_t N = 64;
+      std::vector<RTCClosestPointResult> results(N);
+      std::vector<float> distances(N);
+      for (size_t i=0; i<N; i++)
+      {
+        const Vec3fa q = xfmPoint(xfm,Vec3fa(3.0f*random_float()-0.5f,3.0f*random_float()-0.5f,3.0f*random_float()-0.5f));
+        RTCPointQuery query;
+        query.x = q.x; query.y = q.y; query.z = q.z;
+        query.time = 0.0f;
+        query.radius = inf;
+        if (!rtcClosestPoint(scene,&query,&results[i])) return VerifyApplication::FAILED;
+        AssertNoError(device);
+
+        const RTCClosestPointResult& r = results[i];
+        const Vec3fa p(r.p_x,r.p_y,r.p_z);
+        const float d = distanceTo(q,RTC_INVALID_GEOMETRY_ID);
+        const float eps = 1E-4f*(1.0f+d);
+        distances[i] = d;
+        if (r.geomID != 0) return VerifyApplication::FAILED;
+        if (r.instID[0] != (instanced ? 0 : RTC_INVALID_GEOMETRY_ID)) return VerifyApplication::FAILED;
+        if (abs(distance(q,p)-d) > eps) return VerifyApplication::FAILED;
+        if (abs(query.radius-d) > eps) return VerifyApplication::FAILED;
+        if (distanceTo(p,r.primID) > eps) return VerifyApplication::FAILED;
+        if (r.u < -eps || r.v < -eps || r.u > 1.0f+eps || r.v > 1.0f+eps) return VerifyApplication::FAILED;
+
+        /* the barycentric coordinates reproduce the closest point */
+        if (gtype == RTC_GEOMETRY_TYPE_TRIANGLE || gtype == RTC_GEOMETRY_TYPE_QUAD)
+        {
+          const Vec3fa* v = &tris[3*(gtype == RTC_GEOMETRY_TYPE_TRIANGLE ? r.primID : 2*r.primID)];
+          Vec3fa pi;
+          if (gtype == RTC_GEOMETRY_TYPE_TRIANGLE) pi = (1.0f-r.u-r.v)*v[0] + r.u*v[1] + r.v*v[2];
+          else if (r.u+r.v <= 1.0f)                 pi = (1.0f-r.u-r.v)*v[0] + r.u*v[1] + r.v*v[2];
+          else                                      pi = (r.u+r.v-1.0f)*v[3] + (1.0f-r.u)*v[4] + (1.0f-r.v)*v[5];
+          if (distance(p,pi) > 1E-3f*(1.0f+d)) return VerifyApplication::FAILED;
+        }
+      }
+
+      /* points outside the query radius are not found */
+      {
+        RTCPointQuery query;
+        query.x = query.y = query.z = 100.0f;
+        query.time = 0.0f;
+        query.radius = 1.0f;
+        RTCClosestPointResult r;
+        if (rtcClosestPoint(scene,&query,&r)) return VerifyApplication::FAILED;
+        if (r.geomID != RTC_INVALID_GEOMETRY_ID || query.radius != 1.0f) return VerifyApplication::FAILED;
+      }
+
+      /* packets find the same closest points */
+      for (size_t i=0; i<N; i+=4)
+      {
+        __aligned(16) int valid[4] = { -1, -1, 0, -1 };
+        __aligned(16) RTCPointQuery4 query;
+        for (size_t k=0; k<4; k++) {
+          const RTCClosestPointResult& r = results[i+k];
+          const Vec3fa q = xfmPoint(xfm,Vec3fa(0.0f));
+          query.x[k] = r.p_x + 0.1f*(q.x-r.p_x);
+          query.y[k] = r.p_y + 0.1f*(q.y-r.p_y);
+          query.z[k] = r.p_z + 0.1f*(q.z-r.p_z);
+          query.time[k] = 0.0f;
+          query.radius[k] = inf;
+        }
+        RTCClosestPointResult r[4];
+        rtcClosestPoint4(valid,scene,&query,r);
+        AssertNoError(device);
+        for (size_t k=0; k<4; k++) {
+          if (!valid[k]) continue;
+          const Vec3fa q(query.x[k],query.y[k],query.z[k]);
+          const float d = distanceTo(q,RTC_INVALID_GEOMETRY_ID);
+          if (abs(query.radius[k]-d) > 1E-4f*(1.0f+d)) return VerifyApplication::FAILED;
+          if (abs(distance(q,Vec3fa(r[k].p_x,r[k].p_y,r[k].p_z))-d) > 1E-4f*(1.0f+d)) return VerifyApplication::FAILED;
+        }
+        if (query.radius[2] != float(inf)) return VerifyApplication::FAILED;
+      }
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct BoxQueryTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    bool instanced;
+
+    BoxQueryTest (std::string name, int isa, SceneFlags sflags, bool instanced)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), instanced(instanced) {}
+
+    typedef std::set<std::pair<unsigned int,unsigned int>> PrimitiveSet;
+
+    static bool flush(void* userPtr, RTCBoxQueryPrimitive* primitives, unsigned int numPrimitives)
+    {
+      PrimitiveSet& found = *(PrimitiveSet*)userPtr;
+      for (unsigned int i=0; i<numPrimitives; i++)
+        found.insert(std::make_pair(primitives[i].geomID,primitives[i].primID));
+      return true;
+    }
+
+    static bool terminate(void* userPtr, RTCBoxQueryPrimitive* primitives, unsigned int numPrimitives)
+    {
+      (*(unsigned int*)userPtr)++;
+      return false;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* a triangle mesh and a quad mesh of small random primitives */
+      std::vector<std::vector<BBox3fa>> primBounds;
+      RTCSceneRef mesh_scene = rtcNewScene(device);
+      rtcSetSceneFlags(mesh_scene,sflags.sflags);
+      rtcSetSceneBuildQuality(mesh_scene,sflags.qflags);
+      for (unsigned int numVerts : { 3, 4 })
+      {
+        const unsigned int numPrims = 256;
+        RTCGeometry geom = rtcNewGeometry (device, numVerts == 3 ? RTC_GEOMETRY_TYPE_TRIANGLE : RTC_GEOMETRY_TYPE_QUAD);
+        rtcSetGeometryBuildQuality(geom,sflags.qflags);
+        Vec3f* vertices = (Vec3f*)rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, sizeof(Vec3f), numVerts*numPrims);
+        unsigned int* indices = (unsigned int*)rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0, numVerts == 3 ? RTC_FORMAT_UINT3 : RTC_FORMAT_UINT4, numVerts*sizeof(unsigned int), numPrims);
+        std::vector<BBox3fa> bounds(numPrims,empty);
+        for (unsigned int i=0; i<numPrims; i++)
+        {
+          const Vec3fa p(4.0f*random_float(),4.0f*random_float(),4.0f*random_float());
+          for (unsigned int j=0; j<numVerts; j++) {
+            const Vec3fa v = p+0.2f*Vec3fa(random_float(),random_float(),random_float());
+            vertices[numVerts*i+j] = Vec3f(v.x,v.y,v.z);
+            indices[numVerts*i+j] = numVerts*i+j;
+            bounds[i].extend(v);
+          }
+        }
+        primBounds.push_back(bounds);
+        rtcCommitGeometry(geom);
+        rtcAttachGeometry(mesh_scene,geom);
+        rtcReleaseGeometry(geom);
+      }
+      rtcCommitScene(mesh_scene);
+
+      /* instances of the mesh scene are reported as a whole */
+      RTCSceneRef instance_scene = nullptr;
+      if (instanced)
+      {
+        RTCBounds b; rtcGetSceneBounds(mesh_scene,&b);
+        const BBox3fa objectBounds(Vec3fa(b.lower_x,b.lower_y,b.lower_z),Vec3fa(b.upper_x,b.upper_y,b.upper_z));
+        primBounds.clear();
+        instance_scene = rtcNewScene(device);
+        rtcSetSceneFlags(instance_scene,sflags.sflags);
+        rtcSetSceneBuildQuality(instance_scene,sflags.qflags);
+        for (unsigned int i=0; i<64; i++)
+        {
+          const AffineSpace3fa xfm(LinearSpace3fa::rotate(Vec3fa(1,1,0),random_float())*LinearSpace3fa::scale(Vec3fa(0.5f)),
+                                   Vec3fa(8.0f*random_float(),8.0f*random_float(),8.0f*random_float()));
+          RTCGeometry instance = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_INSTANCE);
+          rtcSetGeometryInstancedScene(instance,mesh_scene);
+          rtcSetGeometryTransform(instance,0,RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR,(float*)&xfm);
+          rtcCommitGeometry(instance);
+          rtcAttachGeometry(instance_scene,instance);
+          rtcReleaseGeometry(instance);
+          primBounds.push_back(std::vector<BBox3fa>(1,xfmBounds(xfm,objectBounds)));
+        }
+        rtcCommitScene(instance_scene);
+      }
+      RTCScene scene = instanced ? (RTCScene)instance_scene : (RTCScene)mesh_scene;
+      AssertNoError(device);
+
+      for (size_t i=0; i<32; i++)
+      {
+        /* thin and thick query boxes */
+        const Vec3fa lower(5.0f*random_float()-0.5f,5.0f*random_float()-0.5f,5.0f*random_float()-0.5f);
+        const Vec3fa size(2.0f*random_float(),2.0f*random_float(),(i%2) ? 0.01f : 2.0f*random_float());
+        const BBox3fa box(lower,lower+size);
+
+        PrimitiveSet expected;
+        for (unsigned int geomID=0; geomID<primBounds.size(); geomID++)
+          for (unsigned int primID=0; primID<primBounds[geomID].size(); primID++)
+            if (!disjoint(primBounds[geomID][primID],box))
+              expected.insert(std::make_pair(geomID,primID));
+
+        __aligned(16) RTCBoxQuery query;
+        query.lower_x = box.lower.x; query.lower_y = box.lower.y; query.lower_z = box.lower.z;
+        query.upper_x = box.upper.x; query.upper_y = box.upper.y; query.upper_z = box.upper.z;
+        query.time = 0.0f;
+
+        /* full buffers get passed to the flush function, the last partial buffer is returned */
+        RTCBoxQueryPrimitive primitives[7];
+        PrimitiveSet found;
+        const unsigned int num = rtcBoxQuery(scene,&query,primitives,7,flush,&found);
+        AssertNoError(device);
+        if (num > 7) return VerifyApplication::FAILED;
+        flush(&found,primitives,num);
+        if (found != expected) return VerifyApplication::FAILED;
+
+        /* without flush function the query stops once the buffer is full, primitives referenced by multiple BVH leaves may get reported multiple times */
+        std::vector<RTCBoxQueryPrimitive> all(2*expected.size()+8);
+        const unsigned int numAll = rtcBoxQuery(scene,&query,all.data(),(unsigned int)all.size(),nullptr,nullptr);
+        AssertNoError(device);
+        PrimitiveSet foundAll;
+        flush(&foundAll,all.data(),numAll);
+        if (foundAll != expected) return VerifyApplication::FAILED;
+
+        unsigned int numCalls = 0;
+        const unsigned int numTerminated = rtcBoxQuery(scene,&query,primitives,2,terminate,&numCalls);
+        AssertNoError(device);
+        if (numTerminated != min(size_t(2),expected.size())) return VerifyApplication::FAILED;
+        if (numCalls > 1 || (expected.size() > 2 && numCalls != 1)) return VerifyApplication::FAILED;
+        for (unsigned int k=0; k<numTerminated; k++)
+          if (expected.find(std::make_pair(primitives[k].geomID,primitives[k].primID)) == expected.end())
+            return VerifyApplication::FAILED;
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct FrustumQueryTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    bool instanced;
+    RTCFrustumQueryFlags qflags;
+
+    FrustumQueryTest (std::string name, int isa, SceneFlags sflags, bool instanced, RTCFrustumQueryFlags qflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), instanced(instanced), qflags(qflags) {}
+
+    /* reported primitives (instID,geomID,primID) and whether they were reported as inside */
+    typedef std::map<std::tuple<unsigned int,unsigned int,unsigned int>,bool> PrimitiveMap;
+
+    static void report(void* userPtr, RTCFrustumQueryPrimitive* primitives, unsigned int numPrimitives)
+    {
+      PrimitiveMap& found = *(PrimitiveMap*)userPtr;
+      for (unsigned int i=0; i<numPrimitives; i++) {
+        const RTCFrustumQueryPrimitive& prim = primitives[i];
+        found[std::make_tuple(prim.instID[0],prim.geomID,prim.primID)] |= prim.inside != 0;
+      }
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* a triangle mesh and a quad mesh of small random primitives */
+      std::vector<std::vector<std::vector<Vec3fa>>> primVertices;
+      RTCSceneRef mesh_scene = rtcNewScene(device);
+      rtcSetSceneFlags(mesh_scene,sflags.sflags);
+      rtcSetSceneBuildQuality(mesh_scene,sflags.qflags);
+      for (unsigned int numVerts : { 3, 4 })
+      {
+        const unsigned int numPrims = 256;
+        RTCGeometry geom = rtcNewGeometry (device, numVerts == 3 ? RTC_GEOMETRY_TYPE_TRIANGLE : RTC_GEOMETRY_TYPE_QUAD);
+        rtcSetGeometryBuildQuality(geom,sflags.qflags);
+        Vec3f* vertices = (Vec3f*)rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, sizeof(Vec3f), numVerts*numPrims);
+        unsigned int* indices = (unsigned int*)rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0, numVerts == 3 ? RTC_FORMAT_UINT3 : RTC_FORMAT_UINT4, numVerts*sizeof(unsigned int), numPrims);
+        std::vector<std::vector<Vec3fa>> verts(numPrims);
+        for (unsigned int i=0; i<numPrims; i++)
+        {
+          const Vec3fa p(4.0f*random_float(),4.0f*random_float(),4.0f*random_float());
+          for (unsigned int j=0; j<numVerts; j++) {
+            const Vec3fa v = p+0.2f*Vec3fa(random_float(),random_float(),random_float());
+            vertices[numVerts*i+j] = Vec3f(v.x,v.y,v.z);
+            indices[numVerts*i+j] = numVerts*i+j;
+            verts[i].push_back(v);
+          }
+        }
+        primVertices.push_back(verts);
+        rtcCommitGeometry(geom);
+        rtcAttachGeometry(mesh_scene,geom);
+        rtcReleaseGeometry(geom);
+      }
+      rtcCommitScene(mesh_scene);
+
+      /* reference primitives (instID,geomID,primID) with their world space vertices */
+      std::map<std::tuple<unsigned int,unsigned int,unsigned int>,std::vector<Vec3fa>> reference;
+      RTCSceneRef instance_scene = nullptr;
+      if (instanced)
+      {
+        instance_scene = rtcNewScene(device);
+        rtcSetSceneFlags(instance_scene,sflags.sflags);
+        rtcSetSceneBuildQuality(instance_scene,sflags.qflags);
+        for (unsigned int i=0; i<16; i++)
+        {
+          const AffineSpace3fa xfm(LinearSpace3fa::rotate(Vec3fa(1,1,0),random_float())*LinearSpace3fa::scale(Vec3fa(0.5f)),
+                                   Vec3fa(8.0f*random_float(),8.0f*random_float(),8.0f*random_float()));
+          RTCGeometry instance = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_INSTANCE);
+          rtcSetGeometryInstancedScene(instance,mesh_scene);
+          rtcSetGeometryTransform(instance,0,RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR,(float*)&xfm);
+          rtcCommitGeometry(instance);
+          const unsigned int instID = rtcAttachGeometry(instance_scene,instance);
+          rtcReleaseGeometry(instance);
+
+          /* instances are reported as a whole when requested */
+          for (unsigned int geomID=0; geomID<primVertices.size(); geomID++)
+            for (unsigned int primID=0; primID<primVertices[geomID].size(); primID++)
+              for (const Vec3fa& v : primVertices[geomID][primID]) {
+                if (qflags & RTC_FRUSTUM_QUERY_FLAG_INSTANCES) reference[std::make_tuple(RTC_INVALID_GEOMETRY_ID,instID,0u)].push_back(xfmPoint(xfm,v));
+                else                                           reference[std::make_tuple(instID,geomID,primID)].push_back(xfmPoint(xfm,v));
+              }
+        }
+        rtcCommitScene(instance_scene);
+      }
+      else
+      {
+        for (unsigned int geomID=0; geomID<primVertices.size(); geomID++)
+          for (unsigned int primID=0; primID<primVertices[geomID].size(); primID++)
+            reference[std::make_tuple(RTC_INVALID_GEOMETRY_ID,geomID,primID)] = primVertices[geomID][primID];
+      }
+      RTCScene scene = instanced ? (RTCScene)instance_scene : (RTCScene)mesh_scene;
+      AssertNoError(device);
+
+      for (size_t i=0; i<32; i++)
+      {
+        /* perspective frustum looking along the z axis */
+        const Vec3fa apex(8.0f*random_float()-2.0f,8.0f*random_float()-2.0f,-4.0f*random_float());
+        const float s = 0.2f+random_float();
+        const float znear = random_float(), zfar = znear+2.0f+8.0f*random_float();
+        const Vec3fa normals[6] = { Vec3fa(1,0,s), Vec3fa(-1,0,s), Vec3fa(0,1,s), Vec3fa(0,-1,s), Vec3fa(0,0,1), Vec3fa(0,0,-1) };
+        const Vec3fa points[6] = { apex, apex, apex, apex, apex+Vec3fa(0,0,znear), apex+Vec3fa(0,0,zfar) };
+
+        __aligned(16) RTCFrustumQuery query;
+        for (size_t p=0; p<6; p++) {
+          query.planes[p][0] = normals[p].x; query.planes[p][1] = normals[p].y; query.planes[p][2] = normals[p].z;
+          query.planes[p][3] = -dot(normals[p],points[p]);
+        }
+        query.time = 0.0f;
+        query.flags = qflags;
+
+        PrimitiveMap found;
+        rtcFrustumQuery(scene,&query,report,&found);
+        AssertNoError(device);
+
+        for (auto& prim : reference)
+        {
+          size_t numInside = 0;
+          for (const Vec3fa& v : prim.second) {
+            bool inside = true;
+            for (size_t p=0; p<6; p++) inside &= dot(normals[p],v-points[p]) >= 0.0f;
+            numInside += inside;
+          }
+
+          /* primitives with a vertex inside the frustum have to be reported, primitives reported as inside must be completely inside */
+          auto f = found.find(prim.first);
+          if (numInside > 0 && f == found.end()) return VerifyApplication::FAILED;
+          if (f != found.end() && f->second && numInside != prim.second.size() && sflags.qflags != RTC_BUILD_QUALITY_HIGH)
+            return VerifyApplication::FAILED;
+        }
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct CollideTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCGeometryType gtype;
+
+    CollideTest (std::string name, int isa, SceneFlags sflags, RTCGeometryType gtype)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), gtype(gtype) {}
+
+    struct Mesh
+    {
+      std::vector<Vec3fa> vertices;
+      std::vector<unsigned int> indices;
+    };
+
+    typedef std::set<std::tuple<unsigned int,unsigned int,unsigned int,unsigned int>> CollisionSet;
+
+    static void collideFunc (void* userPtr, RTCCollision* collisions, unsigned int num_collisions)
+    {
+      static MutexSys mutex;
+      Lock<MutexSys> lock(mutex);
+      CollisionSet* set = (CollisionSet*) userPtr;
+      for (size_t i=0; i<num_collisions; i++)
+        set->insert(std::make_tuple(collisions[i].geomID0,collisions[i].primID0,collisions[i].geomID1,collisions[i].primID1));
+    }
+
+    RTCScene createScene (RTCDevice device, std::vector<Mesh>& meshes, size_t numGeometries)
+    {
+      const unsigned int numVerts = gtype == RTC_GEOMETRY_TYPE_TRIANGLE ? 3 : 4;
+      const unsigned int numPrims = 256;
+      RTCScene scene = rtcNewScene(device);
+      rtcSetSceneFlags(scene,sflags.sflags);
+      rtcSetSceneBuildQuality(scene,sflags.qflags);
+      for (size_t g=0; g<numGeometries; g++)
+      {
+        RTCGeometry geom = rtcNewGeometry (device, gtype);
+        rtcSetGeometryBuildQuality(geom,sflags.qflags);
+        Vec3f* vertices = (Vec3f*)rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, sizeof(Vec3f), numVerts*numPrims);
+        unsigned int* indices = (unsigned int*)rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0, numVerts == 3 ? RTC_FORMAT_UINT3 : RTC_FORMAT_UINT4, numVerts*sizeof(unsigned int), numPrims);
+        Mesh mesh;
+        for (unsigned int i=0; i<numPrims; i++)
+        {
+          const Vec3fa p(2.0f*random_float(),2.0f*random_float(),2.0f*random_float());
+          const Vec3fa dx(0.4f*random_float()-0.2f,0.4f*random_float()-0.2f,0.4f*random_float()-0.2f);
+          const Vec3fa dy(0.4f*random_float()-0.2f,0.4f*random_float()-0.2f,0.4f*random_float()-0.2f);
+          const Vec3fa v[4] = { p, p+dx, p+dx+dy, p+dy };
+          for (unsigned int j=0; j<numVerts; j++) {
+            vertices[numVerts*i+j] = Vec3f(v[j].x,v[j].y,v[j].z);
+            indices[numVerts*i+j] = numVerts*i+j;
+          }
+          /* let some primitives share a vertex with their predecessor */
+          if (i > 0 && random_bool())
+            indices[numVerts*i] = indices[numVerts*(i-1)+1];
+        }
+        for (unsigned int i=0; i<numVerts*numPrims; i++) {
+          mesh.vertices.push_back(Vec3fa(vertices[i].x,vertices[i].y,vertices[i].z));
+          mesh.indices.push_back(indices[i]);
+        }
+        meshes.push_back(mesh);
+        rtcCommitGeometry(geom);
+        rtcAttachGeometry(scene,geom);
+        rtcReleaseGeometry(geom);
+      }
+      rtcCommitScene(scene);
+      return scene;
+    }
+
+    /* triangles of a primitive, quads get split into two triangles */
+    size_t triangles (const Mesh& mesh, size_t primID, Vec3fa tris[2][3])
+    {
+      if (gtype == RTC_GEOMETRY_TYPE_TRIANGLE) {
+        const unsigned int* v = &mesh.indices[3*primID];
+        tris[0][0] = mesh.vertices[v[0]]; tris[0][1] = mesh.vertices[v[1]]; tris[0][2] = mesh.vertices[v[2]];
+        return 1;
+      }
+      const unsigned int* v = &mesh.indices[4*primID];
+      tris[0][0] = mesh.vertices[v[0]]; tris[0][1] = mesh.vertices[v[1]]; tris[0][2] = mesh.vertices[v[3]];
+      tris[1][0] = mesh.vertices[v[2]]; tris[1][1] = mesh.vertices[v[3]]; tris[1][2] = mesh.vertices[v[1]];
+      return 2;
+    }
+
+    /* both orders of a pair map to the same entry */
+    static CollisionSet unordered (const CollisionSet& set)
+    {
+      CollisionSet result;
+      for (auto& c : set) result.insert(min(c,std::make_tuple(std::get<2>(c),std::get<3>(c),std::get<0>(c),std::get<1>(c))));
+      return result;
+    }
+
+    CollisionSet bruteForce (const std::vector<Mesh>& meshes0, const std::vector<Mesh>& meshes1, bool self, bool skipShared = true)
+    {
+      const unsigned int numVerts = gtype == RTC_GEOMETRY_TYPE_TRIANGLE ? 3 : 4;
+      CollisionSet set;
+      for (unsigned int g0=0; g0<meshes0.size(); g0++) {
+        for (unsigned int g1=0; g1<meshes1.size(); g1++) {
+          const Mesh& mesh0 = meshes0[g0];
+          const Mesh& mesh1 = meshes1[g1];
+          for (unsigned int p0=0; p0<mesh0.indices.size()/numVerts; p0++) {
+            for (unsigned int p1=0; p1<mesh1.indices.size()/numVerts; p1++)
+            {
+              if (self && g0 == g1)
+              {
+                if (p0 == p1) continue;
+                bool shared = false;
+                for (unsigned int i=0; i<numVerts; i++)
+                  for (unsigned int j=0; j<numVerts; j++)
+                    shared |= mesh0.indices[numVerts*p0+i] == mesh1.indices[numVerts*p1+j];
+                if (shared && skipShared) continue;
+              }
+              Vec3fa tris0[2][3], tris1[2][3];
+              const size_t num0 = triangles(mesh0,p0,tris0);
+              const size_t num1 = triangles(mesh1,p1,tris1);
+              bool hit = false;
+              for (size_t i=0; i<num0; i++)
+                for (size_t j=0; j<num1; j++)
+                  hit |= isa::TriangleTriangleIntersector::intersect_triangle_triangle(tris0[i][0],tris0[i][1],tris0[i][2],tris1[j][0],tris1[j][1],tris1[j][2]);
+              if (hit) set.insert(std::make_tuple(g0,p0,g1,p1));
+            }
+          }
+        }
+      }
+      return set;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      std::vector<Mesh> meshes0, meshes1;
+      RTCSceneRef scene0 = createScene(device,meshes0,2);
+      RTCSceneRef scene1 = createScene(device,meshes1,1);
+      AssertNoError(device);
+
+      /* self collision skips a primitive and its topological neighbors */
+      CollisionSet self;
+      rtcCollide(scene0,scene0,collideFunc,&self);
+      AssertNoError(device);
+      if (self != bruteForce(meshes0,meshes0,true)) return VerifyApplication::FAILED;
+      if (self.empty()) return VerifyApplication::FAILED;
 
-        if ((int)data.primID != i/2) return VerifyApplication::FAILED;
-        if (abs(data.result.x- 0.25f) > 1e-4f)        return VerifyApplication::FAILED;
-        if (abs(data.result.y- 0.75f) > 1e-4f)        return VerifyApplication::FAILED;
-        if (abs(data.result.z- (float)(i/2)) > 1e-4f) return VerifyApplication::FAILED;
-        AssertNoError(device);
-      }
+      /* self collision mode reports each unordered pair once, optionally including topological neighbors */
+      CollisionSet selfSkipShared;
+      rtcCollideSelf(scene0,RTC_COLLIDE_FLAG_SKIP_SHARED_VERTICES,collideFunc,&selfSkipShared);
+      AssertNoError(device);
+      if (unordered(selfSkipShared) != unordered(self)) return VerifyApplication::FAILED;
+
+      CollisionSet selfAll;
+      rtcCollideSelf(scene0,RTC_COLLIDE_FLAG_NONE,collideFunc,&selfAll);
+      AssertNoError(device);
+      if (unordered(selfAll) != unordered(bruteForce(meshes0,meshes0,true,false))) return VerifyApplication::FAILED;
+      if (selfAll.size() <= selfSkipShared.size()) return VerifyApplication::FAILED;
+
+      CollisionSet other;
+      rtcCollide(scene0,scene1,collideFunc,&other);
+      AssertNoError(device);
+      if (other != bruteForce(meshes0,meshes1,false)) return VerifyApplication::FAILED;
+      if (other.empty()) return VerifyApplication::FAILED;
 
       return VerifyApplication::PASSED;
     }
   };
 
-  struct PointQueryMotionBlurTest : public VerifyApplication::Test
+  struct CollideSelfUserGeometryTest : public VerifyApplication::Test
   {
-    SceneFlags sflags; 
-    std::string tri_accel;
+    SceneFlags sflags;
 
-    PointQueryMotionBlurTest (std::string name, int isa, SceneFlags sflags, std::string tri_accel = "")
-      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), tri_accel(tri_accel) {}
+    CollideSelfUserGeometryTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    static void boundsFunc(const struct RTCBoundsFunctionArguments* args)
+    {
+      const BBox3fa* boxes = (const BBox3fa*) args->geometryUserPtr;
+      *(BBox3fa*) args->bounds_o = boxes[args->primID];
+    }
 
     VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
     {
-      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa) + (tri_accel != "" ? ",tri_accel="+tri_accel : "");
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
       RTCDeviceRef device = rtcNewDevice(cfg.c_str());
       errorHandler(nullptr,rtcGetDeviceError(device));
-     
-      Vec3f vertices_t0[4] = { 
-        Vec3f(-1.f, -1.f, -1.f), 
-        Vec3f( 1.f, -1.f, -1.f), 
-        Vec3f( 0.f,  1.f, -1.f), 
-        Vec3f(0.f) // 16 byte padding
-      };
-      Vec3f vertices_t1[4] = { 
-        Vec3f(-1.f, -1.f, 1.f), 
-        Vec3f( 1.f, -1.f, 1.f), 
-        Vec3f( 0.f,  1.f, 1.f), 
-        Vec3f(0.f) // 16 byte padding
-      };
 
-      // duplicate triangle to make sure the bvh is not only a leaf node
-      Triangle triangles[64];
-      for (int i = 0; i < 64; ++i)
-        triangles[i] = Triangle(0, 1, 2);
+      const unsigned int numBoxes = 512;
+      std::vector<BBox3fa> boxes(numBoxes);
+      for (auto& box : boxes) {
+        const Vec3fa p(2.0f*random_float(),2.0f*random_float(),2.0f*random_float());
+        box = BBox3fa(p,p+Vec3fa(0.1f*random_float(),0.1f*random_float(),0.1f*random_float()));
+      }
 
       RTCSceneRef scene = rtcNewScene(device);
       rtcSetSceneFlags(scene,sflags.sflags);
       rtcSetSceneBuildQuality(scene,sflags.qflags);
-      
-      RTCGeometry geom = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_TRIANGLE);
+      RTCGeometry geom = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_USER);
       rtcSetGeometryBuildQuality(geom,sflags.qflags);
-      rtcSetGeometryTimeStepCount(geom,2);
-      rtcSetGeometryPointQueryFunction(geom, [](RTCPointQueryFunctionArguments* args) -> bool
-      {
-        // set primID (userPtr) to something != RTC_INVALID_GEOMETRY_ID to signal that 
-        // the query overlapped some geometry
-        *((unsigned int*)args->userPtr) = 0;
-        return true;
-      });
-      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, vertices_t0, 0, sizeof(Vec3f),     3);
-      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 1, RTC_FORMAT_FLOAT3, vertices_t1, 0, sizeof(Vec3f),     3);
-      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX , 0, RTC_FORMAT_UINT3,  triangles,   0, sizeof(Triangle), 64);
+      rtcSetGeometryUserPrimitiveCount(geom,numBoxes);
+      rtcSetGeometryUserData(geom,boxes.data());
+      rtcSetGeometryBoundsFunction(geom,boundsFunc,nullptr);
       rtcCommitGeometry(geom);
       rtcAttachGeometry(scene,geom);
       rtcReleaseGeometry(geom);
-      rtcCommitScene (scene);
+      rtcCommitScene(scene);
       AssertNoError(device);
 
-      RTCPointQuery query0;
-      query0.x      =  0.0f;
-      query0.y      =  0.0f;
-      query0.z      = -1.0f;
-      query0.radius =  0.1f;
-      
-      RTCPointQuery query1;
-      query1.x      =  0.0f;
-      query1.y      =  0.0f;
-      query1.z      =  0.0f;
-      query1.radius =  0.1f;
-      
-      RTCPointQuery query2;
-      query2.x      =  0.0f;
-      query2.y      =  0.0f;
-      query2.z      =  1.0f;
-      query2.radius =  0.1f;
+      /* the self collision mode reports the same candidate pairs as colliding the scene with itself, but in one order only */
+      CollideTest::CollisionSet ordered, self;
+      rtcCollide(scene,scene,CollideTest::collideFunc,&ordered);
+      rtcCollideSelf(scene,RTC_COLLIDE_FLAG_NONE,CollideTest::collideFunc,&self);
+      AssertNoError(device);
+      if (self.empty() || self.size() >= ordered.size()) return VerifyApplication::FAILED;
+      if (CollideTest::unordered(self) != CollideTest::unordered(ordered)) return VerifyApplication::FAILED;
+      for (auto& c : self)
+        if (std::get<1>(c) == std::get<3>(c)) return VerifyApplication::FAILED;
 
-      // time t = 0, only query0 should overlap
-      query0.time = query1.time = query2.time = 0.f;
-      {
-        unsigned int primID = RTC_INVALID_GEOMETRY_ID;
-        RTCPointQueryContext context;
-        rtcInitPointQueryContext(&context);
-        rtcPointQuery(scene, &query0, &context, nullptr, &primID);
-        if (primID == RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
-      }
-      {
-        unsigned int primID = RTC_INVALID_GEOMETRY_ID;
-        RTCPointQueryContext context;
-        rtcInitPointQueryContext(&context);
-        rtcPointQuery(scene, &query1, &context, nullptr, &primID);
-        if (primID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
-      }
-      {
-        unsigned int primID = RTC_INVALID_GEOMETRY_ID;
-        RTCPointQueryContext context;
-        rtcInitPointQueryContext(&context);
-        rtcPointQuery(scene, &query2, &context, nullptr, &primID);
-        if (primID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
-      }
+      return VerifyApplication::PASSED;
+    }
+  };
 
-      // time t = 0.5, only query1 should overlap
-      query0.time = query1.time = query2.time = 0.5f;
-      {
-        unsigned int primID = RTC_INVALID_GEOMETRY_ID;
-        RTCPointQueryContext context;
-        rtcInitPointQueryContext(&context);
-        rtcPointQuery(scene, &query0, &context, nullptr, &primID);
-        if (primID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
-      }
-      {
-        unsigned int primID = RTC_INVALID_GEOMETRY_ID;
-        RTCPointQueryContext context;
-        rtcInitPointQueryContext(&context);
-        rtcPointQuery(scene, &query1, &context, nullptr, &primID);
-        if (primID == RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
-      }
+  struct CollideContinuousTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    unsigned int numTimeSteps;
+
+    CollideContinuousTest (std::string name, int isa, SceneFlags sflags, unsigned int numTimeSteps)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), numTimeSteps(numTimeSteps) {}
+
+    typedef std::map<std::pair<unsigned int,unsigned int>,BBox1f> CollisionMap;
+
+    struct CollisionData
+    {
+      BBox1f time_range;
+      CollisionMap collisions;
+      bool invalid = false;
+      MutexSys mutex;
+    };
+
+    static void collideFunc (void* userPtr, RTCContinuousCollision* collisions, unsigned int num_collisions)
+    {
+      CollisionData* data = (CollisionData*) userPtr;
+      Lock<MutexSys> lock(data->mutex);
+      for (size_t i=0; i<num_collisions; i++)
       {
-        unsigned int primID = RTC_INVALID_GEOMETRY_ID;
-        RTCPointQueryContext context;
-        rtcInitPointQueryContext(&context);
-        rtcPointQuery(scene, &query2, &context, nullptr, &primID);
-        if (primID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+        const RTCContinuousCollision& c = collisions[i];
+        const std::pair<unsigned int,unsigned int> key(c.primID0,c.primID1);
+        const BBox1f t(c.time0,c.time1);
+        if (c.primID0 == c.primID1 || t.lower < data->time_range.lower || t.upper > data->time_range.upper || t.lower > t.upper)
+          data->invalid = true;
+
+        /* a pair can get reported multiple times for different parts of the time range, keep the earliest */
+        auto prev = data->collisions.find(key);
+        if (prev == data->collisions.end() || t.lower < prev->second.lower)
+          data->collisions[key] = t;
       }
-      
-      // time t = 1.0, only query2 should overlap
-      query0.time = query1.time = query2.time = 1.f;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      const unsigned int numTriangles = 128;
+      RTCSceneRef scene = rtcNewScene(device);
+      rtcSetSceneFlags(scene,sflags.sflags);
+      rtcSetSceneBuildQuality(scene,sflags.qflags);
+      RTCGeometry geom = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_TRIANGLE);
+      rtcSetGeometryBuildQuality(geom,sflags.qflags);
+      rtcSetGeometryTimeStepCount(geom,numTimeSteps);
+      std::vector<Vec3fa> vertices(numTimeSteps*3*numTriangles);
+      for (unsigned int i=0; i<numTriangles; i++)
       {
-        unsigned int primID = RTC_INVALID_GEOMETRY_ID;
-        RTCPointQueryContext context;
-        rtcInitPointQueryContext(&context);
-        rtcPointQuery(scene, &query0, &context, nullptr, &primID);
-        if (primID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+        const Vec3fa p(2.0f*random_float(),2.0f*random_float(),2.0f*random_float());
+        for (unsigned int j=0; j<3; j++) {
+          Vec3fa v = p+Vec3fa(0.2f*random_float(),0.2f*random_float(),0.2f*random_float());
+          for (unsigned int t=0; t<numTimeSteps; t++) {
+            vertices[t*3*numTriangles+3*i+j] = v;
+            v += Vec3fa(0.4f*random_float()-0.2f,0.4f*random_float()-0.2f,0.4f*random_float()-0.2f);
+          }
+        }
       }
-      {
-        unsigned int primID = RTC_INVALID_GEOMETRY_ID;
-        RTCPointQueryContext context;
-        rtcInitPointQueryContext(&context);
-        rtcPointQuery(scene, &query1, &context, nullptr, &primID);
-        if (primID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+      for (unsigned int t=0; t<numTimeSteps; t++) {
+        Vec3f* verts = (Vec3f*)rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, t, RTC_FORMAT_FLOAT3, sizeof(Vec3f), 3*numTriangles);
+        for (unsigned int i=0; i<3*numTriangles; i++) {
+          const Vec3fa& v = vertices[t*3*numTriangles+i];
+          verts[i] = Vec3f(v.x,v.y,v.z);
+        }
       }
+      unsigned int* indices = (unsigned int*)rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT3, 3*sizeof(unsigned int), numTriangles);
+      for (unsigned int i=0; i<3*numTriangles; i++) indices[i] = i;
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(scene,geom);
+      rtcReleaseGeometry(geom);
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      /* bounds of a triangle at some point in time */
+      auto bounds = [&] (unsigned int primID, float time) {
+        const float f = time*float(max(numTimeSteps,2u)-1);
+        const unsigned int itime = min((unsigned int)f,max(numTimeSteps,2u)-2);
+        BBox3fa b(empty);
+        for (unsigned int j=0; j<3; j++) {
+          if (numTimeSteps == 1) b.extend(vertices[3*primID+j]);
+          else b.extend(lerp(vertices[itime*3*numTriangles+3*primID+j],vertices[(itime+1)*3*numTriangles+3*primID+j],f-float(itime)));
+        }
+        return b;
+      };
+
+      const BBox1f time_range(0.2f,0.9f);
+      CollisionData data;
+      data.time_range = time_range;
+      rtcCollideContinuous(scene,scene,time_range.lower,time_range.upper,collideFunc,&data);
+      AssertNoError(device);
+      if (data.invalid) return VerifyApplication::FAILED;
+      if (data.collisions.empty() || data.collisions.size() == numTriangles*(numTriangles-1)) return VerifyApplication::FAILED;
+
+      /* every pair of triangles with overlapping bounds is reported no later than the overlap */
+      const float eps = 1E-4f;
+      for (unsigned int i=0; i<numTriangles; i++)
       {
-        unsigned int primID = RTC_INVALID_GEOMETRY_ID;
-        RTCPointQueryContext context;
-        rtcInitPointQueryContext(&context);
-        rtcPointQuery(scene, &query2, &context, nullptr, &primID);
-        if (primID == RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+        for (unsigned int j=0; j<numTriangles; j++)
+        {
+          if (i == j) continue;
+          for (unsigned int k=0; k<=16; k++)
+          {
+            const float time = lerp(time_range.lower,time_range.upper,float(k)/16.0f);
+            const BBox3fa b0 = bounds(i,time);
+            const BBox3fa b1 = bounds(j,time);
+            const Vec3fa lower = max(b0.lower,b1.lower)+Vec3fa(eps);
+            const Vec3fa upper = min(b0.upper,b1.upper);
+            if (lower.x > upper.x || lower.y > upper.y || lower.z > upper.z) continue;
+            auto c = data.collisions.find(std::make_pair(i,j));
+            if (c == data.collisions.end()) return VerifyApplication::FAILED;
+            if (c->second.lower > time+eps) return VerifyApplication::FAILED;
+            break;
+          }
+        }
       }
 
+      /* invalid time ranges are rejected */
+      rtcCollideContinuous(scene,scene,0.5f,0.4f,collideFunc,&data);
+      if (rtcGetDeviceError(device) != RTC_ERROR_INVALID_ARGUMENT) return VerifyApplication::FAILED;
+
       return VerifyApplication::PASSED;
     }
   };
@@ -5671,6 +7561,16 @@ namespace embree
         }
         break;
       }
+      case MODE_INTERSECT1M: 
+      {
+        for (size_t y=y0; y<y1; y++) {
+          RTCRayHit rays[tileSizeX];
+          for (size_t x=x0; x<x1; x++)
+            rays[x-x0] = fastMakeRay(zero,Vec3f(float(x)*rcpWidth,1,float(y)*rcpHeight));
+          rtcIntersect1M(*scene,rays,(unsigned int)(x1-x0),&args);
+        }
+        break;
+      }
       case MODE_INTERSECT4: 
       {
         for (size_t y=y0; y<y1; y+=2) {
@@ -5826,6 +7726,17 @@ namespace embree
         }
         break;
       }
+      case MODE_INTERSECT1M: 
+      {
+        for (size_t j=0; j<dn; j+=16) {
+          RTCRayHit rays[16];
+          const size_t M = min(size_t(16),dn-j);
+          for (size_t k=0; k<M; k++)
+            fastMakeRay(rays[k],zero,sampler);
+          rtcIntersect1M(*scene,rays,(unsigned int)M,&args);
+        }
+        break;
+      }
       case MODE_INTERSECT4: 
       {
         for (size_t j=0; j<dn; j+=4) {
@@ -6077,6 +7988,7 @@ namespace embree
 
     /* create list of all intersect modes to test */
     intersectModes.push_back(MODE_INTERSECT1);
+    intersectModes.push_back(MODE_INTERSECT1M);
     intersectModes.push_back(MODE_INTERSECT4);
     intersectModes.push_back(MODE_INTERSECT8);
     intersectModes.push_back(MODE_INTERSECT16);
@@ -6268,6 +8180,27 @@ namespace embree
       groups.pop();
 
       groups.pop();
+
+      push(new TestGroup("curve_presplit",true,false));
+      groups.top()->add(new CurvePresplitTest("round_bezier",isa));
+      groups.pop();
+
+      push(new TestGroup("curve_tessellation",true,false));
+      groups.top()->add(new CurveTessellationTest("round_bezier",isa));
+      groups.pop();
+
+      push(new TestGroup("subdiv_tessellation",true,false));
+      groups.top()->add(new SubdivViewDependentTessellationTest("view_dependent",isa));
+      groups.top()->add(new SubdivDisplacementTextureTest("displacement_texture",isa));
+      groups.top()->add(new SubdivTessellationCacheTest("tessellation_cache",isa));
+      groups.top()->add(new SubdivTessellationReuseTest("tessellation_reuse",isa));
+      groups.pop();
+
+      if (stringOfISA(isa) == "AVX512") {
+        push(new TestGroup("hair_accel",true,false));
+        groups.top()->add(new HairAccelTest("virtualcurve16i",isa,"bvh8obb.virtualcurve16i"));
+        groups.pop();
+      }
       
       /**************************************************************************/
       /*                      Intersection Tests                                */
@@ -6297,6 +8230,11 @@ namespace embree
             for (auto ivariant : intersectVariants)
               if (has_variant(imode,ivariant))
                   groups.top()->add(new RayMasksTest(to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,imode,ivariant));
+        for (auto sflags : sceneFlags) 
+          for (auto imode : intersectModes) 
+            for (auto ivariant : intersectVariants)
+              if (has_variant(imode,ivariant))
+                  groups.top()->add(new InstanceRayMasksTest("instancing."+to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,imode,ivariant));
         groups.pop();
       }
       
@@ -6311,6 +8249,17 @@ namespace embree
                     groups.top()->add(new BackfaceCullingTest(to_string(gtype,sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,gtype,imode,ivariant));
         groups.pop();
       }
+      else
+      {
+        push(new TestGroup("geometry_backface_culling",true,true));
+        for (auto gtype : { TRIANGLE_MESH, TRIANGLE_MESH_MB, QUAD_MESH, QUAD_MESH_MB })
+          for (auto sflags : sceneFlags) 
+            for (auto imode : intersectModes) 
+              for (auto ivariant : intersectVariants)
+                if (has_variant(imode,ivariant))
+                    groups.top()->add(new GeometryBackfaceCullingTest(to_string(gtype,sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,gtype,imode,ivariant));
+        groups.pop();
+      }
 
       if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_FILTER_FUNCTION_SUPPORTED))
       {
@@ -6329,10 +8278,32 @@ namespace embree
               for (auto ivariant : intersectVariants)
                 if (has_variant(imode,ivariant))
                   groups.top()->add(new IntersectionFilterTest("subdiv."+to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,true,imode,ivariant));
+
+          for (auto sflags : sceneFlags) 
+            for (auto imode : intersectModes) 
+              for (auto ivariant : intersectVariants)
+                if (has_variant(imode,ivariant))
+                  groups.top()->add(new OpacityMicromapTest("opacity_micromap."+to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,imode,ivariant));
+
+          /* single ray traversal of triangle4 and quad4v BVHs compiles out filter functions disabled by the feature mask */
+          for (auto sflags : { SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM), SceneFlags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_LOW) })
+            groups.top()->add(new FeatureMaskFilterTest("feature_mask."+to_string(sflags),isa,sflags));
         }
         groups.pop();
       }
 
+      push(new TestGroup("multi_hit",true,true));
+      for (auto sflags : sceneFlags)
+        for (auto quality : { RTC_BUILD_QUALITY_MEDIUM, RTC_BUILD_QUALITY_HIGH })
+          groups.top()->add(new MultiHitTest(to_string(sflags,quality),isa,sflags,quality));
+      groups.pop();
+
+      push(new TestGroup("occluder_cache",true,true));
+      for (auto sflags : sceneFlags)
+        for (auto quality : { RTC_BUILD_QUALITY_MEDIUM, RTC_BUILD_QUALITY_HIGH })
+          groups.top()->add(new OccluderCacheTest(to_string(sflags,quality),isa,sflags,quality));
+      groups.pop();
+
       push(new TestGroup("instancing",true,true));
         for (auto& sflags : sceneFlags) 
           for (auto imode : intersectModes) 
@@ -6358,6 +8329,12 @@ namespace embree
                 groups.top()->add(new InstanceArrayRandomTest<RTCQuaternionDecomposition>("instancing_random_SRT."+to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,imode,ivariant));
                 groups.top()->add(new InstanceArrayTestFormats("instancing_format."+to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,imode,ivariant));
               }
+        for (auto sflags : sceneFlags)
+          groups.top()->add(new InstanceArrayUpdateTest("instancing_update."+to_string(sflags),isa,sflags));
+        for (auto sflags : sceneFlags)
+          for (auto imode : intersectModes)
+            if (has_variant(imode,VARIANT_INTERSECT))
+              groups.top()->add(new InstanceArrayLODTest("instancing_lod."+to_string(sflags,imode,VARIANT_INTERSECT),isa,sflags,imode,VARIANT_INTERSECT));
       groups.pop();
 #endif
 
@@ -6366,7 +8343,7 @@ namespace embree
         for (auto imode : intersectModes) 
           for (auto ivariant : intersectVariants)
             if (has_variant(imode,ivariant))
-                if (imode != MODE_INTERSECT1) // INTERSECT1 does not support disabled rays
+                if (imode != MODE_INTERSECT1 && imode != MODE_INTERSECT1M) // INTERSECT1 does not support disabled rays
                   groups.top()->add(new InactiveRaysTest(to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,imode,ivariant));
       groups.pop();
       
@@ -6501,6 +8478,39 @@ namespace embree
       groups.top()->add(new PointQueryMotionBlurTest("point_query_motion_blur_aligned_node",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),"bvh4.triangle4i"));
       groups.top()->add(new PointQueryMotionBlurTest("point_query_motion_blur_quantized_node",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),"qbvh4.triangle4i"));
       groups.top()->add(new PointQueryMotionBlurTest("point_query_motion_blur_quantized_node",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM)));
+      for (auto sflags : sceneFlags) {
+        for (bool instanced : { false, true }) {
+          const std::string prefix = instanced ? "closest_point.instanced." : "closest_point.";
+          groups.top()->add(new ClosestPointTest(prefix+"triangles."+to_string(sflags),isa,sflags,RTC_GEOMETRY_TYPE_TRIANGLE,instanced));
+          groups.top()->add(new ClosestPointTest(prefix+"quads."+to_string(sflags),isa,sflags,RTC_GEOMETRY_TYPE_QUAD,instanced));
+          groups.top()->add(new ClosestPointTest(prefix+"grids."+to_string(sflags),isa,sflags,RTC_GEOMETRY_TYPE_GRID,instanced));
+        }
+      }
+      for (auto sflags : sceneFlags) {
+        groups.top()->add(new BoxQueryTest("box_query."+to_string(sflags),isa,sflags,false));
+        groups.top()->add(new BoxQueryTest("box_query.instanced."+to_string(sflags),isa,sflags,true));
+      }
+      for (auto sflags : sceneFlags) {
+        groups.top()->add(new FrustumQueryTest("frustum_query."+to_string(sflags),isa,sflags,false,RTC_FRUSTUM_QUERY_FLAG_NONE));
+        groups.top()->add(new FrustumQueryTest("frustum_query.instanced."+to_string(sflags),isa,sflags,true,RTC_FRUSTUM_QUERY_FLAG_NONE));
+        groups.top()->add(new FrustumQueryTest("frustum_query.instances."+to_string(sflags),isa,sflags,true,RTC_FRUSTUM_QUERY_FLAG_INSTANCES));
+      }
+      groups.pop();
+
+      /**************************************************************************/
+      /*                           Collision Tests                              */
+      /**************************************************************************/
+
+      push(new TestGroup("collide",true,true));
+      for (auto sflags : sceneFlags) {
+        groups.top()->add(new CollideTest("triangles."+to_string(sflags),isa,sflags,RTC_GEOMETRY_TYPE_TRIANGLE));
+        groups.top()->add(new CollideTest("quads."+to_string(sflags),isa,sflags,RTC_GEOMETRY_TYPE_QUAD));
+      }
+      for (auto sflags : sceneFlags)
+        groups.top()->add(new CollideSelfUserGeometryTest("self.user_geometry."+to_string(sflags),isa,sflags));
+      for (auto sflags : sceneFlags)
+        for (unsigned int numTimeSteps : { 1, 2, 3 })
+          groups.top()->add(new CollideContinuousTest("continuous.triangles.timesteps"+std::to_string((long long)numTimeSteps)+"."+to_string(sflags),isa,sflags,numTimeSteps));
       groups.pop();
     
       /**************************************************************************/
@@ -6551,6 +8561,7 @@ namespace embree
       std::vector<std::pair<IntersectMode,IntersectVariant>> benchmark_imodes_ivariants;
       benchmark_imodes_ivariants.push_back(std::make_pair(MODE_INTERSECT1,VARIANT_INTERSECT));
       benchmark_imodes_ivariants.push_back(std::make_pair(MODE_INTERSECT1,VARIANT_OCCLUDED));
+      benchmark_imodes_ivariants.push_back(std::make_pair(MODE_INTERSECT1M,VARIANT_INTERSECT));
       benchmark_imodes_ivariants.push_back(std::make_pair(MODE_INTERSECT4,VARIANT_INTERSECT));
       benchmark_imodes_ivariants.push_back(std::make_pair(MODE_INTERSECT4,VARIANT_OCCLUDED));
       benchmark_imodes_ivariants.push_back(std::make_pair(MODE_INTERSECT8,VARIANT_INTERSECT));